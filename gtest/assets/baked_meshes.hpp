@@ -0,0 +1,101 @@
+/**
+ * @file baked_meshes.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Baked mesh tests
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "graphics/primitives/baked_mesh.h"
+
+TEST(BakedMeshes, RoundTrip) {
+    std::string source = testing::TempDir() + "baked_mesh_" +
+                         std::to_string(getpid()) + ".obj";
+
+    FILE* file = fopen(source.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fputs("o model\n", file);
+    fclose(file);
+
+    BakedMesh::set_directory(testing::TempDir() + "baked_meshes_" +
+                             std::to_string(getpid()));
+
+    std::vector<Vertex> vertices = {
+        {{0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, {0.0, 0.0}, {1.0, 0.0, 0.0}},
+        {{1.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, {1.0, 0.0}, {1.0, 0.0, 0.0}},
+        {{0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}, {0.0, 1.0}, {1.0, 0.0, 0.0}},
+    };
+    std::vector<unsigned> indices = {0, 1, 2};
+
+    EXPECT_EQ(BakedMesh::load(source.c_str()), nullptr);
+    ASSERT_TRUE(BakedMesh::save(source.c_str(), vertices, indices));
+
+    std::shared_ptr<const BakedMesh> baked = BakedMesh::load(source.c_str());
+    ASSERT_NE(baked, nullptr);
+
+    ASSERT_EQ(baked->get_vertex_count(), vertices.size());
+    ASSERT_EQ(baked->get_index_count(), indices.size());
+
+    EXPECT_EQ(baked->get_vertices()[1].position, vertices[1].position);
+    EXPECT_EQ(baked->get_vertices()[2].uv, vertices[2].uv);
+    EXPECT_EQ(std::vector<unsigned>(baked->get_indices(),
+                                    baked->get_indices() + indices.size()),
+              indices);
+
+    // Changes of the model file outdate the baked geometry
+    file = fopen(source.c_str(), "a");
+    ASSERT_NE(file, nullptr);
+    fputs("v 0 0 0\n", file);
+    fclose(file);
+
+    EXPECT_EQ(BakedMesh::load(source.c_str()), nullptr);
+
+    // Baked files are keyed by the modification time rather than the contents
+    ASSERT_TRUE(BakedMesh::save(source.c_str(), vertices, indices));
+    ASSERT_NE(BakedMesh::load(source.c_str()), nullptr);
+
+    struct timespec times[2] = {{0, UTIME_OMIT}, {1, 0}};
+    ASSERT_EQ(utimensat(AT_FDCWD, source.c_str(), times, 0), 0);
+
+    EXPECT_EQ(BakedMesh::load(source.c_str()), nullptr);
+
+    BakedMesh::set_directory("");
+    remove(source.c_str());
+}
+
+TEST(BakedMeshes, CorruptIndices) {
+    std::string source = testing::TempDir() + "corrupt_mesh_" +
+                         std::to_string(getpid()) + ".obj";
+
+    FILE* file = fopen(source.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    fputs("o model\n", file);
+    fclose(file);
+
+    BakedMesh::set_directory(testing::TempDir() + "baked_meshes_" +
+                             std::to_string(getpid()));
+
+    std::vector<Vertex> vertices = {
+        {{0.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, {0.0, 0.0}, {1.0, 0.0, 0.0}},
+        {{1.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, {1.0, 0.0}, {1.0, 0.0, 0.0}},
+        {{0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}, {0.0, 1.0}, {1.0, 0.0, 0.0}},
+    };
+
+    // Indices past the vertex buffer would be read by the graphics driver
+    ASSERT_TRUE(BakedMesh::save(source.c_str(), vertices, {0, 1, 5}));
+    EXPECT_EQ(BakedMesh::load(source.c_str()), nullptr);
+
+    ASSERT_TRUE(BakedMesh::save(source.c_str(), vertices, {0, 1, 2}));
+    EXPECT_NE(BakedMesh::load(source.c_str()), nullptr);
+
+    BakedMesh::set_directory("");
+    remove(source.c_str());
+}
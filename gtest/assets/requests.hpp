@@ -0,0 +1,501 @@
+/**
+ * @file requests.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Asynchronous asset request tests
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include "logger/metrics.h"
+#include "logics/blueprints/generic_meta.h"
+#include "managers/asset_manager.h"
+#include "pipelining/main_thread.h"
+#include "pipelining/thread_pool.hpp"
+
+struct AsyncProbe {
+    size_t value = 0;
+    std::thread::id decoder{};
+};
+
+struct AsyncProbeImporter final : public AssetImporter<AsyncProbe, "probe"> {
+    AbstractAsset* local_import(
+        const std::string& path,
+        AssetManager::RequestFlags flags) const override {
+        AssetManager::Upload upload = decode(path, flags);
+        return upload ? upload() : nullptr;
+    }
+
+    AssetManager::Upload decode(
+        const std::string& path,
+        AssetManager::RequestFlags flags) const override {
+        ++decode_count;
+
+        if (path.find("missing") != std::string::npos) return {};
+
+        AsyncProbe probe = {path.size(), std::this_thread::get_id()};
+        return [probe]() { return new Asset<AsyncProbe>(probe); };
+    }
+
+    mutable std::atomic<unsigned> decode_count = 0;
+};
+
+// Registered on first use, as the registry of the manager is not initialized
+// before the static objects of the tests
+static AsyncProbeImporter& get_probe_importer() {
+    static AsyncProbeImporter importer;
+    return importer;
+}
+
+TEST(AssetRequests, Async) {
+    AsyncProbeImporter& importer = get_probe_importer();
+
+    AssetHandle<AsyncProbe> first =
+        AssetManager::request_async<AsyncProbe>("assets/first.probe");
+    AssetHandle<AsyncProbe> second =
+        AssetManager::request_async<AsyncProbe>("assets/first.probe");
+
+    EXPECT_EQ(AssetManager::get_pending_count(), 1);
+
+    const AsyncProbe* probe = second.get();
+    ASSERT_NE(probe, nullptr);
+
+    EXPECT_TRUE(first.is_ready());
+    EXPECT_EQ(first.get(), probe);
+    EXPECT_EQ(probe->value, strlen("assets/first.probe"));
+    EXPECT_NE(probe->decoder, std::this_thread::get_id());
+
+    EXPECT_EQ(importer.decode_count, 1u);
+    EXPECT_EQ(AssetManager::get_pending_count(), 0);
+
+    // Finished requests are cached for both kinds of requests
+    EXPECT_EQ(AssetManager::request<AsyncProbe>("assets/first.probe"), probe);
+    EXPECT_TRUE(AssetManager::request_async<AsyncProbe>("assets/first.probe")
+                    .is_ready());
+    EXPECT_EQ(importer.decode_count, 1u);
+
+    AssetHandle<AsyncProbe> missing = AssetManager::request_async<AsyncProbe>(
+        "assets/missing.probe", {}, AssetManager::RequestFlag::Silent);
+
+    EXPECT_EQ(missing.get(), nullptr);
+    EXPECT_EQ(importer.decode_count, 2u);
+}
+
+TEST(AssetRequests, WorkerThreads) {
+    AsyncProbeImporter& importer = get_probe_importer();
+    unsigned decode_count = importer.decode_count;
+
+    ThreadPool pool(4);
+
+    std::vector<std::future<const AsyncProbe*>> results;
+
+    // Requests are imported on the calling threads, once per asset
+    for (unsigned id = 0; id < 16; ++id) {
+        results.push_back(pool.submit([id]() {
+            std::string path = "assets/worker_" + std::to_string(id % 4);
+            return AssetManager::request<AsyncProbe>(path + ".probe");
+        }));
+    }
+
+    for (std::future<const AsyncProbe*>& result : results) {
+        ASSERT_TRUE(MainThread::wait(result));
+
+        const AsyncProbe* probe = result.get();
+        ASSERT_NE(probe, nullptr);
+        EXPECT_NE(probe->decoder, std::this_thread::get_id());
+    }
+
+    EXPECT_EQ(importer.decode_count, decode_count + 4);
+}
+
+struct SlowProbe {
+    std::chrono::steady_clock::time_point start{};
+    std::chrono::steady_clock::time_point end{};
+};
+
+struct SlowProbeImporter final
+    : public AssetImporter<SlowProbe, "slow_probe"> {
+    AbstractAsset* local_import(const std::string&,
+                                AssetManager::RequestFlags) const override {
+        ++import_count;
+
+        SlowProbe probe{};
+
+        probe.start = std::chrono::steady_clock::now();
+        usleep(50000);
+        probe.end = std::chrono::steady_clock::now();
+
+        return new Asset<SlowProbe>(probe);
+    }
+
+    mutable std::atomic<unsigned> import_count = 0;
+};
+
+TEST(AssetRequests, ConcurrentImports) {
+    static SlowProbeImporter importer;
+
+    ThreadPool pool(4);
+
+    std::vector<std::future<const SlowProbe*>> results;
+
+    for (unsigned id = 0; id < 4; ++id) {
+        results.push_back(pool.submit([id]() {
+            std::string path = "assets/slow_" + std::to_string(id % 2);
+            return AssetManager::request<SlowProbe>(path + ".slow_probe");
+        }));
+    }
+
+    std::vector<const SlowProbe*> probes{};
+
+    for (std::future<const SlowProbe*>& result : results) {
+        ASSERT_TRUE(MainThread::wait(result));
+
+        probes.push_back(result.get());
+        ASSERT_NE(probes.back(), nullptr);
+    }
+
+    // Requests of an asset that is being imported wait for it
+    EXPECT_EQ(probes[0], probes[2]);
+    EXPECT_EQ(probes[1], probes[3]);
+    EXPECT_EQ(importer.import_count, 2u);
+
+    // Imports of different assets are not serialized
+    EXPECT_LT(probes[0]->start, probes[1]->end);
+    EXPECT_LT(probes[1]->start, probes[0]->end);
+}
+
+TEST(AssetRequests, Manifest) {
+    AsyncProbeImporter& importer = get_probe_importer();
+
+    char path[] = "/tmp/asset_manifest_XXXXXX";
+    int descriptor = mkstemp(path);
+    ASSERT_GE(descriptor, 0);
+    close(descriptor);
+
+    AssetManager::start_recording();
+
+    AssetManager::request<AsyncProbe>("assets/recorded.probe");
+    AssetManager::request<AsyncProbe>("assets/recorded.probe");
+    AssetManager::request_async<AsyncProbe>("assets/prefetched", "probe")
+        .get();
+
+    ASSERT_TRUE(AssetManager::save_manifest(path));
+
+    std::ifstream stream(path);
+    std::string manifest(std::istreambuf_iterator<char>{stream}, {});
+
+    EXPECT_NE(manifest.find("\t\tassets/recorded.probe\n"), std::string::npos);
+    EXPECT_NE(manifest.find("\tprobe\tassets/prefetched\n"),
+              std::string::npos);
+
+    // Prefetched assets are decoded once and shared with the requests
+    AssetManager::unload_all();
+
+    unsigned decode_count = importer.decode_count;
+
+    EXPECT_GE(AssetManager::prefetch(path), 2u);
+    EXPECT_GE(AssetManager::get_pending_count(), 2u);
+
+    const AsyncProbe* probe =
+        AssetManager::request<AsyncProbe>("assets/prefetched", "probe");
+
+    ASSERT_NE(probe, nullptr);
+    EXPECT_NE(probe->decoder, std::this_thread::get_id());
+    EXPECT_NE(AssetManager::request<AsyncProbe>("assets/recorded.probe"),
+              nullptr);
+    EXPECT_EQ(importer.decode_count, decode_count + 2);
+
+    unlink(path);
+}
+
+TEST(AssetRequests, Eviction) {
+    AsyncProbeImporter& importer = get_probe_importer();
+
+    // Only the assets of this test should be evictable
+    AssetManager::evict();
+
+    unsigned decode_count = importer.decode_count;
+    size_t probe_size = sizeof(Asset<AsyncProbe>);
+    size_t usage = 0;
+
+    {
+        AssetRef<AsyncProbe> older =
+            AssetManager::acquire<AsyncProbe>("assets/older.probe");
+        AssetRef<AsyncProbe> newer =
+            AssetManager::acquire<AsyncProbe>("assets/newer.probe");
+
+        ASSERT_TRUE(older && newer);
+        EXPECT_EQ(importer.decode_count, decode_count + 2);
+
+        usage = AssetManager::get_memory_usage<AsyncProbe>().get_total();
+
+        // Referenced assets are kept over the budget
+        AssetManager::set_memory_budget(1);
+        EXPECT_EQ(AssetManager::get_memory_usage<AsyncProbe>().get_total(),
+                  usage);
+        EXPECT_EQ(newer->value, strlen("assets/newer.probe"));
+
+        AssetManager::set_memory_budget(0);
+    }
+
+    EXPECT_TRUE(AssetManager::acquire<AsyncProbe>("assets/older.probe"));
+
+    AssetManager::set_memory_budget(
+        AssetManager::get_memory_usage().get_total() - 1);
+
+    EXPECT_EQ(AssetManager::get_memory_usage<AsyncProbe>().get_total(),
+              usage - probe_size);
+
+    // The evicted asset is imported again
+    EXPECT_TRUE(AssetManager::acquire<AsyncProbe>("assets/older.probe"));
+    EXPECT_EQ(importer.decode_count, decode_count + 2);
+
+    EXPECT_TRUE(AssetManager::acquire<AsyncProbe>("assets/newer.probe"));
+    EXPECT_EQ(importer.decode_count, decode_count + 3);
+
+    AssetManager::set_memory_budget(0);
+}
+
+TEST(AssetRequests, PrefetchUnderBudget) {
+    AsyncProbeImporter& importer = get_probe_importer();
+
+    char path[] = "/tmp/asset_manifest_XXXXXX";
+    int descriptor = mkstemp(path);
+    ASSERT_GE(descriptor, 0);
+    close(descriptor);
+
+    {
+        std::ofstream manifest(path);
+        manifest << std::hex << std::uppercase
+                 << typeid(AsyncProbe).hash_code()
+                 << "\t\tassets/budgeted.probe\n";
+    }
+
+    unsigned decode_count = importer.decode_count;
+
+    // Uploads evict the prefetched asset right away
+    AssetManager::set_memory_budget(1);
+    ASSERT_EQ(AssetManager::prefetch(path), 1u);
+
+    // Waiting for the upload does not evict the asset before it is pinned
+    const AsyncProbe* probe =
+        AssetManager::request<AsyncProbe>("assets/budgeted.probe");
+
+    ASSERT_NE(probe, nullptr);
+    EXPECT_EQ(probe->value, strlen("assets/budgeted.probe"));
+    EXPECT_EQ(AssetManager::request<AsyncProbe>("assets/budgeted.probe"),
+              probe);
+    EXPECT_EQ(importer.decode_count, decode_count + 1);
+
+    AssetManager::set_memory_budget(0);
+
+    unlink(path);
+}
+
+TEST(AssetRequests, PrefetchOnWorkers) {
+    AsyncProbeImporter& importer = get_probe_importer();
+
+    char path[] = "/tmp/asset_manifest_XXXXXX";
+    int descriptor = mkstemp(path);
+    ASSERT_GE(descriptor, 0);
+    close(descriptor);
+
+    {
+        std::ofstream manifest(path);
+        manifest << std::hex << std::uppercase
+                 << typeid(AsyncProbe).hash_code()
+                 << "\t\tassets/worker_prefetched.probe\n";
+    }
+
+    unsigned decode_count = importer.decode_count;
+
+    ASSERT_EQ(AssetManager::prefetch(path), 1u);
+
+    ThreadPool pool(2);
+
+    std::vector<std::future<const AsyncProbe*>> results;
+
+    for (unsigned id = 0; id < 2; ++id) {
+        results.push_back(pool.submit([]() {
+            return AssetManager::request<AsyncProbe>(
+                "assets/worker_prefetched.probe");
+        }));
+    }
+
+    // The main thread only performs queued calls here, the workers hand the
+    // prefetched upload over to it
+    for (std::future<const AsyncProbe*>& result : results) {
+        ASSERT_TRUE(MainThread::wait(result));
+        EXPECT_EQ(result.get(), AssetManager::request<AsyncProbe>(
+                                    "assets/worker_prefetched.probe"));
+    }
+
+    EXPECT_EQ(importer.decode_count, decode_count + 1);
+
+    unlink(path);
+}
+
+TEST(AssetRequests, MixedPrefetch) {
+    static const unsigned XML_COUNT = 4;
+    static const unsigned PADDING_COUNT = 1 << 14;
+
+    AsyncProbeImporter& importer = get_probe_importer();
+
+    std::string prefix =
+        testing::TempDir() + "prefetch_" + std::to_string(getpid()) + "_";
+
+    // Only a small element of each file is imported, the rest of it is parsed
+    std::vector<std::string> xml_paths{};
+
+    for (unsigned id = 0; id < XML_COUNT; ++id) {
+        xml_paths.push_back(prefix + std::to_string(id) + ".generic_meta");
+
+        std::ofstream file(xml_paths.back());
+        file << "<generic_meta value=\"" << id << "\"/>\n<padding>\n";
+
+        for (unsigned item = 0; item < PADDING_COUNT; ++item) {
+            file << "<item name=\"padding\" value=\"0123456789\"/>\n";
+        }
+
+        file << "</padding>\n";
+    }
+
+    auto parse_start = std::chrono::steady_clock::now();
+
+    for (const std::string& xml_path : xml_paths) {
+        tinyxml2::XMLDocument document;
+        ASSERT_EQ(document.LoadFile(xml_path.c_str()), tinyxml2::XML_SUCCESS);
+    }
+
+    double parse_time = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - parse_start)
+                            .count();
+
+    std::string manifest_path = prefix + "manifest";
+
+    {
+        std::ofstream manifest(manifest_path);
+        manifest << std::hex << std::uppercase;
+
+        for (const std::string& xml_path : xml_paths) {
+            manifest << typeid(ExternalLevel::Metadata).hash_code() << "\t\t"
+                     << xml_path << "\n";
+        }
+
+        manifest << typeid(AsyncProbe).hash_code()
+                 << "\t\tassets/mixed_0.probe\n"
+                 << typeid(AsyncProbe).hash_code()
+                 << "\t\tassets/mixed_1.probe\n";
+    }
+
+    Histogram& upload_time = Metrics::get_histogram("asset_upload_seconds");
+
+    double upload_start = upload_time.get_sum();
+    unsigned decode_count = importer.decode_count;
+
+    ASSERT_EQ(AssetManager::prefetch(manifest_path), XML_COUNT + 2);
+
+    for (unsigned id = 0; id < XML_COUNT; ++id) {
+        AssetRef<ExternalLevel::Metadata> meta =
+            AssetManager::acquire<ExternalLevel::Metadata>(xml_paths[id]);
+
+        ASSERT_TRUE(meta);
+
+        const GenericMeta* generic = dynamic_cast<const GenericMeta*>(&*meta);
+        ASSERT_NE(generic, nullptr);
+        EXPECT_EQ(generic->xml()->IntAttribute("value"), (int)id);
+    }
+
+    EXPECT_NE(AssetManager::request<AsyncProbe>("assets/mixed_0.probe"),
+              nullptr);
+    EXPECT_NE(AssetManager::request<AsyncProbe>("assets/mixed_1.probe"),
+              nullptr);
+    EXPECT_EQ(importer.decode_count, decode_count + 2);
+
+    // The files are parsed on the worker threads, the main thread stages only
+    // import the parsed elements
+    EXPECT_LT(upload_time.get_sum() - upload_start, parse_time / 2.0);
+
+    for (const std::string& xml_path : xml_paths) {
+        remove(xml_path.c_str());
+    }
+
+    remove(manifest_path.c_str());
+}
+
+struct XMLProbeImporter final
+    : public XMLAssetImporter<AsyncProbe, "xml_probe"> {
+    AbstractAsset* local_import(
+        const tinyxml2::XMLElement& data,
+        AssetManager::RequestFlags) const override {
+        return new Asset<AsyncProbe>(
+            AsyncProbe{(size_t)data.IntAttribute("value"), {}});
+    }
+};
+
+TEST(AssetRequests, RogueReferences) {
+    static XMLProbeImporter importer;
+
+    tinyxml2::XMLDocument document;
+    ASSERT_EQ(document.Parse("<xml_probe value=\"7\"/>"),
+              tinyxml2::XML_SUCCESS);
+
+    const tinyxml2::XMLElement& element = *document.FirstChildElement();
+
+    size_t usage = AssetManager::get_memory_usage<AsyncProbe>().get_total();
+    size_t probe_size = sizeof(Asset<AsyncProbe>);
+
+    {
+        AssetRef<AsyncProbe> first =
+            AssetManager::acquire<AsyncProbe>(element);
+        AssetRef<AsyncProbe> second =
+            AssetManager::acquire<AsyncProbe>(element);
+
+        ASSERT_TRUE(first && second);
+        EXPECT_EQ(first->value, 7u);
+
+        // Rogue imports are not shared
+        EXPECT_NE(first.get(), second.get());
+        EXPECT_EQ(AssetManager::get_memory_usage<AsyncProbe>().get_total(),
+                  usage + 2 * probe_size);
+
+        AssetRef<AsyncProbe> copy = first;
+        first = AssetRef<AsyncProbe>();
+
+        EXPECT_EQ(AssetManager::get_memory_usage<AsyncProbe>().get_total(),
+                  usage + 2 * probe_size);
+    }
+
+    // Rogue assets are freed with their last reference
+    EXPECT_EQ(AssetManager::get_memory_usage<AsyncProbe>().get_total(),
+              usage);
+
+    {
+        AssetRef<AsyncProbe> rogue = AssetManager::acquire<AsyncProbe>(
+            "assets/rogue.probe", {}, AssetManager::RequestFlag::Rogue);
+
+        ASSERT_TRUE(rogue);
+        EXPECT_EQ(rogue->value, strlen("assets/rogue.probe"));
+    }
+
+    EXPECT_EQ(AssetManager::get_memory_usage<AsyncProbe>().get_total(),
+              usage);
+
+    // Handled imports are cached
+    AssetRef<AsyncProbe> handled =
+        AssetManager::acquire<AsyncProbe>(element, "xml_probe_handle");
+
+    EXPECT_EQ(AssetManager::acquire<AsyncProbe>(element, "xml_probe_handle")
+                  .get(),
+              handled.get());
+}
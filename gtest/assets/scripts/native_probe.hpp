@@ -0,0 +1,245 @@
+// Generated by generate_native_scripts from NATIVE_PROBE_SCRIPT of
+// gtest/scripts/programs.hpp, regenerate it when the script or the generator
+// change (checked by the ScriptPrograms.NativeSnapshot test).
+
+// Native level scripts, generated by the script compiler.
+// Do not edit.
+
+#include <math.h>
+
+#include <limits>
+
+#include "logics/blueprints/scripts/native.h"
+
+namespace {
+
+// Script from gtest/scripts/programs.hpp
+struct NativeScript_e9b214069ebb845d final : public NativeScript {
+    void start(Scene& scene,
+               const SubcomponentNameMap& name_map) override {
+        scene_ = &scene;
+
+        v0_ = find_component(name_map, "Probe");
+
+        propagate_0();
+        propagate_1();
+        propagate_3();
+        propagate_4();
+        propagate_6();
+        propagate_10();
+        propagate_11();
+    }
+
+   private:
+
+    void propagate_0() {
+        if (update_2(0b001)) propagate_2();
+        if (update_8(0b001)) propagate_8();
+        if (update_13(0b001)) propagate_13();
+        if (update_15(0b001)) propagate_15();
+    }
+
+    void propagate_1() {
+        if (update_2(0b010)) propagate_2();
+    }
+
+    bool update_2(uint8_t changed) {
+        connect_output(output_2_, v0_, CHANNEL_2);
+        return false;
+    }
+
+    void propagate_2() {
+        if (update_5(0b001)) propagate_5();
+        if (update_9(0b001)) propagate_9();
+        if (update_14(0b001)) propagate_14();
+    }
+
+    void propagate_3() {
+        if (update_8(0b010)) propagate_8();
+        if (update_13(0b010)) propagate_13();
+        if (update_15(0b010)) propagate_15();
+    }
+
+    void propagate_4() {
+        if (update_5(0b010)) propagate_5();
+    }
+
+    bool update_5(uint8_t changed) {
+        if (v2_.is_none()) {
+            v5_ = ScriptValue();
+            return true;
+        }
+
+        v5_ = v2_.as_number() * (0x1.8p+1);
+        return true;
+    }
+
+    void propagate_5() {
+        if (update_7(0b001)) propagate_7();
+    }
+
+    void propagate_6() {
+        if (update_7(0b010)) propagate_7();
+        if (update_9(0b010)) propagate_9();
+    }
+
+    bool update_7(uint8_t changed) {
+        if (v5_.is_none()) {
+            v7_ = ScriptValue();
+            return true;
+        }
+
+        v7_ = v5_.as_number() - (0x1p+1);
+        return true;
+    }
+
+    void propagate_7() {
+        if (update_8(0b100)) propagate_8();
+    }
+
+    bool update_8(uint8_t changed) {
+        // Reconnect if the component or the channel have changed
+        if (changed & 0b011) {
+            connect_input(input_8_, v0_, CHANNEL_8);
+        }
+
+        if (!(changed & 0b100)) return false;
+
+        if (!input_8_.connected) {
+            connect_input(input_8_, v0_, CHANNEL_8);
+        }
+
+        ScriptValue payload = v7_;
+        if (payload.has_value()) input_8_.output.trigger(payload);
+
+        return true;
+    }
+
+    void propagate_8() {
+    }
+
+    bool update_9(uint8_t changed) {
+        if (v2_.is_none()) {
+            v9_ = ScriptValue();
+            return true;
+        }
+
+        v9_ = v2_.as_number() < (0x1p+1);
+        return true;
+    }
+
+    void propagate_9() {
+        if (update_12(0b001)) propagate_12();
+    }
+
+    void propagate_10() {
+        if (update_12(0b010)) propagate_12();
+    }
+
+    void propagate_11() {
+        if (update_12(0b100)) propagate_12();
+    }
+
+    bool update_12(uint8_t changed) {
+        if (v9_.is_none()) {
+            v12_ = ScriptValue();
+        } else {
+            v12_ = v9_.as_bool() ? v10_ : v11_;
+        }
+
+        return true;
+    }
+
+    void propagate_12() {
+        if (update_13(0b100)) propagate_13();
+    }
+
+    bool update_13(uint8_t changed) {
+        // Reconnect if the component or the channel have changed
+        if (changed & 0b011) {
+            connect_input(input_13_, v0_, CHANNEL_13);
+        }
+
+        if (!(changed & 0b100)) return false;
+
+        if (!input_13_.connected) {
+            connect_input(input_13_, v0_, CHANNEL_13);
+        }
+
+        ScriptValue payload = v12_;
+        if (payload.has_value()) input_13_.output.trigger(payload);
+
+        return true;
+    }
+
+    void propagate_13() {
+    }
+
+    bool update_14(uint8_t changed) {
+        if (previous_14_ == v2_) return false;
+
+        previous_14_ = v2_;
+        v14_ = v2_;
+
+        return true;
+    }
+
+    void propagate_14() {
+        if (update_15(0b100)) propagate_15();
+    }
+
+    bool update_15(uint8_t changed) {
+        // Reconnect if the component or the channel have changed
+        if (changed & 0b011) {
+            connect_input(input_15_, v0_, CHANNEL_15);
+        }
+
+        if (!(changed & 0b100)) return false;
+
+        if (!input_15_.connected) {
+            connect_input(input_15_, v0_, CHANNEL_15);
+        }
+
+        ScriptValue payload = v14_;
+        if (payload.has_value()) input_15_.output.trigger(payload);
+
+        return true;
+    }
+
+    void propagate_15() {
+    }
+
+    ScriptValue v0_{};
+    ScriptValue v1_{std::string("out", 3)};
+    ScriptValue v2_{};
+    Output output_2_{SceneComponent::Channel::Listener(
+        [this](const ScriptValue& value) {
+            v2_ = value;
+            propagate_2();
+        })};
+    static inline const Symbol CHANNEL_2{StaticName("out")};
+    ScriptValue v3_{std::string("in", 2)};
+    ScriptValue v4_{(0x1.8p+1)};
+    ScriptValue v5_{};
+    ScriptValue v6_{(0x1p+1)};
+    ScriptValue v7_{};
+    ScriptValue v8_{};
+    Input input_8_{};
+    static inline const Symbol CHANNEL_8{StaticName("in")};
+    ScriptValue v9_{};
+    ScriptValue v10_{std::string("low", 3)};
+    ScriptValue v11_{std::string("high", 4)};
+    ScriptValue v12_{};
+    ScriptValue v13_{};
+    Input input_13_{};
+    static inline const Symbol CHANNEL_13{StaticName("in")};
+    ScriptValue v14_{};
+    std::optional<ScriptValue> previous_14_{};
+    ScriptValue v15_{};
+    Input input_15_{};
+    static inline const Symbol CHANNEL_15{StaticName("in")};
+};
+
+NATIVE_SCRIPT(NativeScript_e9b214069ebb845d, (hash_t)0xe9b214069ebb845dull, 95);
+
+}  // namespace
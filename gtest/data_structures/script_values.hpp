@@ -0,0 +1,93 @@
+/**
+ * @file script_values.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Script value tests
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <vector>
+
+#include "hash/symbol.h"
+#include "logics/blueprints/scripts/value.h"
+
+TEST(ScriptValues, Interning) {
+    std::string text = "interned";
+
+    InternedString alpha(text);
+    InternedString beta("interned");
+
+    EXPECT_EQ(alpha, beta);
+    EXPECT_EQ(alpha.c_str(), beta.c_str());
+    EXPECT_NE(alpha, InternedString("other"));
+    EXPECT_TRUE(InternedString().empty());
+}
+
+TEST(ScriptValues, InternedLifetime) {
+    size_t table_size = InternedString::get_table_size();
+
+    {
+        ScriptValue value(std::string("short-lived string"));
+        EXPECT_EQ(InternedString::get_table_size(), table_size + 1);
+
+        std::vector<ScriptValue> copies(4, value);
+
+        InternedString same("short-lived string");
+        EXPECT_EQ(same, value.get_string());
+
+        value = 1.0;
+        copies.clear();
+
+        EXPECT_EQ(InternedString::get_table_size(), table_size + 1);
+        EXPECT_EQ(same.str(), "short-lived string");
+    }
+
+    // Strings are dropped with their last reference
+    EXPECT_EQ(InternedString::get_table_size(), table_size);
+}
+
+TEST(ScriptValues, Symbols) {
+    static constexpr StaticName NAME = "channel";
+    static_assert(NAME.hash == ct_hash("channel"));
+
+    std::string text = "channel";
+
+    EXPECT_EQ(Symbol(text), Symbol(NAME));
+    EXPECT_EQ(Symbol(text).get_name(), "channel");
+    EXPECT_NE(Symbol(text), Symbol(StaticName("other")));
+    EXPECT_EQ(Symbol(std::string_view()), Symbol());
+    EXPECT_EQ(Symbol().get_id(), 0u);
+}
+
+TEST(ScriptValues, Conversions) {
+    EXPECT_TRUE(ScriptValue().is_none());
+    EXPECT_FALSE(ScriptValue().as_bool());
+
+    EXPECT_DOUBLE_EQ(ScriptValue(2.5).as_number(), 2.5);
+    EXPECT_DOUBLE_EQ(ScriptValue("4").as_number(), 4.0);
+    EXPECT_DOUBLE_EQ(ScriptValue(true).as_number(), 1.0);
+
+    EXPECT_TRUE(ScriptValue(1.0).as_bool());
+    EXPECT_FALSE(ScriptValue(0.0).as_bool());
+    EXPECT_TRUE(ScriptValue("text").as_bool());
+    EXPECT_FALSE(ScriptValue("").as_bool());
+
+    GUID guid = GUID::from_string("fedcba9876543210fedcba9876543210");
+    EXPECT_EQ(ScriptValue(guid.to_string()).as_guid(), guid);
+    EXPECT_EQ(ScriptValue(guid).as_string(), guid.to_string());
+}
+
+TEST(ScriptValues, Equality) {
+    EXPECT_TRUE(ScriptValue(1.0).equals(ScriptValue(true)));
+    EXPECT_TRUE(ScriptValue("3").equals(ScriptValue(3)));
+    EXPECT_FALSE(ScriptValue("3a").equals(ScriptValue(3)));
+    EXPECT_TRUE(ScriptValue("text").equals(ScriptValue("text")));
+    EXPECT_FALSE(ScriptValue().equals(ScriptValue("")));
+
+    // Strict comparison takes types into account
+    EXPECT_NE(ScriptValue(1.0), ScriptValue(true));
+    EXPECT_EQ(ScriptValue("text"), ScriptValue(std::string("text")));
+}
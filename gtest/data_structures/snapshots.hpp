@@ -0,0 +1,51 @@
+/**
+ * @file snapshots.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Snapshot history tests
+ * @version 0.1
+ * @date 2025-02-04
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "logics/snapshot.h"
+
+static SceneSnapshot make_snapshot(int value) {
+    SceneSnapshot snapshot;
+
+    snapshot.records.push_back({GUID(), 0, 64 * sizeof(int)});
+    snapshot.data.resize(64 * sizeof(int));
+
+    int* data = reinterpret_cast<int*>(snapshot.data.data());
+    for (int id = 0; id < 64; ++id) data[id] = id % 8 == 0 ? value : id;
+
+    return snapshot;
+}
+
+TEST(SnapshotHistory, Rewind) {
+    SnapshotHistory history(16, 4);
+
+    for (int frame = 0; frame < 40; ++frame) {
+        history.push(make_snapshot(frame));
+    }
+
+    EXPECT_EQ(history.size(), 16);
+
+    SceneSnapshot snapshot;
+    for (size_t age = 0; age < history.size(); ++age) {
+        ASSERT_TRUE(history.get(age, snapshot));
+        EXPECT_EQ(snapshot.data, make_snapshot(39 - (int)age).data);
+    }
+
+    EXPECT_FALSE(history.get(history.size(), snapshot));
+
+    history.rewind(6);
+    history.push(make_snapshot(100));
+
+    ASSERT_TRUE(history.get(1, snapshot));
+    EXPECT_EQ(snapshot.data, make_snapshot(33).data);
+
+    ASSERT_TRUE(history.get(0, snapshot));
+    EXPECT_EQ(snapshot.data, make_snapshot(100).data);
+}
@@ -0,0 +1,105 @@
+/**
+ * @file timing_wheel.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Timing wheel tests
+ * @version 0.1
+ * @date 2025-02-07
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <memory>
+
+#include "time/timing_wheel.h"
+
+TEST(TimingWheel, Ordering) {
+    // Wheels are too large for the stack
+    std::unique_ptr<TimingWheel> holder = std::make_unique<TimingWheel>();
+    TimingWheel& wheel = *holder;
+
+    std::vector<uint64_t> performed;
+
+    // Spread the calls across all the wheel levels
+    const uint64_t ticks[] = {5, 3, 300, 70000, 3, 1ull << 26, 1ull << 40, 0};
+
+    for (uint64_t tick : ticks) {
+        wheel.schedule(tick, [&performed, tick, &wheel]() {
+            EXPECT_GE(wheel.get_current_tick(), tick);
+            performed.push_back(tick);
+        });
+    }
+
+    wheel.advance(4);
+    EXPECT_EQ(performed, std::vector<uint64_t>({0, 3, 3}));
+
+    wheel.advance(1ull << 26);
+    EXPECT_EQ(performed, std::vector<uint64_t>({0, 3, 3, 5, 300, 70000,
+                                                1ull << 26}));
+
+    wheel.advance(1ull << 41);
+    EXPECT_EQ(performed.size(), 8);
+    EXPECT_EQ(performed.back(), 1ull << 40);
+    EXPECT_EQ(wheel.get_pending_count(), 0);
+}
+
+TEST(TimingWheel, Cancellation) {
+    std::unique_ptr<TimingWheel> holder = std::make_unique<TimingWheel>();
+    TimingWheel& wheel = *holder;
+
+    int performed = 0;
+
+    TimingWheel::Handle first = wheel.schedule(10, [&]() { ++performed; });
+    TimingWheel::Handle second = wheel.schedule(10, [&]() { ++performed; });
+    TimingWheel::Handle third = wheel.schedule(1000, [&]() { ++performed; });
+
+    EXPECT_TRUE(wheel.cancel(second));
+    EXPECT_FALSE(wheel.cancel(second));
+    EXPECT_TRUE(wheel.is_pending(third));
+
+    wheel.advance(20);
+
+    EXPECT_EQ(performed, 1);
+    EXPECT_FALSE(wheel.is_pending(first));
+    EXPECT_FALSE(wheel.cancel(first));
+
+    EXPECT_TRUE(wheel.cancel(third));
+
+    wheel.advance(2000);
+
+    EXPECT_EQ(performed, 1);
+}
+
+TEST(TimingWheel, Rebase) {
+    std::unique_ptr<TimingWheel> holder = std::make_unique<TimingWheel>(100);
+    TimingWheel& wheel = *holder;
+
+    std::vector<int> performed;
+
+    wheel.schedule(105, [&performed]() { performed.push_back(1); });
+    wheel.schedule(105, [&performed]() { performed.push_back(2); });
+    wheel.schedule(100 + 70000, [&performed]() { performed.push_back(3); });
+
+    TimingWheel::Handle cancelled =
+        wheel.schedule(400, [&performed]() { performed.push_back(4); });
+
+    wheel.advance(101);
+    wheel.rebase(7);
+
+    // Calls keep their order, handles and the ticks left until them
+    EXPECT_EQ(wheel.get_pending_count(), 4);
+    EXPECT_TRUE(wheel.cancel(cancelled));
+
+    wheel.advance(9);
+    EXPECT_TRUE(performed.empty());
+
+    wheel.advance(10);
+    EXPECT_EQ(performed, std::vector<int>({1, 2}));
+
+    wheel.advance(7 + 69997);
+    EXPECT_EQ(performed.size(), 2);
+
+    wheel.advance(7 + 69998);
+    EXPECT_EQ(performed, std::vector<int>({1, 2, 3}));
+    EXPECT_EQ(wheel.get_pending_count(), 0);
+}
@@ -11,7 +11,21 @@
 
 #include <gtest/gtest.h>
 
+#include "assets/baked_meshes.hpp"
+#include "assets/requests.hpp"
 #include "data_structures/box_search.hpp"
+#include "data_structures/script_values.hpp"
+#include "data_structures/snapshots.hpp"
+#include "data_structures/timing_wheel.hpp"
+#include "levels/streams.hpp"
+#include "logger/metrics.hpp"
+#include "memory/inplace_function.hpp"
 #include "pipelining/events.hpp"
+#include "pipelining/fast_forward.hpp"
 #include "pipelining/state_machines.hpp"
+#include "pipelining/tasks.hpp"
+#include "pipelining/thread_pool.hpp"
+#include "scripts/lexer.hpp"
+#include "scripts/programs.hpp"
 #include "subcomponents/subcomponents.hpp"
+#include "time/profiler.hpp"
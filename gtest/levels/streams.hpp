@@ -0,0 +1,218 @@
+/**
+ * @file streams.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Level streaming tests
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <unistd.h>
+
+#include <atomic>
+#include <optional>
+
+#include "logics/blueprints/external_level.h"
+#include "logics/scene.h"
+#include "logics/scene_component.h"
+#include "managers/tick_manager.h"
+#include "time/clock.h"
+#include "time/world_timer.h"
+
+struct StreamProbe : public SceneComponent {
+    StreamProbe()
+        : input_([this](const ScriptValue& value) {
+              received.push_back(value);
+          }) {
+        use_channels(CHANNELS);
+    }
+
+    Channel output{};
+    std::vector<ScriptValue> received{};
+
+   private:
+    static const ChannelTable CHANNELS;
+
+    InputChannel input_;
+};
+
+inline const SceneComponent::ChannelTable StreamProbe::CHANNELS =
+    ChannelTable()
+        .input<&StreamProbe::input_>("in")
+        .output<&StreamProbe::output>("out");
+
+static ExternalLevel make_probe_level(size_t component_count,
+                                      std::atomic<unsigned>& produced,
+                                      unsigned delay_us = 0) {
+    ExternalLevel::Factory factory;
+
+    for (size_t id = 0; id < component_count; ++id) {
+        factory.register_producer(
+            "Probe" + std::to_string(id),
+            [&produced, delay_us](
+                const glm::mat4&) -> Subcomponent<SceneComponent> {
+                if (delay_us > 0) usleep(delay_us);
+                ++produced;
+                return Subcomponent<StreamProbe>();
+            });
+    }
+
+    return ExternalLevel(factory, {Script("@Probe0::in <- @Probe1.out")});
+}
+
+TEST(LevelStreams, Slices) {
+    std::atomic<unsigned> produced = 0;
+    ExternalLevel level = make_probe_level(3, produced);
+
+    Scene scene(16.0, 16.0, 4.0);
+    ExternalLevel::StreamHandle stream = level.stream(scene, glm::mat4(1.0));
+
+    EXPECT_DOUBLE_EQ(stream->get_progress(), 0.0);
+
+    // Expired deadlines still let every slice perform a single step
+    for (unsigned step = 1; step <= 3; ++step) {
+        EXPECT_FALSE(stream->advance(0.0));
+        EXPECT_EQ(produced, step);
+        EXPECT_EQ(scene.get_component_count(), step);
+        EXPECT_DOUBLE_EQ(stream->get_progress(), step / 4.0);
+    }
+
+    // The script is assembled once all the components are on the scene
+    EXPECT_TRUE(stream->advance(0.0));
+    EXPECT_TRUE(stream->is_finished());
+    EXPECT_DOUBLE_EQ(stream->get_progress(), 1.0);
+
+    const SubcomponentNameMap& components = stream->get_components();
+    ASSERT_EQ(components.size(), 3);
+
+    Subcomponent<StreamProbe> first =
+        static_subcomponent_cast<StreamProbe>(components.at("Probe0"));
+    Subcomponent<StreamProbe> second =
+        static_subcomponent_cast<StreamProbe>(components.at("Probe1"));
+
+    second->output.trigger(5);
+    EXPECT_EQ(first->received, std::vector<ScriptValue>({5}));
+
+    EXPECT_TRUE(stream->advance(0.0));
+    EXPECT_EQ(produced, 3);
+}
+
+TEST(LevelStreams, Completion) {
+    VirtualClock clock;
+    WorldTimer::set_clock(clock);
+
+    std::atomic<unsigned> produced = 0;
+    ExternalLevel level = make_probe_level(8, produced);
+
+    Scene scene(16.0, 16.0, 4.0);
+    ThreadPool pool(2);
+
+    TickManager ticker([]() {}, [](double) {}, [](double, double) {});
+    ticker.set_fast_forward(true, &clock);
+
+    ExternalLevel::StreamHandle stream =
+        level.stream(scene, glm::mat4(1.0), ticker, &pool);
+
+    EXPECT_EQ(ticker.get_sliced_task_count(), 1);
+
+    for (unsigned tick = 0; tick < 100 && !stream->is_finished(); ++tick) {
+        ticker.tick();
+    }
+
+    EXPECT_TRUE(stream->is_finished());
+    EXPECT_EQ(produced, 8);
+    EXPECT_EQ(scene.get_component_count(), 8);
+    EXPECT_EQ(stream->get_components().size(), 8);
+
+    // Finished streams are dropped by the tick manager
+    EXPECT_EQ(ticker.get_sliced_task_count(), 0);
+
+    WorldTimer::set_clock(WorldTimer::get_wall_clock());
+}
+
+TEST(LevelStreams, Teardown) {
+    VirtualClock clock;
+    WorldTimer::set_clock(clock);
+
+    std::atomic<unsigned> produced = 0;
+    std::optional<ExternalLevel> level = make_probe_level(6, produced, 2000);
+
+    ThreadPool pool(2);
+
+    TickManager ticker([]() {}, [](double) {}, [](double, double) {});
+    ticker.set_fast_forward(true, &clock);
+
+    {
+        Scene scene(16.0, 16.0, 4.0);
+
+        ExternalLevel::StreamHandle stream =
+            level->stream(scene, glm::mat4(1.0), ticker, &pool);
+
+        // Cancelling waits for the producers on the pool, after which the
+        // level can be unloaded
+        stream->advance(0.0);
+        stream->cancel();
+
+        EXPECT_EQ(produced, 6);
+        EXPECT_TRUE(stream->is_cancelled());
+        EXPECT_FALSE(stream->is_finished());
+        EXPECT_LT(scene.get_component_count(), 6);
+
+        ticker.tick();
+        EXPECT_EQ(ticker.get_sliced_task_count(), 0);
+    }
+
+    level.reset();
+
+    // Dropped streams wait for the pool as well
+    produced = 0;
+    level = make_probe_level(6, produced, 2000);
+
+    {
+        Scene scene(16.0, 16.0, 4.0);
+        level->stream(scene, glm::mat4(1.0), &pool);
+    }
+
+    EXPECT_EQ(produced, 6);
+
+    WorldTimer::set_clock(WorldTimer::get_wall_clock());
+}
+
+TEST(LevelStreams, SceneDestroyed) {
+    VirtualClock clock;
+    WorldTimer::set_clock(clock);
+
+    std::atomic<unsigned> produced = 0;
+    std::optional<ExternalLevel> level = make_probe_level(6, produced, 2000);
+
+    ThreadPool pool(2);
+
+    TickManager ticker([]() {}, [](double) {}, [](double, double) {});
+    ticker.set_fast_forward(true, &clock);
+
+    std::optional<Scene> scene;
+    scene.emplace(16.0, 16.0, 4.0);
+
+    ExternalLevel::StreamHandle stream =
+        level->stream(*scene, glm::mat4(1.0), ticker, &pool);
+
+    stream->advance(0.0);
+    EXPECT_FALSE(stream->is_finished());
+
+    // Neither the scene nor the level is cancelling the stream explicitly
+    scene.reset();
+    level.reset();
+
+    ticker.tick();
+
+    EXPECT_TRUE(stream->is_cancelled());
+    EXPECT_EQ(produced, 6);
+    EXPECT_EQ(ticker.get_sliced_task_count(), 0);
+
+    stream->finish();
+    EXPECT_FALSE(stream->is_finished());
+
+    WorldTimer::set_clock(WorldTimer::get_wall_clock());
+}
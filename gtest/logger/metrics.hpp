@@ -0,0 +1,106 @@
+/**
+ * @file metrics.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Metrics registry tests
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logger/metrics.h"
+
+static std::set<std::string> split_lines(const std::string& text) {
+    std::set<std::string> lines;
+
+    std::istringstream stream(text);
+    for (std::string line; std::getline(stream, line);) lines.insert(line);
+
+    return lines;
+}
+
+TEST(Metrics, Counter) {
+    Counter counter;
+
+    std::vector<std::thread> threads;
+
+    for (unsigned id = 0; id < 4; ++id) {
+        threads.emplace_back([&counter]() {
+            for (unsigned step = 0; step < 1000; ++step) counter.add();
+        });
+    }
+
+    for (std::thread& thread : threads) thread.join();
+
+    counter.add(5);
+
+    EXPECT_EQ(counter.get(), 4005);
+}
+
+TEST(Metrics, Histogram) {
+    // Bounds are sorted by the histogram
+    Histogram histogram({4.0, 1.0, 2.0});
+
+    EXPECT_EQ(histogram.get_bounds(), std::vector<double>({1.0, 2.0, 4.0}));
+
+    for (double value : {0.5, 1.0, 3.0, 10.0, 20.0}) histogram.record(value);
+
+    // Values equal to a bound fall into its bucket
+    EXPECT_EQ(histogram.get_bucket(0), 2);
+    EXPECT_EQ(histogram.get_bucket(1), 0);
+    EXPECT_EQ(histogram.get_bucket(2), 1);
+    EXPECT_EQ(histogram.get_bucket(3), 2);
+    EXPECT_EQ(histogram.get_bucket(4), 0);
+
+    EXPECT_EQ(histogram.get_count(), 5);
+    EXPECT_DOUBLE_EQ(histogram.get_sum(), 34.5);
+}
+
+TEST(Metrics, TextFormat) {
+    static const char* PATH = "metrics_test.txt";
+
+    Metrics::get_counter("test_metrics_counter").add(3);
+    Metrics::get_gauge("test_metrics_gauge").set(2.5);
+
+    Histogram& histogram =
+        Metrics::get_histogram("test_metrics_latency", {1.0, 2.0});
+    histogram.record(0.5);
+    histogram.record(3.0);
+
+    // Existing metrics are shared
+    EXPECT_EQ(&Metrics::get_histogram("test_metrics_latency"), &histogram);
+
+    std::string text = Metrics::format();
+    std::set<std::string> lines = split_lines(text);
+
+    for (const char* line : {
+             "test_metrics_counter 3",
+             "test_metrics_gauge 2.5",
+             "test_metrics_latency_bucket{le=\"1\"} 1",
+             "test_metrics_latency_bucket{le=\"2\"} 1",
+             "test_metrics_latency_bucket{le=\"+Inf\"} 2",
+             "test_metrics_latency_sum 3.5",
+             "test_metrics_latency_count 2",
+         }) {
+        EXPECT_EQ(lines.count(line), 1) << line;
+    }
+
+    ASSERT_TRUE(Metrics::dump(PATH));
+
+    std::ifstream stream(PATH);
+    std::string dumped(std::istreambuf_iterator<char>{stream}, {});
+
+    EXPECT_EQ(split_lines(dumped), lines);
+
+    remove(PATH);
+}
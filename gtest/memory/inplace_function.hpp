@@ -0,0 +1,125 @@
+/**
+ * @file inplace_function.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief InplaceFunction tests
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "memory/inplace_function.hpp"
+
+struct CountedCallable {
+    explicit CountedCallable(int& live_count) : live_count_(&live_count) {
+        ++*live_count_;
+    }
+
+    CountedCallable(const CountedCallable& other)
+        : live_count_(other.live_count_) {
+        ++*live_count_;
+    }
+
+    CountedCallable& operator=(const CountedCallable&) = delete;
+
+    ~CountedCallable() { --*live_count_; }
+
+    // Address of the target, to find out where it is stored
+    uintptr_t operator()() const { return (uintptr_t)this; }
+
+   private:
+    int* live_count_;
+};
+
+template <class Function>
+static bool is_stored_inline(const Function& function, uintptr_t target) {
+    uintptr_t begin = (uintptr_t)&function;
+    return begin <= target && target < begin + sizeof(function);
+}
+
+TEST(InplaceFunction, InlineStorage) {
+    using Function = InplaceFunction<uintptr_t(), 32>;
+
+    int live_count = 0;
+
+    Function function = CountedCallable(live_count);
+    EXPECT_TRUE(is_stored_inline(function, function()));
+
+    Function copy = function;
+    EXPECT_TRUE(is_stored_inline(copy, copy()));
+
+    Function moved = std::move(copy);
+    EXPECT_TRUE(is_stored_inline(moved, moved()));
+
+    EXPECT_LE(sizeof(Function), 32 + 2 * sizeof(max_align_t));
+}
+
+TEST(InplaceFunction, CapturedState) {
+    std::string prefix = "value: ";
+
+    InplaceFunction<std::string(int)> function =
+        [prefix, calls = 0](int value) mutable {
+            return prefix + std::to_string(value) + " #" +
+                   std::to_string(++calls);
+        };
+
+    EXPECT_EQ(function(1), "value: 1 #1");
+
+    // Copies get their own state
+    InplaceFunction<std::string(int)> copy = function;
+
+    EXPECT_EQ(copy(2), "value: 2 #2");
+    EXPECT_EQ(copy(3), "value: 3 #3");
+    EXPECT_EQ(function(4), "value: 4 #2");
+
+    InplaceFunction<std::string(int)> moved = std::move(copy);
+    EXPECT_EQ(moved(5), "value: 5 #4");
+
+    InplaceFunction<std::string(int)> assigned;
+    EXPECT_FALSE(assigned);
+    EXPECT_THROW(assigned(0), std::bad_function_call);
+
+    assigned = function;
+    EXPECT_EQ(assigned(6), "value: 6 #3");
+
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned(7), "value: 7 #5");
+
+    assigned = nullptr;
+    EXPECT_FALSE(assigned);
+}
+
+TEST(InplaceFunction, Destruction) {
+    int live_count = 0;
+
+    {
+        InplaceFunction<uintptr_t()> function = CountedCallable(live_count);
+        EXPECT_EQ(live_count, 1);
+
+        InplaceFunction<uintptr_t()> copy = function;
+        EXPECT_EQ(live_count, 2);
+
+        // Moved-from targets are still destroyed by their wrapper
+        InplaceFunction<uintptr_t()> moved = std::move(copy);
+        EXPECT_EQ(live_count, 3);
+
+        copy = nullptr;
+        EXPECT_EQ(live_count, 2);
+
+        // Assignment destroys the previous target
+        function = moved;
+        EXPECT_EQ(live_count, 2);
+
+        function = [] { return (uintptr_t)0; };
+        EXPECT_EQ(live_count, 1);
+    }
+
+    EXPECT_EQ(live_count, 0);
+}
@@ -9,6 +9,11 @@
  *
  */
 
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include "pipelining/event.hpp"
 
 TEST(Events, Trigger) {
@@ -142,3 +147,147 @@ TEST(Events, SubscriberDeath) {
 
     ASSERT_EQ(triggered, false);
 }
+
+TEST(Events, PostFromThreads) {
+    static const int THREAD_COUNT = 4;
+    static const int POST_COUNT = 1000;
+
+    DeferredEventQueue queue(THREAD_COUNT * POST_COUNT);
+
+    Event<int, int> event;
+    event.set_deferred_queue(queue);
+
+    std::vector<int> received(THREAD_COUNT, 0);
+    bool in_order = true;
+
+    Event<int, int>::Listener receiver([&](int thread, int value) {
+        in_order = in_order && value == received[(size_t)thread];
+        ++received[(size_t)thread];
+    });
+    receiver.subscribe_to(event);
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < THREAD_COUNT; ++thread) {
+        threads.emplace_back([&event, thread]() {
+            for (int value = 0; value < POST_COUNT; ++value) {
+                EXPECT_TRUE(event.post(thread, value));
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) thread.join();
+
+    EXPECT_EQ(received, std::vector<int>(THREAD_COUNT, 0));
+
+    EXPECT_EQ(queue.dispatch(), (size_t)(THREAD_COUNT * POST_COUNT));
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(received, std::vector<int>(THREAD_COUNT, POST_COUNT));
+
+    // Payloads of destroyed events are dropped
+    {
+        Event<int, int> dying;
+        dying.set_deferred_queue(queue);
+        dying.post(0, 0);
+    }
+
+    EXPECT_EQ(queue.dispatch(), 0);
+}
+
+TEST(Events, MovePostedEvent) {
+    DeferredEventQueue queue(16);
+
+    std::vector<int> received;
+    Event<int>::Listener receiver(
+        [&received](int value) { received.push_back(value); });
+
+    std::optional<Event<int>> event(std::in_place);
+    event->set_deferred_queue(queue);
+    receiver.subscribe_to(*event);
+
+    event->post(1);
+
+    // Queued payloads follow the moved event
+    Event<int> moved(std::move(*event));
+    event.reset();
+
+    moved.post(2);
+
+    EXPECT_EQ(queue.dispatch(), 2);
+    EXPECT_EQ(received, std::vector<int>({1, 2}));
+
+    // Payloads of the assigned event are dropped, the moved ones are kept
+    Event<int> assigned;
+    assigned.set_deferred_queue(queue);
+    assigned.post(3);
+
+    moved.post(4);
+    assigned = std::move(moved);
+
+    {
+        Event<int> dying(std::move(assigned));
+        dying.post(5);
+        assigned = std::move(dying);
+    }
+
+    EXPECT_EQ(queue.dispatch(), 2);
+    EXPECT_EQ(received, std::vector<int>({1, 2, 4, 5}));
+}
+
+TEST(Events, ListenerOwnership) {
+    static_assert(!std::is_copy_constructible_v<Event<int>::Listener>,
+                  "Copied listeners would be notified twice");
+
+    Event<int> event;
+
+    int sum = 0;
+    std::vector<Event<int>::Listener> listeners;
+
+    // Subscriptions survive the reallocations of the vector
+    for (int id = 1; id <= 8; ++id) {
+        listeners.emplace_back([&sum, id](int value) { sum += id * value; });
+        listeners.back().subscribe_to(event);
+    }
+
+    event.trigger(1);
+    EXPECT_EQ(sum, 36);
+
+    Event<int>::Listener moved = std::move(listeners.front());
+    EXPECT_TRUE(moved.is_subscribed());
+    EXPECT_FALSE(listeners.front().is_subscribed());
+
+    listeners.clear();
+
+    event.trigger(1);
+    EXPECT_EQ(sum, 37);
+}
+
+TEST(Events, MultilistenerUnsubscribe) {
+    int value = 0;
+
+    Event<int>::Multilistener listener([&value](int payload) {
+        value += payload;
+    });
+
+    Event<int> first, second, third;
+
+    listener.subscribe_to(first);
+    listener.subscribe_to(second);
+    listener.subscribe_to(third);
+
+    // The last listener and the one moved into the freed slot are removed
+    listener.unsubscribe_from(third);
+    listener.unsubscribe_from(first);
+
+    first.trigger(1);
+    third.trigger(10);
+    EXPECT_EQ(value, 0);
+
+    second.trigger(100);
+    EXPECT_EQ(value, 100);
+
+    listener.unsubscribe_from(second);
+
+    second.trigger(100);
+    EXPECT_EQ(value, 100);
+}
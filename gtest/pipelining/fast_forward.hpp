@@ -0,0 +1,45 @@
+/**
+ * @file fast_forward.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Virtual clock simulation tests
+ * @version 0.1
+ * @date 2025-02-08
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "managers/tick_manager.h"
+#include "time/clock.h"
+#include "time/world_timer.h"
+
+TEST(TickManager, FastForward) {
+    VirtualClock clock;
+    WorldTimer::set_clock(clock);
+
+    unsigned phys_ticks = 0, draw_ticks = 0, scheduled_calls = 0;
+
+    TickManager ticker(
+        []() {},
+        [&](double delta_time) {
+            EXPECT_DOUBLE_EQ(delta_time, 0.01);
+            ++phys_ticks;
+            WorldTimer::run_scheduled_calls();
+        },
+        [&](double, double) { ++draw_ticks; });
+
+    ticker.set_tps_req(100);
+    ticker.set_fast_forward(true, &clock);
+
+    WorldTimer::schedule(0.5, [&]() { ++scheduled_calls; });
+
+    for (unsigned tick = 0; tick < 100; ++tick) ticker.tick();
+
+    EXPECT_EQ(phys_ticks, 100);
+    EXPECT_EQ(draw_ticks, 0);
+    EXPECT_EQ(scheduled_calls, 1);
+    EXPECT_NEAR(WorldTimer::get_time_sec(), 1.0, 1e-6);
+    EXPECT_NEAR(ticker.get_age(), 1.0, 1e-6);
+
+    WorldTimer::set_clock(WorldTimer::get_wall_clock());
+}
@@ -1,4 +1,5 @@
 #include "pipelining/state_machine.hpp"
+#include "pipelining/static_state_machine.hpp"
 
 //! WARNING: Some incredibly bad code ahead, don't use it outside of state
 //! machine testing
@@ -94,3 +95,79 @@ TEST(StateMachines, Weapon) {
 
     EXPECT_EQ(&weapon.controller.get_active(), &weapon.shooting_state);
 }
+
+struct StaticWeapon {
+    int ammo = 1024;
+    int clip = 32;
+
+    struct Idle {};
+
+    struct Shooting {
+        void update(StaticWeapon& owner, double) { --owner.clip; }
+    };
+
+    struct Reloading {
+        void enter(StaticWeapon&) { time = 0; }
+        void update(StaticWeapon&, double delta_time) { time += delta_time; }
+        void leave(StaticWeapon& owner) {
+            owner.clip = 32;
+            owner.ammo -= 32;
+        }
+
+        double time = 0.0;
+    };
+
+    struct ClipEmpty {
+        bool operator()(const StaticWeapon& owner) const {
+            return owner.clip <= 0;
+        }
+    };
+
+    struct Reloaded {
+        bool operator()(const StaticWeapon& owner) const {
+            return owner.controller.get_state<Reloading>().time > 1.0;
+        }
+    };
+
+    using Controller = StaticStateMachine<
+        StaticWeapon, StateList<Idle, Shooting, Reloading>,
+        TransitionList<Transition<Idle, Shooting>,
+                       Transition<Shooting, Reloading, ClipEmpty>,
+                       Transition<Reloading, Idle, Reloaded>>,
+        double>;
+
+    StaticWeapon() : controller(*this) {}
+
+    Controller controller;
+};
+
+TEST(StateMachines, StaticWeapon) {
+    StaticWeapon weapon;
+
+    EXPECT_TRUE(weapon.controller.is_active<StaticWeapon::Idle>());
+
+    weapon.controller.update(0.0);
+
+    EXPECT_TRUE(weapon.controller.is_active<StaticWeapon::Shooting>());
+
+    for (unsigned id = 0; id < 33; ++id) {
+        weapon.controller.update(0.0);
+    }
+
+    EXPECT_TRUE(weapon.controller.is_active<StaticWeapon::Reloading>());
+
+    EXPECT_EQ(weapon.clip, 0);
+
+    weapon.controller.update(10.0);
+
+    EXPECT_TRUE(weapon.controller.is_active<StaticWeapon::Reloading>());
+
+    weapon.controller.update(0.0);
+
+    EXPECT_TRUE(weapon.controller.is_active<StaticWeapon::Idle>());
+    EXPECT_EQ(weapon.clip, 32);
+
+    weapon.controller.update(0.0);
+
+    EXPECT_TRUE(weapon.controller.is_active<StaticWeapon::Shooting>());
+}
@@ -0,0 +1,119 @@
+/**
+ * @file tasks.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Coroutine task tests
+ * @version 0.1
+ * @date 2025-02-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "logics/task.h"
+#include "time/clock.h"
+#include "time/world_timer.h"
+
+// Frames of coroutines are lowered to a switch without a default case
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-default"
+
+static Task count_ticks(TaskScheduler& scheduler, unsigned count,
+                        double& elapsed) {
+    for (unsigned tick = 0; tick < count; ++tick) {
+        elapsed += co_await Task::next_tick();
+    }
+}
+
+static Task wait_for_value(TaskScheduler& scheduler, Event<int>& event,
+                           int& value) {
+    value = co_await Task::wait_for(event);
+}
+
+static Task sequence(TaskScheduler& scheduler, Event<int>& event,
+                     std::vector<int>& log) {
+    double elapsed = 0.0;
+    co_await count_ticks(scheduler, 2, elapsed);
+    log.push_back((int)(elapsed * 10.0 + 0.5));
+
+    co_await Task::delay(0.5);
+    log.push_back(-1);
+
+    int value = 0;
+    co_await wait_for_value(scheduler, event, value);
+    log.push_back(value);
+}
+
+static Task wake_and_tick(TaskScheduler& scheduler, Event<int>& event,
+                          std::vector<int>& log) {
+    log.push_back(co_await Task::wait_for(event));
+
+    co_await Task::next_tick();
+    log.push_back(-1);
+}
+
+#pragma GCC diagnostic pop
+
+TEST(Tasks, Sequencing) {
+    VirtualClock clock;
+    WorldTimer::set_clock(clock);
+
+    std::vector<int> log;
+    Event<int> event;
+
+    {
+        TaskScheduler scheduler;
+
+        scheduler.start(sequence(scheduler, event, log));
+        EXPECT_EQ(scheduler.get_task_count(), 1);
+        EXPECT_GT(scheduler.get_frame_pool().get_used_count(), 0);
+
+        scheduler.update(0.1);
+        scheduler.update(0.1);
+        EXPECT_EQ(log, std::vector<int>({2}));
+
+        clock.advance_sec(0.25);
+        WorldTimer::run_scheduled_calls();
+        EXPECT_EQ(log.size(), 1);
+
+        clock.advance_sec(0.5);
+        WorldTimer::run_scheduled_calls();
+        EXPECT_EQ(log.size(), 2);
+
+        // Payload is delivered on the next update
+        event.trigger(42);
+        EXPECT_EQ(log.size(), 2);
+
+        scheduler.update(0.1);
+        EXPECT_EQ(log, std::vector<int>({2, -1, 42}));
+
+        EXPECT_EQ(scheduler.get_task_count(), 0);
+        EXPECT_EQ(scheduler.get_frame_pool().get_used_count(), 0);
+
+        // Suspended tasks are destroyed with the scheduler
+        scheduler.start(sequence(scheduler, event, log));
+        scheduler.update(0.1);
+    }
+
+    event.trigger(0);
+    EXPECT_EQ(log.size(), 3);
+
+    WorldTimer::set_clock(WorldTimer::get_wall_clock());
+}
+
+TEST(Tasks, TickAfterEvent) {
+    std::vector<int> log;
+    Event<int> event;
+
+    TaskScheduler scheduler;
+    scheduler.start(wake_and_tick(scheduler, event, log));
+
+    event.trigger(7);
+
+    // Tasks woken up by events wait for the next tick of their own
+    scheduler.update(0.1);
+    EXPECT_EQ(log, std::vector<int>({7}));
+
+    scheduler.update(0.1);
+    EXPECT_EQ(log, std::vector<int>({7, -1}));
+    EXPECT_EQ(scheduler.get_task_count(), 0);
+}
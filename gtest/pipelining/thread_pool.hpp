@@ -0,0 +1,69 @@
+/**
+ * @file thread_pool.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Thread pool and main thread call queue tests
+ * @version 0.1
+ * @date 2025-02-03
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "logics/blueprints/component_factory.hpp"
+#include "logics/scene_component.h"
+#include "pipelining/main_thread.h"
+#include "pipelining/thread_pool.hpp"
+
+TEST(ThreadPool, Basics) {
+    ThreadPool pool(4);
+
+    std::vector<std::future<int>> results;
+
+    for (int id = 0; id < 100; ++id) {
+        results.push_back(pool.submit([id]() { return id * id; }));
+    }
+
+    for (size_t id = 0; id < results.size(); ++id) {
+        EXPECT_EQ(results[id].get(), (int)(id * id));
+    }
+}
+
+TEST(ThreadPool, MainThreadCalls) {
+    ThreadPool pool(2);
+
+    EXPECT_TRUE(MainThread::is_current());
+
+    std::future<bool> result = pool.submit([]() {
+        return !MainThread::is_current() &&
+               MainThread::call([]() { return MainThread::is_current(); });
+    });
+
+    EXPECT_TRUE(MainThread::wait(result));
+    EXPECT_TRUE(result.get());
+}
+
+TEST(ThreadPool, FactoryArguments) {
+    ThreadPool pool(4);
+
+    std::atomic<unsigned> intact = 0;
+
+    ComponentFactory<std::string> factory;
+
+    for (unsigned id = 0; id < 8; ++id) {
+        factory.register_producer(
+            "Component" + std::to_string(id),
+            [&intact](std::string&& name) -> Subcomponent<SceneComponent> {
+                // Producers are allowed to take their arguments
+                std::string taken{};
+                taken.swap(name);
+                if (taken == "level") ++intact;
+                return SubcomponentNone;
+            });
+    }
+
+    factory.build(pool, "level");
+    EXPECT_EQ(intact, 8);
+
+    factory.build("level");
+    EXPECT_EQ(intact, 16);
+}
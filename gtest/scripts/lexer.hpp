@@ -0,0 +1,117 @@
+/**
+ * @file lexer.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Script lexer tests
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+
+#include <chrono>
+#include <string>
+
+#include "logics/blueprints/scripts/parser/lexemizer.h"
+
+TEST(Lexer, Kinds) {
+    LexemeBuffer buffer = lexify(
+        "order = a <= b != !c # comment\n"
+        "@Probe::in <- sin(3.5) + \"quoted \\\" string\" // comment\n"
+        "loge log10 log");
+
+    std::vector<LexemeKind> expected = {
+        LexemeKind::STRING,           LexemeKind::MACRO_ASSIGNMENT,
+        LexemeKind::STRING,           LexemeKind::LESS_EQ,
+        LexemeKind::STRING,           LexemeKind::NOT_EQUAL,
+        LexemeKind::NOT,              LexemeKind::STRING,
+        LexemeKind::NAMED_COMPONENT,  LexemeKind::ASSIGNMENT_LEFT,
+        LexemeKind::STRING,           LexemeKind::ASSIGNMENT_RIGHT,
+        LexemeKind::SINE,             LexemeKind::BRACKET_ROUND_OP,
+        LexemeKind::STRING,           LexemeKind::BRACKET_ROUND_CL,
+        LexemeKind::PLUS,             LexemeKind::STRING,
+        LexemeKind::LN,               LexemeKind::LOG10,
+        LexemeKind::STRING,
+    };
+
+    ASSERT_EQ(buffer.lexemes.size(), expected.size());
+
+    for (size_t id = 0; id < expected.size(); ++id) {
+        EXPECT_EQ(buffer.lexemes[id].kind, expected[id]) << "lexeme " << id;
+    }
+
+    EXPECT_EQ(buffer.get_string(buffer.lexemes[0]), "order");
+    EXPECT_EQ(buffer.get_string(buffer.lexemes[8]), "Probe");
+    EXPECT_EQ(buffer.get_string(buffer.lexemes[14]), "3.5");
+    EXPECT_EQ(buffer.get_string(buffer.lexemes[17]), "quoted \" string");
+    EXPECT_TRUE(buffer.lexemes[17].exact);
+
+    EXPECT_EQ(buffer.lexemes[8].line, 1u);
+    EXPECT_EQ(buffer.lexemes[8].column, 0u);
+    EXPECT_EQ(buffer.lexemes[18].line, 2u);
+    EXPECT_EQ(buffer.lexemes[20].column, 11u);
+}
+
+TEST(Lexer, LargeScript) {
+    static const size_t LEXEMES_PER_LINE = 20;
+    static const size_t LINE_COUNT = 1 << 12;
+
+    std::string script{};
+    char line[256] = "";
+
+    for (size_t id = 0; id < LINE_COUNT; ++id) {
+        snprintf(line, sizeof(line),
+                 "value_%zu = (@Component_%zu.channel + 2.5) * sin(value) <= "
+                 "10 ? \"text\" : other  # comment\n",
+                 id, id);
+        script += line;
+    }
+
+    LexemeBuffer buffer = lexify(script);
+
+    ASSERT_EQ(buffer.lexemes.size(), LINE_COUNT * LEXEMES_PER_LINE);
+
+    // Positions are kept across buffer growth
+    const Lexeme& last_line = buffer.lexemes[buffer.lexemes.size() -
+                                             LEXEMES_PER_LINE];
+
+    EXPECT_EQ(buffer.get_string(last_line),
+              "value_" + std::to_string(LINE_COUNT - 1));
+    EXPECT_EQ(last_line.line, LINE_COUNT - 1);
+    EXPECT_EQ(last_line.column, 0u);
+}
+
+// Timing run over a multi-megabyte script, run it with
+// --gtest_also_run_disabled_tests --gtest_filter=Lexer.DISABLED_Benchmark
+TEST(Lexer, DISABLED_Benchmark) {
+    static const size_t LEXEMES_PER_LINE = 20;
+    static const size_t LINE_COUNT = 1 << 16;
+
+    std::string script{};
+    char line[256] = "";
+
+    for (size_t id = 0; id < LINE_COUNT; ++id) {
+        snprintf(line, sizeof(line),
+                 "value_%zu = (@Component_%zu.channel + 2.5) * sin(value) <= "
+                 "10 ? \"text\" : other  # comment\n",
+                 id, id);
+        script += line;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    LexemeBuffer buffer = lexify(script);
+
+    auto end = std::chrono::steady_clock::now();
+
+    ASSERT_EQ(buffer.lexemes.size(), LINE_COUNT * LEXEMES_PER_LINE);
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double megabytes = (double)script.size() / (1024.0 * 1024.0);
+
+    printf("Lexed %.2lf MB (%zu lexemes) in %.2lf ms, %.1lf MB/s\n",
+           megabytes, buffer.lexemes.size(), seconds * 1000.0,
+           megabytes / seconds);
+}
@@ -0,0 +1,291 @@
+/**
+ * @file programs.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Compiled script tests
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <unistd.h>
+
+#include <fstream>
+#include <map>
+#include <set>
+
+#include "logics/blueprints/scripts/native.h"
+#include "logics/blueprints/scripts/program.h"
+#include "logics/blueprints/scripts/profile.h"
+#include "logics/blueprints/scripts/script_cache.h"
+#include "logics/scene.h"
+#include "logics/scene_component.h"
+
+struct ScriptProbe : public SceneComponent {
+    ScriptProbe()
+        : input_([this](const ScriptValue& value) {
+              received.push_back(value);
+          }) {
+        use_channels(CHANNELS);
+    }
+
+    Channel output{};
+    std::vector<ScriptValue> received{};
+
+   private:
+    static const ChannelTable CHANNELS;
+
+    InputChannel input_;
+};
+
+inline const SceneComponent::ChannelTable ScriptProbe::CHANNELS =
+    ChannelTable()
+        .input<&ScriptProbe::input_>("in")
+        .output<&ScriptProbe::output>("out");
+
+static const char* PROBE_SCRIPT = R"(
+x = @Probe.out
+@Probe::in <- x * 2 + 1
+@Probe::in <- x > 2 ? "big" : "small"
+@Probe::in <- {x}
+)";
+
+// Its native version is generated into the native_probe.hpp test asset
+static const char* NATIVE_PROBE_SCRIPT = R"(
+x = @Probe.out
+@Probe::in <- x * 3 - 2
+@Probe::in <- x < 2 ? "low" : "high"
+@Probe::in <- {x}
+)";
+
+#include "../assets/scripts/native_probe.hpp"
+
+static std::vector<ScriptValue> run_probe_script(bool compiled) {
+    Scene scene(16.0, 16.0, 4.0);
+
+    Subcomponent<ScriptProbe> probe;
+    scene.add_component(probe);
+
+    Script script(PROBE_SCRIPT);
+    script.set_compiled(compiled);
+    script.assemble(scene, {{"Probe", probe}});
+
+    EXPECT_EQ(script.get_program() != nullptr, compiled);
+
+    probe->output.trigger(3);
+    probe->output.trigger(3);
+    probe->output.trigger(1);
+
+    return probe->received;
+}
+
+static std::multiset<std::string> to_strings(
+    const std::vector<ScriptValue>& values) {
+    std::multiset<std::string> result;
+
+    for (const ScriptValue& value : values) result.insert(value.as_string());
+
+    return result;
+}
+
+TEST(ScriptPrograms, MatchesTree) {
+    std::vector<ScriptValue> tree = run_probe_script(false);
+    std::vector<ScriptValue> program = run_probe_script(true);
+
+    // Programs update the dependents of a node in the order of subscription
+    std::vector<ScriptValue> expected = {
+        7, "big", 3,    // First update
+        7, "big",       // Same value, `{x}` is suppressed
+        3, "small", 1,  // New value
+    };
+
+    EXPECT_EQ(program, expected);
+
+    // Trees do not define the order of dependents
+    EXPECT_EQ(to_strings(tree), to_strings(program));
+}
+
+TEST(ScriptPrograms, BatchedDiamond) {
+    Scene scene(16.0, 16.0, 4.0);
+
+    Subcomponent<ScriptProbe> probe;
+    scene.add_component(probe);
+
+    // Both sides of the sum depend on the same channel
+    Script script("@Probe::in <- @Probe.out + @Probe.out * 2");
+    script.set_batched(true);
+    script.assemble(scene, {{"Probe", probe}});
+
+    probe->output.trigger(1);
+    EXPECT_TRUE(probe->received.empty());
+
+    script.flush();
+    EXPECT_EQ(probe->received, std::vector<ScriptValue>({3}));
+
+    // Only the last value of the batch is evaluated
+    probe->output.trigger(2);
+    probe->output.trigger(5);
+    script.flush();
+    EXPECT_EQ(probe->received, std::vector<ScriptValue>({3, 15}));
+
+    script.flush();
+    EXPECT_EQ(probe->received.size(), 2);
+}
+
+TEST(ScriptPrograms, CachedImage) {
+    ScriptCache::set_directory(testing::TempDir() + "script_cache_" +
+                               std::to_string(getpid()));
+
+    std::shared_ptr<const ScriptImage> parsed = ScriptCache::get(PROBE_SCRIPT);
+    std::shared_ptr<const ScriptImage> mapped = ScriptCache::get(PROBE_SCRIPT);
+
+    EXPECT_FALSE(parsed->is_mapped());
+    EXPECT_TRUE(mapped->is_mapped());
+    EXPECT_EQ(parsed->get_node_count(), mapped->get_node_count());
+
+    // Scripts created from the cache resolve the names on assembly
+    std::vector<ScriptValue> expected = {7, "big", 3, 7, "big", 3, "small", 1};
+    EXPECT_EQ(run_probe_script(true), expected);
+    EXPECT_EQ(to_strings(run_probe_script(false)), to_strings(expected));
+
+    ScriptCache::set_directory("");
+}
+
+TEST(ScriptPrograms, Optimization) {
+    static const char* SCRIPT = R"(
+@Probe::in <- "3" * 2 + 1
+@Probe::in <- @Probe.out + @Probe.out
+)";
+
+    // The constant expression is folded, and the component, the channel names
+    // and the output subscription are shared between the pipes
+    EXPECT_EQ(ScriptCache::get(SCRIPT)->get_node_count(), 8);
+
+    for (bool compiled : {false, true}) {
+        Scene scene(16.0, 16.0, 4.0);
+
+        Subcomponent<ScriptProbe> probe;
+        scene.add_component(probe);
+
+        Script script(SCRIPT);
+        script.set_compiled(compiled);
+        script.assemble(scene, {{"Probe", probe}});
+
+        probe->output.trigger(4);
+
+        EXPECT_EQ(probe->received, std::vector<ScriptValue>({7, 8}));
+    }
+}
+
+TEST(ScriptPrograms, Profile) {
+    for (bool compiled : {false, true}) {
+        Scene scene(16.0, 16.0, 4.0);
+
+        Subcomponent<ScriptProbe> probe;
+        scene.add_component(probe);
+
+        Script script(PROBE_SCRIPT);
+        script.set_compiled(compiled);
+        script.set_profiled(true);
+        script.assemble(scene, {{"Probe", probe}});
+
+        probe->output.trigger(3);
+        probe->output.trigger(1);
+
+        const ScriptProfile* profile = script.get_profile();
+        ASSERT_NE(profile, nullptr);
+
+        // Pipes of the script start at the lines 2-4 (lines are zero-based)
+        std::vector<ScriptProfile::RuleEntry> rules = profile->get_rules();
+        ASSERT_EQ(rules.size(), 3);
+
+        std::set<uint32_t> lines{};
+
+        for (const ScriptProfile::RuleEntry& rule : rules) {
+            lines.insert(rule.line);
+
+            EXPECT_EQ(rule.column, 0u);
+            EXPECT_GT(rule.stats.updates, 0u);
+            EXPECT_GT(rule.stats.triggers, 0u);
+        }
+
+        EXPECT_EQ(lines, std::set<uint32_t>({2, 3, 4}));
+        EXPECT_NE(profile->format().find("line 3, column 0: "),
+                  std::string::npos);
+
+        // Nodes are located by their own lexemes
+        std::map<ScriptOpcode, std::pair<uint32_t, uint32_t>> locations{};
+
+        for (const ScriptProfile::NodeEntry& node : profile->get_nodes()) {
+            locations.insert({node.opcode, {node.line, node.column}});
+        }
+
+        using Location = std::pair<uint32_t, uint32_t>;
+
+        EXPECT_EQ(locations[ScriptOpcode::MULTIPLY], Location(2, 16));
+        EXPECT_EQ(locations[ScriptOpcode::ADD], Location(2, 20));
+        EXPECT_EQ(locations[ScriptOpcode::CONDITIONAL], Location(3, 20));
+        EXPECT_NE(profile->format().find("line 2, column 16: "),
+                  std::string::npos);
+    }
+}
+
+TEST(ScriptPrograms, Native) {
+    EXPECT_EQ(NativeScript::find(PROBE_SCRIPT), nullptr);
+    EXPECT_NE(NativeScript::find(NATIVE_PROBE_SCRIPT), nullptr);
+
+    std::vector<ScriptValue> results[2] = {};
+
+    for (bool native : {false, true}) {
+        NativeScript::set_enabled(native);
+
+        Scene scene(16.0, 16.0, 4.0);
+
+        Subcomponent<ScriptProbe> probe;
+        scene.add_component(probe);
+
+        // Native scripts replace the compiled programs only
+        Script interpreted(NATIVE_PROBE_SCRIPT);
+        interpreted.assemble(scene, {});
+        EXPECT_FALSE(interpreted.is_native());
+
+        Script script(NATIVE_PROBE_SCRIPT);
+        script.set_compiled(true);
+        script.assemble(scene, {{"Probe", probe}});
+
+        EXPECT_EQ(script.is_native(), native);
+
+        probe->output.trigger(3);
+        probe->output.trigger(3);
+        probe->output.trigger(1);
+
+        results[native] = probe->received;
+    }
+
+    NativeScript::set_enabled(true);
+
+    EXPECT_EQ(results[false], results[true]);
+    EXPECT_EQ(to_strings(results[true]),
+              to_strings(std::vector<ScriptValue>(
+                  {7, "high", 3, 7, "high", 1, "low", 1})));
+}
+
+TEST(ScriptPrograms, NativeSnapshot) {
+    static const char* PATH = "assets/scripts/native_probe.hpp";
+
+    std::ifstream stream(PATH);
+    ASSERT_TRUE(stream.good()) << PATH;
+
+    std::string snapshot(std::istreambuf_iterator<char>{stream}, {});
+
+    // The generated code follows the note on how to regenerate it
+    size_t start = snapshot.find("// Native level scripts");
+    ASSERT_NE(start, std::string::npos);
+
+    std::string generated = generate_native_scripts(
+        {{"gtest/scripts/programs.hpp", NATIVE_PROBE_SCRIPT}});
+
+    EXPECT_EQ(snapshot.substr(start), generated)
+        << "Regenerate " << PATH << " from NATIVE_PROBE_SCRIPT";
+}
@@ -0,0 +1,220 @@
+/**
+ * @file profiler.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Zone profiler tests
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "time/profiler.h"
+
+struct ProfiledZone {
+    std::string name;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    unsigned thread_id = 0;
+};
+
+static std::vector<ProfiledZone> collect_zones() {
+    std::vector<Profiler::Zone> zones;
+    std::vector<unsigned> thread_ids;
+
+    Profiler::collect(zones, thread_ids);
+
+    std::vector<ProfiledZone> result;
+
+    for (size_t id = 0; id < zones.size(); ++id) {
+        result.push_back(
+            {zones[id].name, zones[id].begin, zones[id].end, thread_ids[id]});
+    }
+
+    return result;
+}
+
+static const ProfiledZone* find_zone(const std::vector<ProfiledZone>& zones,
+                                     const char* name) {
+    for (const ProfiledZone& zone : zones) {
+        if (zone.name == name) return &zone;
+    }
+
+    return nullptr;
+}
+
+TEST(Profiler, Nesting) {
+    Profiler::set_enabled(true);
+    Profiler::clear();
+
+    {
+        Profiler::ScopedZone outer("outer");
+
+        for (unsigned id = 0; id < 3; ++id) {
+            Profiler::ScopedZone inner("inner");
+        }
+    }
+
+    std::vector<ProfiledZone> zones = collect_zones();
+    ASSERT_EQ(zones.size(), 4);
+
+    // Zones are recorded as they end, so the outer one goes last
+    const ProfiledZone& outer = zones.back();
+    EXPECT_EQ(outer.name, "outer");
+
+    for (size_t id = 0; id < 3; ++id) {
+        EXPECT_EQ(zones[id].name, "inner");
+        EXPECT_EQ(zones[id].thread_id, outer.thread_id);
+
+        EXPECT_LE(outer.begin, zones[id].begin);
+        EXPECT_LE(zones[id].begin, zones[id].end);
+        EXPECT_LE(zones[id].end, outer.end);
+
+        if (id > 0) {
+            EXPECT_LE(zones[id - 1].end, zones[id].begin);
+        }
+    }
+
+    Profiler::clear();
+    EXPECT_TRUE(collect_zones().empty());
+
+    Profiler::set_enabled(false);
+}
+
+TEST(Profiler, Threads) {
+    Profiler::set_enabled(true);
+    Profiler::clear();
+
+    { Profiler::ScopedZone zone("main"); }
+
+    std::thread worker([]() {
+        for (unsigned id = 0; id < 2; ++id) {
+            Profiler::ScopedZone zone("worker");
+        }
+    });
+    worker.join();
+
+    std::vector<ProfiledZone> zones = collect_zones();
+    ASSERT_EQ(zones.size(), 3);
+
+    const ProfiledZone* main_zone = find_zone(zones, "main");
+    ASSERT_NE(main_zone, nullptr);
+
+    unsigned worker_zones = 0;
+
+    for (const ProfiledZone& zone : zones) {
+        if (zone.name != "worker") continue;
+
+        EXPECT_NE(zone.thread_id, main_zone->thread_id);
+        ++worker_zones;
+    }
+
+    EXPECT_EQ(worker_zones, 2);
+
+    Profiler::clear();
+    Profiler::set_enabled(false);
+}
+
+TEST(Profiler, ChromeTrace) {
+    static const char* PATH = "profiler_test.json";
+
+    Profiler::set_enabled(true);
+    Profiler::clear();
+
+    {
+        Profiler::ScopedZone outer("outer");
+        Profiler::ScopedZone inner("inner");
+    }
+
+    ASSERT_TRUE(Profiler::dump_chrome_trace(PATH));
+
+    std::ifstream stream(PATH);
+    std::string line;
+
+    ASSERT_TRUE(std::getline(stream, line));
+    EXPECT_EQ(line, "{\"traceEvents\":[");
+
+    struct Event {
+        char name[32] = "";
+        double start = 0.0, duration = 0.0;
+        unsigned thread_id = 0;
+    };
+
+    std::vector<Event> events;
+
+    while (std::getline(stream, line) && line[0] == '{') {
+        Event event;
+
+        int parsed = sscanf(line.c_str(),
+                            "{\"name\":\"%31[^\"]\",\"ph\":\"X\",\"ts\":%lf,"
+                            "\"dur\":%lf,\"pid\":0,\"tid\":%u}",
+                            event.name, &event.start, &event.duration,
+                            &event.thread_id);
+
+        EXPECT_EQ(parsed, 4) << line;
+        events.push_back(event);
+    }
+
+    EXPECT_EQ(line, "],\"displayTimeUnit\":\"ms\"}");
+    EXPECT_FALSE(std::getline(stream, line));
+
+    ASSERT_EQ(events.size(), 2);
+
+    const Event& inner = events[0];
+    const Event& outer = events[1];
+
+    EXPECT_STREQ(inner.name, "inner");
+    EXPECT_STREQ(outer.name, "outer");
+    EXPECT_EQ(inner.thread_id, outer.thread_id);
+
+    // Timestamps are relative to the earliest zone
+    EXPECT_DOUBLE_EQ(outer.start, 0.0);
+    EXPECT_GE(inner.start, outer.start);
+    EXPECT_LE(inner.start + inner.duration,
+              outer.start + outer.duration + 1e-3);
+
+    remove(PATH);
+    Profiler::clear();
+    Profiler::set_enabled(false);
+}
+
+TEST(Profiler, Disabled) {
+    // Zones are only recorded once the profiler is enabled
+    ASSERT_FALSE(Profiler::is_enabled());
+
+    Profiler::clear();
+
+    { Profiler::ScopedZone zone("disabled"); }
+
+    EXPECT_TRUE(collect_zones().empty());
+}
+
+TEST(Profiler, EscapedNames) {
+    static const char* PATH = "profiler_escape_test.json";
+
+    Profiler::set_enabled(true);
+    Profiler::clear();
+
+    { Profiler::ScopedZone zone("quote\" and \\ backslash"); }
+
+    ASSERT_TRUE(Profiler::dump_chrome_trace(PATH));
+
+    std::ifstream stream(PATH);
+    std::string trace(std::istreambuf_iterator<char>{stream}, {});
+
+    EXPECT_NE(trace.find("{\"name\":\"quote\\\" and \\\\ backslash\","),
+              std::string::npos)
+        << trace;
+
+    remove(PATH);
+    Profiler::clear();
+    Profiler::set_enabled(false);
+}
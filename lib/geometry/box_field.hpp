@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "logger/logger.h"
+#include "logger/metrics.h"
 #include "math_extensions.h"
 #include "primitives.h"
 
@@ -153,6 +154,9 @@ inline void BoxField<T>::unregister(const T& object) {
 template <class T>
 inline std::set<T> BoxField<T>::
     find_intersecting(const Box& box, IntersectionType intersection) const {
+    static Counter& queries = Metrics::get_counter("box_field_queries");
+    queries.add();
+
     std::set<T> result;
 
     for_cell_in_box(box, [&, this](const Container& container) {
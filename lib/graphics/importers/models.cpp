@@ -6,6 +6,7 @@
 #include <assimp/Importer.hpp>
 
 #include "graphics/objects/complex_model.h"
+#include "graphics/primitives/baked_mesh.h"
 #include "logger/logger.h"
 #include "managers/importer.h"
 
@@ -22,10 +23,12 @@ IMPORTER(Model, "fbx") { return load_simple(path.c_str()); }
 IMPORTER(Model, "glb") { return load_simple(path.c_str()); }
 IMPORTER(Model, "gltf") { return load_simple(path.c_str()); }
 
-IMPORTER(Mesh, "obj") { return new Asset<Mesh>(path.c_str()); }
-IMPORTER(Mesh, "fbx") { return new Asset<Mesh>(path.c_str()); }
-IMPORTER(Mesh, "glb") { return new Asset<Mesh>(path.c_str()); }
-IMPORTER(Mesh, "gltf") { return new Asset<Mesh>(path.c_str()); }
+static AssetManager::Upload decode_mesh(const std::string& path);
+
+ASYNC_IMPORTER(Mesh, "obj") { return decode_mesh(path); }
+ASYNC_IMPORTER(Mesh, "fbx") { return decode_mesh(path); }
+ASYNC_IMPORTER(Mesh, "glb") { return decode_mesh(path); }
+ASYNC_IMPORTER(Mesh, "gltf") { return decode_mesh(path); }
 
 XML_BASED_IMPORTER(Model, "model") {
     const tinyxml2::XMLElement* mesh_xml = data.FirstChildElement("mesh");
@@ -75,6 +78,29 @@ XML_BASED_IMPORTER(Model, "model") {
     return new Asset<Model>(*mesh, *material);
 }
 
+static AssetManager::Upload decode_mesh(const std::string& path) {
+    std::shared_ptr<const BakedMesh> baked = BakedMesh::load(path.c_str());
+
+    if (baked) {
+        return [baked]() { return new Asset<Mesh>(*baked); };
+    }
+
+    std::vector<Vertex> vertices{};
+    std::vector<unsigned> indices{};
+
+    // Unreadable files produce empty meshes, as `Mesh::load` does
+    if (!Mesh::read(path.c_str(), vertices, indices)) {
+        return []() { return new Asset<Mesh>(); };
+    }
+
+    BakedMesh::save(path.c_str(), vertices, indices);
+
+    return [vertices = std::move(vertices),
+            indices = std::move(indices)]() mutable {
+        return new Asset<Mesh>(std::move(vertices), std::move(indices));
+    };
+}
+
 static Asset<ComplexModel>* load_complex(const char* path) {
     ComplexModel model;
 
@@ -93,6 +119,8 @@ static Asset<ComplexModel>* load_complex(const char* path) {
 
     aiMesh** meshes = scene->mMeshes;
 
+    std::vector<Asset<Mesh>*> part_meshes{};
+
     for (size_t mesh_id = 0; mesh_id < scene->mNumMeshes; ++mesh_id) {
         aiMesh* mesh = meshes[mesh_id];
 
@@ -114,18 +142,26 @@ static Asset<ComplexModel>* load_complex(const char* path) {
                        material_name.C_Str(), mesh_name, path);
         }
 
-        Asset<Mesh>* part_mesh = new Asset<Mesh>(*mesh);
-
-        AssetManager::register_rogue(part_mesh);
+        Asset<Mesh>* part_mesh =
+            MainThread::call([mesh]() { return new Asset<Mesh>(*mesh); });
+        part_meshes.push_back(part_mesh);
 
         model.add_part(Model(part_mesh->content, *material), mesh_name);
     }
 
-    return new Asset<ComplexModel>(std::move(model));
+    Asset<ComplexModel>* asset = new Asset<ComplexModel>(std::move(model));
+
+    // Part meshes are unloaded along with the model
+    for (Asset<Mesh>* part_mesh : part_meshes) {
+        asset->adopt(part_mesh);
+    }
+
+    return asset;
 }
 
 static Asset<Model>* load_simple(const char* path) {
-    static Assimp::Importer import;
+    // Importers are reused, but can not be shared between threads
+    static thread_local Assimp::Importer import;
 
     const aiScene* scene = import.ReadFile(
         path, aiProcess_Triangulate | aiProcess_FlipUVs |
@@ -161,11 +197,13 @@ static Asset<Model>* load_simple(const char* path) {
                        material_name, mesh_name, path);
         }
 
-        Asset<Mesh>* part_mesh = new Asset<Mesh>(*mesh);
+        Asset<Mesh>* part_mesh =
+            MainThread::call([mesh]() { return new Asset<Mesh>(*mesh); });
 
-        AssetManager::register_rogue(part_mesh);
+        Asset<Model>* asset = new Asset<Model>(part_mesh->content, *material);
+        asset->adopt(part_mesh);
 
-        return new Asset<Model>(part_mesh->content, *material);
+        return asset;
     }
 
     log_printf(
@@ -36,5 +36,6 @@ XML_BASED_IMPORTER(Shader, "shader") {
         return nullptr;
     }
 
-    return new Asset<Shader>(vsh_name, fsh_name);
+    return MainThread::call(
+        [=]() { return new Asset<Shader>(vsh_name, fsh_name); });
 }
@@ -1,3 +1,4 @@
+#include <stb_image.h>
 #include <tinyxml2.h>
 
 #include <glm/mat2x2.hpp>
@@ -6,14 +7,46 @@
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <memory>
 
 #include "graphics/primitives/texture.h"
 #include "logger/logger.h"
 #include "managers/importer.h"
 
-IMPORTER(Texture, "png") { return new Asset<Texture>(path.c_str()); }
-IMPORTER(Texture, "jpg") { return new Asset<Texture>(path.c_str()); }
-IMPORTER(Texture, "bmp") { return new Asset<Texture>(path.c_str()); }
+static AssetManager::Upload decode_texture(const std::string& path) {
+    int channel_count = 0;
+    int width = 0, height = 0;
+
+    std::shared_ptr<unsigned char> data(
+        stbi_load(path.c_str(), &width, &height, &channel_count, 0),
+        stbi_image_free);
+
+    if (!data) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Failed to load image form file %s\n", path.c_str());
+        return {};
+    }
+
+    GLint int_format = GL_RGB;
+    GLenum format = GL_RGB;
+
+    if (!Texture::get_image_formats(channel_count, int_format, format)) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Image %s contains %d channels. 1 to 4 expected.\n",
+                   path.c_str(), channel_count);
+        return {};
+    }
+
+    // Only the upload is left to the main thread, whatever the layout is
+    return [data, width, height, int_format, format]() {
+        return new Asset<Texture>((unsigned)width, (unsigned)height,
+                                  data.get(), int_format, format);
+    };
+}
+
+ASYNC_IMPORTER(Texture, "png") { return decode_texture(path); }
+ASYNC_IMPORTER(Texture, "jpg") { return decode_texture(path); }
+ASYNC_IMPORTER(Texture, "bmp") { return decode_texture(path); }
 
 void read_wrap(const tinyxml2::XMLElement* element, TextureSettings& settings) {
     if (element == nullptr) return;
@@ -113,14 +146,14 @@ XML_BASED_IMPORTER(Texture, "texture") {
         return nullptr;
     }
 
-    Asset<Texture>* asset = new Asset<Texture>(content_path);
-
     TextureSettings settings = {.wrap = GL_REPEAT, .interp = GL_NEAREST};
 
     read_wrap(data.FirstChildElement("wrap"), settings);
     read_interp(data.FirstChildElement("interp"), settings);
 
-    asset->content.use_settings(settings);
-
-    return asset;
+    return MainThread::call([content_path, settings]() {
+        Asset<Texture>* asset = new Asset<Texture>(content_path);
+        asset->content.use_settings(settings);
+        return asset;
+    });
 }
@@ -4,9 +4,13 @@
 #include "graphics/libs.h"
 #include "graphics/primitives/flat_renderer.h"
 #include "logger/logger.h"
+#include "logger/metrics.h"
 #include "managers/asset_manager.h"
+#include "time/profiler.h"
 
 void RenderManager::render(RenderBundle& bundle) {
+    PROFILE_ZONE("RenderManager::render");
+
     if (viewpoint_ == nullptr) {
         log_printf(WARNINGS, "warning", "Render to an undefined viewpoint\n");
         return;
@@ -21,7 +25,11 @@ void RenderManager::render(RenderBundle& bundle) {
     RenderPass pass = RP_INITIAL;
 
     RenderInput stage_input = (RenderInput){.camera = viewpoint_, .pass = pass};
-    render_everything(bundle, stage_input, false);
+
+    {
+        PROFILE_ZONE("RenderManager::RP_INITIAL");
+        render_everything(bundle, stage_input, false);
+    }
 
     glDisable(GL_DEPTH_TEST);
 
@@ -31,23 +39,37 @@ void RenderManager::render(RenderBundle& bundle) {
     pass = RP_DECAL;
 
     stage_input = (RenderInput){.camera = viewpoint_, .pass = pass};
-    render_everything(bundle, stage_input);
+
+    {
+        PROFILE_ZONE("RenderManager::RP_DECAL");
+        render_everything(bundle, stage_input);
+    }
 
     pass = RP_LIGHT;
 
     stage_input = (RenderInput){.camera = viewpoint_, .pass = pass};
-    render_everything(bundle, stage_input);
+
+    {
+        PROFILE_ZONE("RenderManager::RP_LIGHT");
+        render_everything(bundle, stage_input);
+    }
 
     pass = RP_POSTPROCESSING;
 
     stage_input = (RenderInput){.camera = viewpoint_, .pass = pass};
-    render_everything(bundle, stage_input);
+
+    {
+        PROFILE_ZONE("RenderManager::RP_POSTPROCESSING");
+        render_everything(bundle, stage_input);
+    }
 
     //* Copy the rendered image to the screen
 
     static const Shader& identity_shader =
         *AssetManager::request<Shader>("assets/shaders/RB2SCR.shader.xml");
 
+    PROFILE_ZONE("RenderManager::present");
+
     RenderBundle::reset_to_screen();
 
     identity_shader.use();
@@ -63,7 +85,15 @@ void RenderManager::track_object(const Visual<Renderable>& object) {
 void RenderManager::
     render_everything(RenderBundle& bundle, const RenderInput& input,
                       bool swap_buffers) {
+    static Counter* const DRAW_CALLS[_RP_END] = {
+        &Metrics::get_counter("render_draw_calls{pass=\"initial\"}"),
+        &Metrics::get_counter("render_draw_calls{pass=\"decal\"}"),
+        &Metrics::get_counter("render_draw_calls{pass=\"light\"}"),
+        &Metrics::get_counter("render_draw_calls{pass=\"postprocessing\"}"),
+    };
+
     size_t border = 0;
+    uint64_t draw_calls = 0;
 
     for (size_t id = 0; id < objects_.size(); ++id) {
         if (objects_[id].expired()) continue;
@@ -76,6 +106,8 @@ void RenderManager::
 
         int rendered = object.render(input, bundle);
 
+        if (rendered) ++draw_calls;
+
         if (rendered && swap_buffers) {
             bundle.swap_frames();
             bundle.use();
@@ -83,4 +115,6 @@ void RenderManager::
     }
 
     objects_.resize(border);
+
+    DRAW_CALLS[input.pass]->add(draw_calls);
 }
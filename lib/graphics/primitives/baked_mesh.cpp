@@ -0,0 +1,173 @@
+#include "baked_mesh.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#include "hash/murmur.h"
+#include "io/files.h"
+#include "logger/logger.h"
+#include "logger/metrics.h"
+
+static const uint32_t BAKED_MAGIC = 0x4853454d;  // "MESH"
+static const uint32_t BAKED_VERSION = 1;
+
+// Baked files are keyed by the path, the size and the modification time of the
+// model file rather than by its contents, so that validating them does not
+// require reading the model
+struct BakedHeader {
+    uint32_t magic;
+    uint32_t version;
+
+    uint64_t path_hash;
+    uint64_t source_size;
+    int64_t source_time;
+
+    // Baked files of other vertex layouts are outdated
+    uint32_t vertex_size;
+    uint32_t reserved;
+
+    uint64_t vertex_count;
+    uint64_t index_count;
+};
+
+static size_t get_baked_size(const BakedHeader& header) {
+    return sizeof(BakedHeader) + header.vertex_count * sizeof(Vertex) +
+           header.index_count * sizeof(unsigned);
+}
+
+// Fills the source fields of the header (returns false if the source is
+// missing)
+static bool describe_source(const char* source, BakedHeader& header) {
+    struct stat status = {};
+    if (stat(source, &status) != 0) return false;
+
+    header.magic = BAKED_MAGIC;
+    header.version = BAKED_VERSION;
+    header.path_hash = murmur_hash(source);
+    header.source_size = (uint64_t)status.st_size;
+    header.source_time =
+        status.st_mtim.tv_sec * 1000000000 + status.st_mtim.tv_nsec;
+    header.vertex_size = (uint32_t)sizeof(Vertex);
+
+    return true;
+}
+
+std::string BakedMesh::directory_ = "";
+
+void BakedMesh::set_directory(const std::string& directory) {
+    directory_ = directory;
+}
+
+const std::string& BakedMesh::get_directory() { return directory_; }
+
+BakedMesh::~BakedMesh() {
+    if (mapping_.ptr) {
+        munmap(mapping_.ptr, mapping_.size);
+        close(mapping_.fd);
+    }
+}
+
+std::string BakedMesh::get_path(const char* source) {
+    char name[32] = "";
+    snprintf(name, sizeof(name), "/%016zx.mesh.bin", murmur_hash(source));
+
+    return directory_ + name;
+}
+
+std::shared_ptr<const BakedMesh> BakedMesh::load(const char* source) {
+    static Counter& hits = Metrics::get_counter("baked_mesh_hits");
+    static Counter& misses = Metrics::get_counter("baked_mesh_misses");
+
+    if (directory_.empty()) return nullptr;
+
+    BakedHeader expected{};
+    if (!describe_source(source, expected)) return nullptr;
+
+    std::string path = get_path(source);
+
+    struct stat status = {};
+    if (stat(path.c_str(), &status) != 0) {
+        misses.add();
+        return nullptr;
+    }
+
+    std::shared_ptr<BakedMesh> mesh(new BakedMesh());
+
+    mesh->mapping_ = map_file(path.c_str(), O_RDONLY, PROT_READ, MAP_PRIVATE);
+    if (!mesh->mapping_.ptr) return nullptr;
+
+    const BakedHeader* header = (const BakedHeader*)mesh->mapping_.ptr;
+
+    if (mesh->mapping_.size < sizeof(BakedHeader) ||
+        header->magic != expected.magic ||
+        header->version != expected.version ||
+        header->path_hash != expected.path_hash ||
+        header->source_size != expected.source_size ||
+        header->source_time != expected.source_time ||
+        header->vertex_size != expected.vertex_size ||
+        get_baked_size(*header) != mesh->mapping_.size) {
+        log_printf(STATUS_REPORTS, "status",
+                   "Ignoring outdated baked mesh of \"%s\".\n", source);
+        misses.add();
+        return nullptr;
+    }
+
+    const uint8_t* data = (const uint8_t*)mesh->mapping_.ptr;
+
+    mesh->vertices_ = (const Vertex*)(data + sizeof(BakedHeader));
+    mesh->vertex_count_ = header->vertex_count;
+
+    mesh->indices_ = (const unsigned*)(mesh->vertices_ + mesh->vertex_count_);
+    mesh->index_count_ = header->index_count;
+
+    for (size_t index_id = 0; index_id < mesh->index_count_; ++index_id) {
+        if (mesh->indices_[index_id] < mesh->vertex_count_) continue;
+
+        log_printf(ERROR_REPORTS, "error",
+                   "Baked mesh of \"%s\" is corrupted (index %u out of %lu "
+                   "vertices).\n",
+                   source, mesh->indices_[index_id], mesh->vertex_count_);
+        misses.add();
+        return nullptr;
+    }
+
+    hits.add();
+
+    return mesh;
+}
+
+bool BakedMesh::save(const char* source, const std::vector<Vertex>& vertices,
+                     const std::vector<unsigned>& indices) {
+    if (directory_.empty()) return false;
+
+    BakedHeader header{};
+    if (!describe_source(source, header)) return false;
+
+    header.vertex_count = vertices.size();
+    header.index_count = indices.size();
+
+    std::vector<uint8_t> bytes{};
+    bytes.reserve(get_baked_size(header));
+
+    auto append = [&bytes](const void* data, size_t size) {
+        bytes.insert(bytes.end(), (const uint8_t*)data,
+                     (const uint8_t*)data + size);
+    };
+
+    append(&header, sizeof(header));
+    append(vertices.data(), vertices.size() * sizeof(Vertex));
+    append(indices.data(), indices.size() * sizeof(unsigned));
+
+    std::string path = get_path(source);
+
+    if (!create_directories(directory_) ||
+        !write_file_atomic(path, bytes.data(), bytes.size())) {
+        log_printf(WARNINGS, "warning",
+                   "Failed to write the baked mesh of \"%s\" to \"%s\".\n",
+                   source, path.c_str());
+        return false;
+    }
+
+    return true;
+}
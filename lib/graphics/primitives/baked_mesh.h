@@ -0,0 +1,88 @@
+/**
+ * @file baked_mesh.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Mesh geometry baked into memory-mapped files
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "io/mmap.h"
+#include "vertex.hpp"
+
+/**
+ * @brief Geometry of a model file in the layout of the graphics buffers
+ * (header, `Vertex` array and index array), stored in the bake directory as a
+ * file named by the hash of the model path
+ *
+ * Baked files are keyed by the model path, size and modification time (the
+ * contents of the model are not hashed), so they are outdated once the model
+ * file is moved or its size or modification time changes.
+ */
+struct BakedMesh final {
+    BakedMesh(const BakedMesh&) = delete;
+    BakedMesh& operator=(const BakedMesh&) = delete;
+
+    ~BakedMesh();
+
+    /**
+     * @brief Set the directory of the baked files (the directory is created
+     * when the first mesh is baked, an empty path disables baking)
+     *
+     * @param[in] directory
+     */
+    static void set_directory(const std::string& directory);
+
+    static const std::string& get_directory();
+
+    /**
+     * @brief Map the baked geometry of the model file
+     *
+     * @param[in] source path to the model file
+     * @return std::shared_ptr<const BakedMesh> - `nullptr` if the model has
+     * not been baked or its baked file is outdated
+     */
+    static std::shared_ptr<const BakedMesh> load(const char* source);
+
+    /**
+     * @brief Bake the geometry read from the model file
+     *
+     * @param[in] source path to the model file
+     * @param[in] vertices
+     * @param[in] indices
+     * @return true if the baked file was written
+     */
+    static bool save(const char* source, const std::vector<Vertex>& vertices,
+                     const std::vector<unsigned>& indices);
+
+    const Vertex* get_vertices() const { return vertices_; }
+    size_t get_vertex_count() const { return vertex_count_; }
+
+    const unsigned* get_indices() const { return indices_; }
+    size_t get_index_count() const { return index_count_; }
+
+   private:
+    BakedMesh() = default;
+
+    static std::string get_path(const char* source);
+
+    MmapResult mapping_{};
+
+    const Vertex* vertices_ = nullptr;
+    size_t vertex_count_ = 0;
+
+    const unsigned* indices_ = nullptr;
+    size_t index_count_ = 0;
+
+    static std::string directory_;
+};
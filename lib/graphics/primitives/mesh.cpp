@@ -1,5 +1,6 @@
 #include "mesh.h"
 
+#include <assert.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <stdio.h>
@@ -7,6 +8,7 @@
 #include <assimp/Importer.hpp>
 #include <string>
 
+#include "baked_mesh.h"
 #include "graphics/gl_debug.h"
 #include "logger/logger.h"
 
@@ -49,10 +51,40 @@ Mesh::Mesh(const aiMesh& mesh) {
     synch_buffers();
 }
 
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned> indices)
+    : vertices_(std::move(vertices)), indices_(std::move(indices)) {
+    synch_buffers();
+}
+
+Mesh::Mesh(const BakedMesh& baked) {
+    upload(baked.get_vertices(), baked.get_vertex_count(), baked.get_indices(),
+           baked.get_index_count());
+}
+
 void Mesh::load(const char* path) {
-    static Assimp::Importer import;
+    poll_gl_errors();
+
+    std::shared_ptr<const BakedMesh> baked = BakedMesh::load(path);
+
+    if (baked) {
+        upload(baked->get_vertices(), baked->get_vertex_count(),
+               baked->get_indices(), baked->get_index_count());
+        return;
+    }
+
+    if (!read(path, vertices_, indices_)) return;
+
+    BakedMesh::save(path, vertices_, indices_);
+
+    synch_buffers();
 
     poll_gl_errors();
+}
+
+bool Mesh::read(const char* path, std::vector<Vertex>& vertices,
+                std::vector<unsigned>& indices) {
+    // Importers are reused, but can not be shared between threads
+    static thread_local Assimp::Importer import;
 
     log_printf(STATUS_REPORTS, "status", "Loading model %s\n", path);
 
@@ -63,7 +95,7 @@ void Mesh::load(const char* path) {
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE ||
         !scene->mRootNode) {
         log_printf(ERROR_REPORTS, "error", "Failed to load model %s\n", path);
-        return;
+        return false;
     }
 
     aiMesh** meshes = scene->mMeshes;
@@ -87,7 +119,7 @@ void Mesh::load(const char* path) {
                                 ? mesh->mTextureCoords[0][vrt_id]
                                 : aiVector3D(0.0, 0.0, 0.0);
             aiVector3D tangent = mesh->mTangents[vrt_id];
-            vertices_.push_back((Vertex){
+            vertices.push_back((Vertex){
                 .position = glm::vec3(pos.x, pos.y, pos.z),
                 .normal = glm::vec3(normal.x, normal.y, normal.z),
                 .uv = glm::vec2(uv.x, uv.y),
@@ -97,25 +129,31 @@ void Mesh::load(const char* path) {
         for (size_t face_id = 0; face_id < mesh->mNumFaces; ++face_id) {
             aiFace face = mesh->mFaces[face_id];
             for (unsigned id = 0; id < 3; ++id) {
-                indices_.push_back(face.mIndices[id] + (unsigned)index_shift);
+                indices.push_back(face.mIndices[id] + (unsigned)index_shift);
             }
         }
 
-        index_shift = vertices_.size();
+        index_shift = vertices.size();
     }
 
     log_printf(STATUS_REPORTS, "status",
                "Loading successful, read %lu vertices and %lu indices.\n",
-               vertices_.size(), indices_.size());
-
-    synch_buffers();
+               vertices.size(), indices.size());
 
-    poll_gl_errors();
+    return true;
 }
 
 void Mesh::append(const std::vector<Vertex>& vertices,
                   const std::vector<unsigned>& indices,
                   const glm::mat4 matrix) {
+    // Baked geometry lives only in the graphics buffers
+    if (vertices_.empty() && vertex_count_ > 0) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Can not append to the mesh uploaded from baked geometry\n");
+        assert(false && "Appending to a baked mesh");
+        return;
+    }
+
     poll_gl_errors();
 
     unsigned index_shift = (unsigned)vertices_.size();
@@ -130,6 +168,12 @@ void Mesh::append(const std::vector<Vertex>& vertices,
 }
 
 void Mesh::synch_buffers() {
+    upload(vertices_.data(), vertices_.size(), indices_.data(),
+           indices_.size());
+}
+
+void Mesh::upload(const Vertex* vertices, size_t vertex_count,
+                  const unsigned* indices, size_t index_count) {
     poll_gl_errors();
 
     vao_.bind();
@@ -137,15 +181,18 @@ void Mesh::synch_buffers() {
     poll_gl_errors();
 
     vbo_.bind();
-    vbo_.fill(&vertices_[0], vertices_.size());
+    vbo_.fill(vertices, vertex_count);
     // vbo_.unbind();
 
     poll_gl_errors();
 
     ebo_.bind();
-    ebo_.fill(&indices_[0], indices_.size());
+    ebo_.fill(indices, index_count);
     // ebo_.unbind();
 
+    vertex_count_ = vertex_count;
+    index_count_ = index_count;
+
     poll_gl_errors();
 
     Vertex::configure();
@@ -162,7 +209,16 @@ void Mesh::render(const glm::mat4& proj_matrix, const glm::mat4& obj_matrix,
     ebo_.bind();
     shader.set_uniform_mat4("projection", proj_matrix);
     shader.set_uniform_mat4("obj_tform", obj_matrix);
-    glDrawElements(GL_TRIANGLES, (GLsizei)indices_.size(), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, (GLsizei)index_count_, GL_UNSIGNED_INT, 0);
     vao_.unbind();
     vbo_.unbind();
 }
+
+size_t Mesh::get_cpu_memory() const {
+    return vertices_.capacity() * sizeof(Vertex) +
+           indices_.capacity() * sizeof(unsigned);
+}
+
+size_t Mesh::get_gpu_memory() const {
+    return vertex_count_ * sizeof(Vertex) + index_count_ * sizeof(unsigned);
+}
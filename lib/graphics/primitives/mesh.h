@@ -21,15 +21,45 @@
 #include "vertex.hpp"
 
 struct aiMesh;
+struct BakedMesh;
 
 struct Mesh final {
     Mesh() = default;
     explicit Mesh(const char* path);
     explicit Mesh(const aiMesh& mesh);
+    Mesh(std::vector<Vertex> vertices, std::vector<unsigned> indices);
+
+    /**
+     * @brief Upload the baked geometry directly from its mapping
+     *
+     * @note The geometry is not kept on the CPU side, so the mesh can not be
+     * appended to (`append` reports an error and leaves it intact)
+     *
+     * @param[in] baked
+     */
+    explicit Mesh(const BakedMesh& baked);
 
     Mesh(const Mesh&) = default;
 
+    /**
+     * @brief Load the mesh from the model file, using its baked geometry if
+     * it is up to date (see `BakedMesh`) and baking it otherwise
+     *
+     * @param[in] path
+     */
     void load(const char* path);
+
+    /**
+     * @brief Read the geometry of the model file without touching the
+     * graphics context (safe to call from any thread)
+     *
+     * @param[in] path
+     * @param[out] vertices
+     * @param[out] indices
+     * @return true if the file was read
+     */
+    static bool read(const char* path, std::vector<Vertex>& vertices,
+                     std::vector<unsigned>& indices);
     void append(const std::vector<Vertex>& vertices,
                 const std::vector<unsigned>& indices, const glm::mat4 matrix);
 
@@ -40,9 +70,28 @@ struct Mesh final {
 
     static Mesh parse_ai_mesh(const aiMesh& mesh);
 
+    /**
+     * @brief Get the memory used by the geometry kept on the CPU side
+     *
+     * @return size_t - memory size (in bytes)
+     */
+    size_t get_cpu_memory() const;
+
+    /**
+     * @brief Get the memory used by the vertex and index buffers
+     *
+     * @return size_t - memory size (in bytes)
+     */
+    size_t get_gpu_memory() const;
+
    private:
+    void upload(const Vertex* vertices, size_t vertex_count,
+                const unsigned* indices, size_t index_count);
+
     std::vector<Vertex> vertices_ = {};
     std::vector<unsigned> indices_ = {};
+    size_t vertex_count_ = 0;
+    size_t index_count_ = 0;
     VAO vao_ = VAO();
     VBO vbo_ = VBO();
     EBO ebo_ = EBO();
@@ -19,10 +19,11 @@ Texture::Texture(const char* path) {
         return;
     }
 
-    if (chanel_count != 3) {
+    if (!get_image_formats(chanel_count, int_format_, format_)) {
         log_printf(ERROR_REPORTS, "error",
-                   "Image %s contains %d channels. 3 expected.\n", path,
+                   "Image %s contains %d channels. 1 to 4 expected.\n", path,
                    chanel_count);
+        stbi_image_free(data);
         return;
     }
 
@@ -51,6 +52,30 @@ Texture::Texture(unsigned width, unsigned height, const unsigned char* data,
     poll_gl_errors();
 }
 
+bool Texture::get_image_formats(int channel_count, GLint& int_format,
+                                GLenum& format) {
+    switch (channel_count) {
+        case 1:
+            int_format = GL_R8;
+            format = GL_RED;
+            return true;
+        case 2:
+            int_format = GL_RG8;
+            format = GL_RG;
+            return true;
+        case 3:
+            int_format = GL_RGB;
+            format = GL_RGB;
+            return true;
+        case 4:
+            int_format = GL_RGBA;
+            format = GL_RGBA;
+            return true;
+        default:
+            return false;
+    }
+}
+
 void Texture::bind(unsigned slot) const {
     glActiveTexture(GL_TEXTURE0 + slot);
     glBindTexture(GL_TEXTURE_2D, id_);
@@ -75,6 +100,36 @@ void Texture::use_settings(const TextureSettings& settings) const {
     poll_gl_errors();
 }
 
+size_t Texture::get_gpu_memory() const {
+    size_t texel_size = 4;
+
+    switch (int_format_) {
+        case GL_RED:
+        case GL_R8:
+            texel_size = 1;
+            break;
+        case GL_RG:
+        case GL_RG8:
+            texel_size = 2;
+            break;
+        case GL_RGB:
+        case GL_RGB8:
+            texel_size = 3;
+            break;
+        case GL_RGBA16F:
+            texel_size = 8;
+            break;
+        case GL_RGBA32F:
+            texel_size = 16;
+            break;
+        default:
+            break;
+    }
+
+    // The mipmap chain adds a third of the base level
+    return (size_t)width_ * height_ * texel_size * 4 / 3;
+}
+
 void Texture::load_params(const unsigned char* data) const {
     poll_gl_errors();
 
@@ -83,8 +138,13 @@ void Texture::load_params(const unsigned char* data) const {
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
                     GL_LINEAR_MIPMAP_LINEAR);
+
+    // Rows of decoded images are tightly packed
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glTexImage2D(GL_TEXTURE_2D, 0, int_format_, (GLsizei)width_,
                  (GLsizei)height_, 0, format_, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
     glGenerateMipmap(GL_TEXTURE_2D);
 
     poll_gl_errors();
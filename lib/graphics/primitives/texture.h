@@ -12,6 +12,8 @@
 #ifndef TEXTURE_H
 #define TEXTURE_H
 
+#include <stddef.h>
+
 #include "graphics/libs.h"
 
 struct TextureSettings {
@@ -40,6 +42,25 @@ struct Texture {
 
     void use_settings(const TextureSettings& settings) const;
 
+    /**
+     * @brief Get the formats of a texture holding an 8-bit image
+     *
+     * @param[in] channel_count number of channels of the image (1 to 4)
+     * @param[out] int_format internal format of the texture
+     * @param[out] format format of the image data
+     * @return true if the channel count is supported
+     * @return false otherwise
+     */
+    static bool get_image_formats(int channel_count, GLint& int_format,
+                                  GLenum& format);
+
+    /**
+     * @brief Estimate the video memory used by the texture and its mipmaps
+     *
+     * @return size_t - memory size (in bytes)
+     */
+    size_t get_gpu_memory() const;
+
    protected:
     void load_params(const unsigned char* data = nullptr) const;
 
@@ -12,4 +12,26 @@
 #ifndef __LIB_HASH_CT_HASH_HPP
 #define __LIB_HASH_CT_HASH_HPP
 
+#include <inttypes.h>
+
+#include <string_view>
+
+/**
+ * @brief FNV-1a hash of the string, usable both in constant expressions and at
+ * runtime (both give the same result)
+ *
+ * @param[in] string
+ * @return uint64_t
+ */
+constexpr uint64_t ct_hash(std::string_view string) {
+    uint64_t hash = 0xcbf29ce484222325;
+
+    for (char symbol : string) {
+        hash ^= (uint8_t)symbol;
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
 #endif /* __LIB_HASH_CT_HASH_HPP */
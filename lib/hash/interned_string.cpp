@@ -0,0 +1,72 @@
+#include "interned_string.h"
+
+#include <mutex>
+#include <unordered_map>
+
+struct InternedStringTable {
+    std::mutex mutex{};
+
+    // Keys refer to the strings of the entries
+    std::unordered_map<std::string_view, InternedString::Entry*> entries{};
+};
+
+// The table is never destroyed, as static strings can outlive it otherwise
+static InternedStringTable& get_table() {
+    static InternedStringTable* table = new InternedStringTable();
+    return *table;
+}
+
+static const InternedString& get_empty() {
+    static const InternedString* empty = new InternedString(std::string_view());
+    return *empty;
+}
+
+InternedString::InternedString() : InternedString(get_empty()) {}
+
+InternedString::InternedString(std::string_view string) : entry_(nullptr) {
+    InternedStringTable& table = get_table();
+
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto found = table.entries.find(string);
+
+    if (found != table.entries.end()) {
+        entry_ = found->second;
+        retain();
+        return;
+    }
+
+    entry_ = new Entry(string);
+    table.entries.emplace(entry_->string, entry_);
+}
+
+void InternedString::release() {
+    uint32_t references = entry_->references.load(std::memory_order_relaxed);
+
+    // Only the last reference is dropped under the lock, so that the entry
+    // cannot be found in the table while it is being removed
+    while (references > 1) {
+        if (entry_->references.compare_exchange_weak(
+                references, references - 1, std::memory_order_release,
+                std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    InternedStringTable& table = get_table();
+
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    if (entry_->references.fetch_sub(1, std::memory_order_acq_rel) > 1) return;
+
+    table.entries.erase(entry_->string);
+    delete entry_;
+}
+
+size_t InternedString::get_table_size() {
+    InternedStringTable& table = get_table();
+
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    return table.entries.size();
+}
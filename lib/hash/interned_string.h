@@ -0,0 +1,107 @@
+/**
+ * @file interned_string.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Interned strings
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Immutable string stored once in a global table, which makes
+ * comparisons as cheap as those of a pointer
+ *
+ * @note Interning is thread-safe. Strings are reference-counted and removed
+ * from the table once the last `InternedString` referring to them is
+ * destroyed (the empty string is never removed).
+ */
+struct InternedString final {
+    InternedString();
+    explicit InternedString(std::string_view string);
+
+    InternedString(const InternedString& other) : entry_(other.entry_) {
+        retain();
+    }
+
+    InternedString& operator=(const InternedString& other) {
+        if (entry_ == other.entry_) return *this;
+
+        release();
+        entry_ = other.entry_;
+        retain();
+
+        return *this;
+    }
+
+    ~InternedString() { release(); }
+
+    const std::string& str() const { return entry_->string; }
+    const char* c_str() const { return entry_->string.c_str(); }
+
+    size_t length() const { return entry_->string.length(); }
+    bool empty() const { return entry_->string.empty(); }
+
+    /**
+     * @brief Get the number of strings currently in the table
+     *
+     * @return size_t
+     */
+    static size_t get_table_size();
+
+    friend bool operator==(const InternedString& alpha,
+                           const InternedString& beta) {
+        return alpha.entry_ == beta.entry_;
+    }
+
+    friend bool operator!=(const InternedString& alpha,
+                           const InternedString& beta) {
+        return alpha.entry_ != beta.entry_;
+    }
+
+    /**
+     * @brief Order of the interned strings (not lexicographic, but stable
+     * while the strings are alive)
+     *
+     */
+    friend bool operator<(const InternedString& alpha,
+                          const InternedString& beta) {
+        return std::less<const Entry*>()(alpha.entry_, beta.entry_);
+    }
+
+   private:
+    friend struct InternedStringTable;
+
+    struct Entry {
+        explicit Entry(std::string_view value) : string(value) {}
+
+        const std::string string;
+        std::atomic<uint32_t> references = 1;
+    };
+
+    void retain() const {
+        entry_->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release();
+
+    Entry* entry_;
+};
+
+template <>
+struct std::hash<InternedString> {
+    size_t operator()(const InternedString& string) const {
+        return std::hash<const char*>()(string.c_str());
+    }
+};
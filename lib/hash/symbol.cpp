@@ -0,0 +1,51 @@
+#include "symbol.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+struct SymbolTable {
+    SymbolTable() {
+        names.emplace_back();
+        ids.insert({ct_hash(""), 0});
+    }
+
+    std::mutex mutex{};
+
+    // Elements of deques never move when new elements are appended
+    std::deque<std::string> names{};
+    std::unordered_multimap<uint64_t, uint32_t> ids{};
+};
+
+static SymbolTable& get_table() {
+    static SymbolTable table;
+    return table;
+}
+
+Symbol::Symbol(std::string_view name, uint64_t hash) {
+    SymbolTable& table = get_table();
+
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto [begin, end] = table.ids.equal_range(hash);
+
+    for (auto iterator = begin; iterator != end; ++iterator) {
+        if (table.names[iterator->second] == name) {
+            id_ = iterator->second;
+            return;
+        }
+    }
+
+    id_ = (uint32_t)table.names.size();
+
+    table.names.emplace_back(name);
+    table.ids.insert({hash, id_});
+}
+
+const std::string& Symbol::get_name() const {
+    SymbolTable& table = get_table();
+
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    return table.names[id_];
+}
@@ -0,0 +1,79 @@
+/**
+ * @file symbol.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Interned names with integer identifiers
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include <string>
+#include <string_view>
+
+#include "ct_hash.hpp"
+
+/**
+ * @brief Name known at compile time, hashed during compilation
+ *
+ */
+struct StaticName final {
+    template <size_t N>
+    consteval StaticName(const char (&string)[N])
+        : name(string, N - 1), hash(ct_hash(std::string_view(string, N - 1))) {}
+
+    std::string_view name;
+    uint64_t hash;
+};
+
+/**
+ * @brief Name registered in a global symbol table, identified by a small
+ * integer, so that symbols are compared and looked up as integers
+ *
+ * @note Registration is thread-safe. Symbols are never freed.
+ */
+struct Symbol final {
+    // The empty name
+    Symbol() = default;
+
+    explicit Symbol(std::string_view name) : Symbol(name, ct_hash(name)) {}
+    Symbol(StaticName name) : Symbol(name.name, name.hash) {}
+
+    /**
+     * @brief Find or register the symbol
+     *
+     * @param[in] name
+     * @param[in] hash `ct_hash` of the name
+     */
+    Symbol(std::string_view name, uint64_t hash);
+
+    uint32_t get_id() const { return id_; }
+
+    /**
+     * @brief Get the name of the symbol
+     *
+     * @return const std::string&
+     */
+    const std::string& get_name() const;
+
+    friend bool operator==(Symbol alpha, Symbol beta) {
+        return alpha.id_ == beta.id_;
+    }
+
+    friend bool operator!=(Symbol alpha, Symbol beta) {
+        return alpha.id_ != beta.id_;
+    }
+
+    friend bool operator<(Symbol alpha, Symbol beta) {
+        return alpha.id_ < beta.id_;
+    }
+
+   private:
+    uint32_t id_ = 0;
+};
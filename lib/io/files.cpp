@@ -0,0 +1,42 @@
+#include "files.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sstream>
+#include <thread>
+
+bool create_directories(const std::string& path) {
+    for (size_t end = path.find('/', 1);; end = path.find('/', end + 1)) {
+        std::string prefix = path.substr(0, end);
+
+        if (mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST) return false;
+
+        if (end == std::string::npos) return true;
+    }
+}
+
+bool write_file_atomic(const std::string& path, const void* data,
+                       size_t size) {
+    // Threads of the same process may write the same file as well
+    std::ostringstream temporary;
+    temporary << path << "." << getpid() << "." << std::this_thread::get_id()
+              << ".tmp";
+
+    std::string name = temporary.str();
+
+    FILE* file = fopen(name.c_str(), "wb");
+    if (!file) return false;
+
+    bool written = fwrite(data, 1, size, file) == size;
+    written = fclose(file) == 0 && written;
+
+    if (!written || rename(name.c_str(), path.c_str()) != 0) {
+        remove(name.c_str());
+        return false;
+    }
+
+    return true;
+}
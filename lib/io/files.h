@@ -0,0 +1,33 @@
+/**
+ * @file files.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief File system helpers
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @brief Create the directory along with its missing parents
+ *
+ * @param[in] path
+ * @return true if the directory exists
+ */
+bool create_directories(const std::string& path);
+
+/**
+ * @brief Write the file under a temporary name and rename it, so that other
+ * processes never map partially written files
+ *
+ * @param[in] path
+ * @param[in] data
+ * @param[in] size
+ * @return true if the file was written
+ */
+bool write_file_atomic(const std::string& path, const void* data, size_t size);
@@ -0,0 +1,218 @@
+#include "metrics.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "logger.h"
+#include "time/world_timer.h"
+
+uint64_t Counter::get() const {
+    uint64_t sum = 0;
+
+    for (const Slot& slot : slots_) {
+        sum += slot.value.load(std::memory_order_relaxed);
+    }
+
+    return sum;
+}
+
+size_t Counter::get_thread_slot() {
+    static std::atomic<size_t> thread_count = 0;
+
+    thread_local size_t slot = thread_count.fetch_add(1) % SLOT_COUNT;
+
+    return slot;
+}
+
+Histogram::Histogram(const std::vector<double>& bounds)
+    : bounds_(bounds),
+      buckets_(new std::atomic<uint64_t>[bounds.size() + 1]) {
+    std::sort(bounds_.begin(), bounds_.end());
+
+    for (size_t id = 0; id <= bounds_.size(); ++id) buckets_[id] = 0;
+}
+
+void Histogram::record(double value) {
+    size_t bucket = (size_t)(std::lower_bound(bounds_.begin(), bounds_.end(),
+                                              value) -
+                             bounds_.begin());
+
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::get_bucket(size_t bucket) const {
+    if (bucket > bounds_.size()) return 0;
+
+    return buckets_[bucket].load(std::memory_order_relaxed);
+}
+
+uint64_t Histogram::get_count() const {
+    uint64_t count = 0;
+
+    for (size_t id = 0; id <= bounds_.size(); ++id) count += get_bucket(id);
+
+    return count;
+}
+
+const std::vector<double> Metrics::LATENCY_BUCKETS = {
+    1e-5, 5e-5, 1e-4, 5e-4, 1e-3, 2e-3, 4e-3, 8e-3, 1.6e-2, 3.3e-2, 1e-1, 1.0,
+};
+
+std::mutex Metrics::mutex_{};
+
+std::map<std::string, std::unique_ptr<Counter>> Metrics::counters_{};
+std::map<std::string, std::unique_ptr<Gauge>> Metrics::gauges_{};
+std::map<std::string, std::unique_ptr<Histogram>> Metrics::histograms_{};
+
+Counter& Metrics::get_counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::unique_ptr<Counter>& counter = counters_[name];
+    if (!counter) counter = std::make_unique<Counter>();
+
+    return *counter;
+}
+
+Gauge& Metrics::get_gauge(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::unique_ptr<Gauge>& gauge = gauges_[name];
+    if (!gauge) gauge = std::make_unique<Gauge>();
+
+    return *gauge;
+}
+
+Histogram& Metrics::
+    get_histogram(const std::string& name, const std::vector<double>& bounds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::unique_ptr<Histogram>& histogram = histograms_[name];
+    if (!histogram) histogram = std::make_unique<Histogram>(bounds);
+
+    return *histogram;
+}
+
+std::string Metrics::format() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string result;
+    char line[512] = "";
+
+    for (auto& [name, counter] : counters_) {
+        snprintf(line, sizeof(line), "%s %" PRIu64 "\n", name.c_str(),
+                 counter->get());
+        result += line;
+    }
+
+    for (auto& [name, gauge] : gauges_) {
+        snprintf(line, sizeof(line), "%s %lg\n", name.c_str(), gauge->get());
+        result += line;
+    }
+
+    for (auto& [name, histogram] : histograms_) {
+        const std::vector<double>& bounds = histogram->get_bounds();
+
+        // Buckets are reported cumulatively
+        uint64_t count = 0;
+        for (size_t id = 0; id < bounds.size(); ++id) {
+            count += histogram->get_bucket(id);
+            snprintf(line, sizeof(line),
+                     "%s_bucket{le=\"%lg\"} %" PRIu64 "\n", name.c_str(),
+                     bounds[id], count);
+            result += line;
+        }
+
+        count += histogram->get_bucket(bounds.size());
+        snprintf(line, sizeof(line), "%s_bucket{le=\"+Inf\"} %" PRIu64 "\n",
+                 name.c_str(), count);
+        result += line;
+
+        snprintf(line, sizeof(line), "%s_sum %lg\n%s_count %" PRIu64 "\n",
+                 name.c_str(), histogram->get_sum(), name.c_str(), count);
+        result += line;
+    }
+
+    return result;
+}
+
+static bool send_to_socket(const char* address, const std::string& message) {
+    sockaddr_un socket_address = {};
+    socket_address.sun_family = AF_UNIX;
+
+    if (strlen(address) >= sizeof(socket_address.sun_path)) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Metrics socket address \"%s\" is too long\n", address);
+        return false;
+    }
+
+    strncpy(socket_address.sun_path, address,
+            sizeof(socket_address.sun_path) - 1);
+
+    int socket_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_fd < 0) return false;
+
+    if (connect(socket_fd, (const sockaddr*)&socket_address,
+                sizeof(socket_address)) != 0) {
+        close(socket_fd);
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < message.size()) {
+        ssize_t result = send(socket_fd, message.data() + written,
+                              message.size() - written, MSG_NOSIGNAL);
+        if (result <= 0) break;
+
+        written += (size_t)result;
+    }
+
+    close(socket_fd);
+
+    return written == message.size();
+}
+
+bool Metrics::dump(const std::string& target) {
+    static const char SOCKET_PREFIX[] = "unix:";
+
+    std::string message = format();
+
+    if (target.starts_with(SOCKET_PREFIX)) {
+        const char* address = target.c_str() + strlen(SOCKET_PREFIX);
+
+        // Nobody listening to the socket is not an error
+        return send_to_socket(address, message);
+    }
+
+    FILE* file = fopen(target.c_str(), "w");
+
+    if (file == nullptr) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Failed to open file \"%s\" for the metrics dump\n",
+                   target.c_str());
+        return false;
+    }
+
+    fwrite(message.data(), 1, message.size(), file);
+    fclose(file);
+
+    return true;
+}
+
+void Metrics::schedule_dumps(const std::string& target, double period) {
+    if (period <= 0.0) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Invalid metrics dump period of %lg seconds\n", period);
+        return;
+    }
+
+    WorldTimer::schedule(period, [target, period]() {
+        dump(target);
+        schedule_dumps(target, period);
+    });
+}
@@ -0,0 +1,179 @@
+/**
+ * @file metrics.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Global registry of counters, gauges and histograms
+ * @version 0.1
+ * @date 2025-02-06
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Monotonic counter, split into per-thread slots that are merged on read
+ *
+ */
+struct Counter final {
+    static const size_t SLOT_COUNT = 16;
+
+    Counter() = default;
+
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+    void add(uint64_t amount = 1) {
+        slots_[get_thread_slot()].value.fetch_add(amount,
+                                                  std::memory_order_relaxed);
+    }
+
+    uint64_t get() const;
+
+   private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> value = 0;
+    };
+
+    static size_t get_thread_slot();
+
+    Slot slots_[SLOT_COUNT];
+};
+
+/**
+ * @brief Value that can be freely changed
+ *
+ */
+struct Gauge final {
+    Gauge() = default;
+
+    Gauge(const Gauge&) = delete;
+    Gauge& operator=(const Gauge&) = delete;
+
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    void add(double value) {
+        value_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    double get() const { return value_.load(std::memory_order_relaxed); }
+
+   private:
+    std::atomic<double> value_ = 0.0;
+};
+
+/**
+ * @brief Distribution of values over a fixed set of buckets
+ *
+ */
+struct Histogram final {
+    /**
+     * @brief Construct a new histogram
+     *
+     * @param[in] bounds ascending upper bounds of the buckets (an additional
+     * bucket is kept for values above the last bound)
+     */
+    explicit Histogram(const std::vector<double>& bounds);
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void record(double value);
+
+    const std::vector<double>& get_bounds() const { return bounds_; }
+
+    /**
+     * @brief Get the number of recorded values that fell into the bucket
+     *
+     * @param[in] bucket bucket index (`get_bounds().size()` for the overflow
+     * bucket)
+     * @return uint64_t
+     */
+    uint64_t get_bucket(size_t bucket) const;
+
+    uint64_t get_count() const;
+    double get_sum() const { return sum_.load(std::memory_order_relaxed); }
+
+   private:
+    std::vector<double> bounds_;
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+
+    std::atomic<double> sum_ = 0.0;
+};
+
+/**
+ * @brief Registry of named metrics
+ *
+ * @note Lookups lock the registry, so metric references should be cached by
+ * the call site (e.g. in a static variable). Updates do not lock.
+ */
+struct Metrics final {
+    /**
+     * @brief Default histogram buckets for latencies (in seconds)
+     *
+     */
+    static const std::vector<double> LATENCY_BUCKETS;
+
+    static Counter& get_counter(const std::string& name);
+    static Gauge& get_gauge(const std::string& name);
+
+    /**
+     * @brief Get a histogram, creating it if it does not exist
+     *
+     * @note `bounds` are ignored if the histogram already exists
+     *
+     * @param[in] name
+     * @param[in] bounds upper bounds of the histogram buckets
+     * @return Histogram&
+     */
+    static Histogram& get_histogram(
+        const std::string& name,
+        const std::vector<double>& bounds = LATENCY_BUCKETS);
+
+    /**
+     * @brief Print all the metrics in a line-based text format
+     * (`<name> <value>`, histograms are split into `_bucket{le="..."}`,
+     * `_sum` and `_count` lines)
+     *
+     * @return std::string
+     */
+    static std::string format();
+
+    /**
+     * @brief Write the metrics to the target
+     *
+     * @param[in] target file name, or a UNIX socket address prefixed with
+     * `unix:`
+     * @return true on success
+     * @return false
+     */
+    static bool dump(const std::string& target);
+
+    /**
+     * @brief Periodically dump the metrics to the target
+     *
+     * @note Dumps are performed by `WorldTimer::run_scheduled_calls()`
+     *
+     * @param[in] target see `dump`
+     * @param[in] period dump period (in seconds)
+     */
+    static void schedule_dumps(const std::string& target, double period);
+
+   private:
+    Metrics();
+
+    static std::mutex mutex_;
+
+    static std::map<std::string, std::unique_ptr<Counter>> counters_;
+    static std::map<std::string, std::unique_ptr<Gauge>> gauges_;
+    static std::map<std::string, std::unique_ptr<Histogram>> histograms_;
+};
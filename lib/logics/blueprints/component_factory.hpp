@@ -12,11 +12,18 @@
 #pragma once
 
 #include <functional>
+#include <future>
 #include <map>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include "logger/logger.h"
 #include "logics/subcomponent.hpp"
+#include "memory/inplace_function.hpp"
+#include "pipelining/main_thread.h"
+#include "pipelining/thread_pool.hpp"
 
 struct SceneComponent;
 
@@ -40,11 +47,32 @@ struct ComponentFactory final {
      */
     SubcomponentNameMap build(Ts&&... args) const;
 
+    /**
+     * @brief Run the factory, executing producers concurrently on the pool
+     *
+     * @note Producers request assets on the pool threads, and the importers
+     * perform their graphics calls on the main thread, so this function
+     * should be called from the main thread
+     *
+     * @param[in] pool
+     * @param[in] args construction parameters
+     * @return SubcomponentNameMap - a name map of constructed components
+     */
+    SubcomponentNameMap build(ThreadPool& pool, Ts&&... args) const;
+
+    /**
+     * @brief Inline capacity of producers, which capture component parameters
+     * by value
+     *
+     */
+    static const size_t PRODUCER_CAPACITY = 128;
+
     /**
      * @brief Component producer
      *
      */
-    using Producer = std::function<Subcomponent<SceneComponent>(Ts&&... args)>;
+    using Producer = InplaceFunction<Subcomponent<SceneComponent>(Ts&&... args),
+                                     PRODUCER_CAPACITY>;
 
     /**
      * @brief Add instruction to the factory
@@ -54,16 +82,54 @@ struct ComponentFactory final {
      */
     void register_producer(const std::string& name, const Producer& producer);
 
+    using ProducerMap = std::map<std::string, Producer>;
+
+    /**
+     * @brief Get registered producers in the order they are run by `build`
+     *
+     * @return const ProducerMap&
+     */
+    const ProducerMap& get_producers() const { return instructions_; }
+
+    size_t size() const { return instructions_.size(); }
+
    private:
-    std::map<std::string, Producer> instructions_{};
+    ProducerMap instructions_{};
 };
 
 template <class... Ts>
 inline SubcomponentNameMap ComponentFactory<Ts...>::build(Ts&&... args) const {
     SubcomponentNameMap map{};
 
+    // Producers may move from their arguments, so each one gets a copy
+    for (const auto& [name, producer] : instructions_) {
+        map[name] =
+            std::apply(producer, std::tuple<std::decay_t<Ts>...>(args...));
+    }
+
+    return map;
+}
+
+template <class... Ts>
+inline SubcomponentNameMap ComponentFactory<Ts...>::
+    build(ThreadPool& pool, Ts&&... args) const {
+    std::vector<std::future<Subcomponent<SceneComponent>>> results{};
+    results.reserve(instructions_.size());
+
+    // Every task owns a copy of the arguments, which its producer may move
+    for (const auto& [name, producer] : instructions_) {
+        results.push_back(pool.submit([&producer, args...]() mutable {
+            return producer(std::forward<Ts>(args)...);
+        }));
+    }
+
+    SubcomponentNameMap map{};
+
+    auto result = results.begin();
     for (const auto& [name, producer] : instructions_) {
-        map[name] = producer(std::forward<Ts>(args)...);
+        MainThread::wait(*result);
+        map.insert({name, result->get()});
+        ++result;
     }
 
     return map;
@@ -1,20 +1,158 @@
 #include "external_level.h"
 
+#include <algorithm>
+
 #include "logics/scene.h"
 #include "logics/scene_component.h"
+#include "managers/tick_manager.h"
+#include "time/world_timer.h"
 
 SubcomponentNameMap ExternalLevel::
     build(Scene& scene, const glm::mat4& transform) const {
-    SubcomponentNameMap guide = factory_.build(transform);
+    Stream stream(*this, scene, transform);
+
+    stream.finish();
+
+    return stream.get_components();
+}
+
+SubcomponentNameMap ExternalLevel::
+    build(Scene& scene, const glm::mat4& transform, ThreadPool& pool) const {
+    Stream stream(*this, scene, transform, &pool);
+
+    stream.finish();
+
+    return stream.get_components();
+}
+
+ExternalLevel::StreamHandle ExternalLevel::
+    stream(Scene& scene, const glm::mat4& transform, ThreadPool* pool) const {
+    return std::make_shared<Stream>(*this, scene, transform, pool);
+}
+
+ExternalLevel::StreamHandle ExternalLevel::
+    stream(Scene& scene, const glm::mat4& transform, TickManager& ticker,
+           ThreadPool* pool) const {
+    StreamHandle handle = stream(scene, transform, pool);
+
+    ticker.add_sliced_task(
+        [handle](double deadline) { return handle->advance(deadline); });
+
+    return handle;
+}
+
+ExternalLevel::Stream::Stream(const ExternalLevel& level, Scene& scene,
+                              const glm::mat4& transform, ThreadPool* pool)
+    : level_(level),
+      scene_(scene),
+      scene_lifetime_(scene.get_lifetime()),
+      transform_(transform),
+      producer_(level_.factory_.get_producers().begin()) {
+    if (pool == nullptr) return;
+
+    constructed_.reserve(level_.factory_.size());
+
+    // Producers refer to the copy of the level owned by the stream
+    for (const auto& [name, producer] : level_.factory_.get_producers()) {
+        constructed_.push_back(
+            pool->submit([&producer = producer, transform]() {
+                return producer(transform);
+            }));
+    }
+}
+
+ExternalLevel::Stream::~Stream() {
+    // Producers on the pool refer to the level copy destroyed next
+    if (!is_finished()) cancel();
+}
+
+bool ExternalLevel::Stream::advance(double deadline) {
+    if (!cancelled_ && !is_scene_alive()) cancel();
+
+    if (cancelled_) return true;
+
+    auto remaining = std::chrono::duration<double>(
+        std::max(deadline - WorldTimer::get_time_sec(), 0.0));
+
+    TimePoint time_limit =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            remaining);
 
-    for (const auto& [name, component] : guide) {
-        scene.add_component(component);
+    do {
+        if (is_finished()) break;
+
+        if (!perform_step(time_limit)) break;
+    } while (WorldTimer::get_time_sec() < deadline);
+
+    return is_finished();
+}
+
+void ExternalLevel::Stream::finish() {
+    if (!cancelled_ && !is_scene_alive()) cancel();
+
+    while (!cancelled_ && !is_finished()) perform_step(TimePoint::max());
+}
+
+void ExternalLevel::Stream::cancel() {
+    cancelled_ = true;
+
+    for (std::future<Subcomponent<SceneComponent>>& future : constructed_) {
+        if (future.valid()) MainThread::wait(future);
     }
 
-    for (const Script& script : scripts_) {
-        std::shared_ptr<Script> registered_script = scene.add_script(script);
-        registered_script->assemble(scene, guide);
+    constructed_.clear();
+}
+
+double ExternalLevel::Stream::get_progress() const {
+    size_t step_count = get_step_count();
+
+    if (step_count == 0) return 1.0;
+
+    return (double)step_ / (double)step_count;
+}
+
+bool ExternalLevel::Stream::perform_step(TimePoint deadline) {
+    // Scripts can only be assembled once all the components are present on the
+    // scene, so they go last.
+    if (producer_ != level_.factory_.get_producers().end()) {
+        const auto& [name, producer] = *producer_;
+
+        Subcomponent<SceneComponent> component(SubcomponentNone);
+
+        if (constructed_.empty()) {
+            component = producer(transform_);
+        } else {
+            std::future<Subcomponent<SceneComponent>>& future =
+                constructed_[step_];
+
+            // Producers running on the pool may be waiting for the main thread
+            if (!MainThread::wait(future, deadline)) return false;
+
+            component = future.get();
+        }
+
+        components_.insert({name, component});
+        scene_.add_component(component);
+
+        ++producer_;
+    } else {
+        size_t script_id = step_ - level_.factory_.size();
+
+        std::shared_ptr<Script> registered_script =
+            scene_.add_script(level_.scripts_[script_id]);
+        registered_script->assemble(scene_, components_);
     }
 
-    return guide;
+    ++step_;
+
+    return true;
+}
+
+bool ExternalLevel::Stream::is_scene_alive() const {
+    return !scene_lifetime_.expired();
+}
+
+size_t ExternalLevel::Stream::get_step_count() const {
+    return level_.factory_.size() + level_.scripts_.size();
 }
@@ -11,11 +11,18 @@
 
 #pragma once
 
+#include <chrono>
+#include <future>
 #include <glm/mat4x4.hpp>
+#include <memory>
+#include <vector>
 
 #include "component_factory.hpp"
+#include "managers/asset_manager.h"
 #include "scripts/script.h"
 
+struct TickManager;
+
 struct ExternalLevel final {
     using Factory = ComponentFactory<const glm::mat4&>;
 
@@ -23,9 +30,12 @@ struct ExternalLevel final {
         virtual ~Metadata() = default;
     };
 
+    struct Stream;
+    using StreamHandle = std::shared_ptr<Stream>;
+
     ExternalLevel(const Factory& factory, const std::vector<Script>& scripts,
-                  const Metadata* meta)
-        : factory_(factory), scripts_(scripts), meta_(meta) {}
+                  AssetRef<Metadata> meta = {})
+        : factory_(factory), scripts_(scripts), meta_(std::move(meta)) {}
 
     ExternalLevel(const ExternalLevel&) = default;
     ExternalLevel(ExternalLevel&&) = default;
@@ -35,20 +45,161 @@ struct ExternalLevel final {
 
     ~ExternalLevel() = default;
 
+    /**
+     * @brief Build the level on the scene in one go
+     *
+     * @param[in] scene
+     * @param[in] transform level root transform
+     * @return SubcomponentNameMap - a name map of constructed components
+     */
     SubcomponentNameMap build(Scene& scene, const glm::mat4& transform) const;
 
+    /**
+     * @brief Build the level on the scene, constructing components on the pool
+     *
+     * @param[in] scene
+     * @param[in] transform level root transform
+     * @param[in] pool
+     * @return SubcomponentNameMap - a name map of constructed components
+     */
+    SubcomponentNameMap build(Scene& scene, const glm::mat4& transform,
+                              ThreadPool& pool) const;
+
+    /**
+     * @brief Start building the level on the scene piece by piece
+     *
+     * @note The stream keeps its own copy of the level, so the level may be
+     * unloaded while it is being streamed. Destroying the scene cancels the
+     * stream.
+     *
+     * @param[in] scene
+     * @param[in] transform level root transform
+     * @param[in] pool optional pool to construct components on
+     * @return StreamHandle - handle to be advanced until the level is built
+     */
+    StreamHandle stream(Scene& scene, const glm::mat4& transform,
+                        ThreadPool* pool = nullptr) const;
+
+    /**
+     * @brief Start building the level on the scene, spending no more than the
+     * sliced task budget of the tick manager per frame
+     *
+     * @param[in] scene
+     * @param[in] transform level root transform
+     * @param[in] ticker tick manager the stream is going to be advanced by
+     * @param[in] pool optional pool to construct components on
+     * @return StreamHandle
+     */
+    StreamHandle stream(Scene& scene, const glm::mat4& transform,
+                        TickManager& ticker, ThreadPool* pool = nullptr) const;
+
     template <class T = Metadata>
         requires std::is_base_of_v<Metadata, T>
     const T* meta() const {
-        return dynamic_cast<const T*>(meta_);
+        return dynamic_cast<const T*>(meta_.get());
     }
 
-    bool has_meta() const { return meta_; }
+    bool has_meta() const { return static_cast<bool>(meta_); }
 
    private:
     Factory factory_;
 
     std::vector<Script> scripts_;
 
-    const Metadata* meta_;
+    AssetRef<Metadata> meta_;
+};
+
+/**
+ * @brief Level build in progress
+ *
+ */
+struct ExternalLevel::Stream final {
+    /**
+     * @brief Start a level build
+     *
+     * @param[in] level level to build (copied by the stream)
+     * @param[in] scene
+     * @param[in] transform level root transform
+     * @param[in] pool pool to construct components on ahead of their commit
+     * (components are constructed during commit if `nullptr`)
+     */
+    Stream(const ExternalLevel& level, Scene& scene, const glm::mat4& transform,
+           ThreadPool* pool = nullptr);
+
+    Stream(const Stream&) = delete;
+    Stream& operator=(const Stream&) = delete;
+    Stream(Stream&&) = delete;
+    Stream& operator=(Stream&&) = delete;
+
+    ~Stream();
+
+    /**
+     * @brief Construct and commit components to the scene until the deadline
+     *
+     * @note At least one build step is performed per call, unless the stream
+     * is waiting for the pool to construct the next component
+     *
+     * @note The stream is cancelled if its scene has been destroyed
+     *
+     * @param[in] deadline world time (in seconds) to stop at
+     * @return true if the level has been completely built or the stream has
+     * been cancelled
+     */
+    bool advance(double deadline);
+
+    /**
+     * @brief Complete the build synchronously
+     *
+     */
+    void finish();
+
+    /**
+     * @brief Stop the build (e.g. when the scene is being torn down), waiting
+     * for the components that are being constructed on the pool
+     *
+     * @note Components that have already been committed stay on the scene
+     */
+    void cancel();
+
+    bool is_finished() const { return step_ >= get_step_count(); }
+    bool is_cancelled() const { return cancelled_; }
+
+    /**
+     * @brief Get build progress
+     *
+     * @return double - fraction of completed build steps (from 0 to 1)
+     */
+    double get_progress() const;
+
+    /**
+     * @brief Get components constructed so far
+     *
+     * @return const SubcomponentNameMap&
+     */
+    const SubcomponentNameMap& get_components() const { return components_; }
+
+   private:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    bool perform_step(TimePoint deadline);
+
+    size_t get_step_count() const;
+
+    bool is_scene_alive() const;
+
+    ExternalLevel level_;
+
+    Scene& scene_;
+    std::weak_ptr<const void> scene_lifetime_;
+
+    glm::mat4 transform_;
+
+    Factory::ProducerMap::const_iterator producer_;
+
+    std::vector<std::future<Subcomponent<SceneComponent>>> constructed_{};
+
+    size_t step_ = 0;
+    bool cancelled_ = false;
+
+    SubcomponentNameMap components_{};
 };
@@ -16,12 +16,14 @@ XML_BASED_IMPORTER(ExternalLevel, "level") {
     ExternalLevel::Factory factory;
     std::vector<Script> scripts;
 
-    const ExternalLevel::Metadata* meta = nullptr;
+    AssetRef<ExternalLevel::Metadata> meta{};
 
+    // Scripts and producers are copied into the level, so their rogue assets
+    // are freed right after the import
     for (const tinyxml2::XMLElement* child = data.FirstChildElement();
          child != nullptr; child = child->NextSiblingElement()) {
         if (strcmp(child->Name(), "script") == 0) {
-            const Script* script = AssetManager::request<Script>(*child);
+            AssetRef<Script> script = AssetManager::acquire<Script>(*child);
 
             if (!script) {
                 log_printf(ERROR_REPORTS, "error",
@@ -35,7 +37,7 @@ XML_BASED_IMPORTER(ExternalLevel, "level") {
         }
 
         if (child->Attribute("type", "meta")) {
-            meta = AssetManager::request<ExternalLevel::Metadata>(*child);
+            meta = AssetManager::acquire<ExternalLevel::Metadata>(*child);
             continue;
         }
 
@@ -50,10 +52,10 @@ XML_BASED_IMPORTER(ExternalLevel, "level") {
             continue;
         }
 
-        const ExternalLevel::Factory::Producer* producer = AssetManager::
-            request<ExternalLevel::Factory::Producer>(*child);
+        AssetRef<ExternalLevel::Factory::Producer> producer = AssetManager::
+            acquire<ExternalLevel::Factory::Producer>(*child);
 
-        if (producer == nullptr) {
+        if (!producer) {
             ERROR("Failed to request a producer for an object type of \"%s\"\n",
                   child->Name());
             continue;
@@ -62,5 +64,5 @@ XML_BASED_IMPORTER(ExternalLevel, "level") {
         factory.register_producer(name, *producer);
     }
 
-    return new Asset<ExternalLevel>(factory, scripts, meta);
+    return new Asset<ExternalLevel>(factory, scripts, std::move(meta));
 }
@@ -0,0 +1,489 @@
+#include "image.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <unordered_map>
+
+#include "io/files.h"
+#include "logger/logger.h"
+#include "node.h"
+#include "nodes/nodes.h"
+#include "optimizer.h"
+#include "parser/lexemizer.h"
+
+static const uint32_t IMAGE_MAGIC = 0x52435353;  // "SSCR"
+static const uint32_t IMAGE_VERSION = 4;
+
+enum class ConstantType : uint8_t {
+    NONE,
+    NUMBER,
+    BOOL,
+    STRING,
+    // Name of a component, resolved on instantiation
+    COMPONENT,
+};
+
+struct ImageHeader {
+    uint32_t magic;
+    uint32_t version;
+
+    uint64_t source_hash;
+    uint64_t source_size;
+
+    uint32_t node_count;
+    uint32_t input_count;
+    uint32_t root_count;
+    uint32_t queue_count;
+    uint32_t string_size;
+    uint32_t reserved;
+};
+
+struct ImageNode {
+    ScriptOpcode opcode;
+    ConstantType constant;
+    uint16_t reserved;
+
+    // End of the node inputs in the input table
+    uint32_t input_end;
+
+    // Value of numeric and boolean constants
+    double number;
+
+    // Value of string constants and names of components in the string table
+    uint32_t string_offset;
+    uint32_t string_length;
+
+    // Position of the lexeme the node was parsed from
+    uint32_t line;
+    uint32_t column;
+};
+
+struct ImageRoot {
+    uint32_t node;
+
+    // Position of the statement in the source
+    uint32_t line;
+    uint32_t column;
+};
+
+/**
+ * @brief Sections of an image: the header is followed by the node records,
+ * the input table, root records, initial queue indices and the string table
+ *
+ */
+struct ImageView {
+    const ImageHeader* header;
+    const ImageNode* nodes;
+    const uint32_t* inputs;
+    const ImageRoot* roots;
+    const uint32_t* queue;
+    const char* strings;
+};
+
+static size_t get_image_size(const ImageHeader& header) {
+    return sizeof(ImageHeader) + header.node_count * sizeof(ImageNode) +
+           header.root_count * sizeof(ImageRoot) +
+           ((size_t)header.input_count + header.queue_count) *
+               sizeof(uint32_t) +
+           header.string_size;
+}
+
+static ImageView get_view(const uint8_t* data) {
+    ImageView view{};
+
+    view.header = (const ImageHeader*)data;
+    view.nodes = (const ImageNode*)(view.header + 1);
+    view.inputs = (const uint32_t*)(view.nodes + view.header->node_count);
+    view.roots = (const ImageRoot*)(view.inputs + view.header->input_count);
+    view.queue = (const uint32_t*)(view.roots + view.header->root_count);
+    view.strings = (const char*)(view.queue + view.header->queue_count);
+
+    return view;
+}
+
+static uint32_t get_arity(ScriptOpcode opcode) {
+    switch (opcode) {
+        case ScriptOpcode::CONSTANT:
+            return 0;
+        case ScriptOpcode::IS_VALID:
+        case ScriptOpcode::LENGTH:
+        case ScriptOpcode::NEGATIVE:
+        case ScriptOpcode::ABSOLUTE:
+        case ScriptOpcode::SIGN:
+        case ScriptOpcode::SIN:
+        case ScriptOpcode::COS:
+        case ScriptOpcode::LOG_E:
+        case ScriptOpcode::LOG_2:
+        case ScriptOpcode::LOG_10:
+        case ScriptOpcode::NOT:
+        case ScriptOpcode::DETECT_CHANGE:
+        case ScriptOpcode::REQUIRE_VALIDITY:
+        case ScriptOpcode::DETECT_SOURCE:
+            return 1;
+        case ScriptOpcode::CONDITIONAL:
+        case ScriptOpcode::INPUT_METHOD:
+            return 3;
+        default:
+            return 2;
+    }
+}
+
+ScriptImage::~ScriptImage() {
+    if (mapping_.ptr) {
+        munmap(mapping_.ptr, mapping_.size);
+        close(mapping_.fd);
+    }
+}
+
+std::shared_ptr<const ScriptImage> ScriptImage::compile(
+    const std::string& source) {
+    LexemeBuffer lexemes = lexify(source);
+    ParsedTree tree = build_exec_ast(lexemes);
+
+    std::unordered_map<const Script::Node*, const std::string*> names{};
+
+    for (const auto& [pointer, name] : tree.component_names) {
+        if (auto node = pointer.lock()) names.insert({node.get(), &name});
+    }
+
+    std::vector<ScriptInstruction> instructions{};
+    std::unordered_map<const Script::Node*, uint32_t> indices{};
+
+    for (const std::weak_ptr<Script::Node>& pointer : tree.nodes) {
+        std::shared_ptr<Script::Node> node = pointer.lock();
+
+        indices.insert({node.get(), (uint32_t)instructions.size()});
+
+        ScriptInstruction instruction{};
+        instruction.opcode = node->get_opcode();
+        instruction.line = node->get_line();
+        instruction.column = node->get_column();
+
+        for (const Script::Node::ChildReference& input : node->get_inputs()) {
+            instruction.inputs.push_back(indices.at(input.get()));
+        }
+
+        if (instruction.opcode == ScriptOpcode::CONSTANT) {
+            auto name = names.find(node.get());
+
+            if (name != names.end()) {
+                instruction.value = *name->second;
+                instruction.component = true;
+            } else {
+                instruction.value = node->get_value();
+            }
+        }
+
+        instructions.push_back(std::move(instruction));
+    }
+
+    std::vector<uint32_t> roots{};
+
+    for (const std::shared_ptr<Script::Node>& root : tree.roots) {
+        roots.push_back(indices.at(root.get()));
+    }
+
+    optimize_script(instructions, roots);
+
+    // Roots keep their order through the optimization
+    std::vector<ImageRoot> root_records{};
+
+    for (size_t id = 0; id < roots.size(); ++id) {
+        const SourceLocation& location = tree.root_locations[id];
+        root_records.push_back({roots[id], location.line, location.column});
+    }
+
+    std::vector<ImageNode> nodes{};
+    std::vector<uint32_t> inputs{}, queue{};
+    std::string strings{};
+
+    for (const ScriptInstruction& instruction : instructions) {
+        ImageNode record{};
+        record.opcode = instruction.opcode;
+        record.line = instruction.line;
+        record.column = instruction.column;
+
+        inputs.insert(inputs.end(), instruction.inputs.begin(),
+                      instruction.inputs.end());
+        record.input_end = (uint32_t)inputs.size();
+
+        const ScriptValue& value = instruction.value;
+
+        if (instruction.component) {
+            record.constant = ConstantType::COMPONENT;
+        } else if (value.get_type() == ScriptValue::Type::NUMBER) {
+            record.constant = ConstantType::NUMBER;
+        } else if (value.get_type() == ScriptValue::Type::BOOL) {
+            record.constant = ConstantType::BOOL;
+        } else if (value.get_type() == ScriptValue::Type::STRING) {
+            record.constant = ConstantType::STRING;
+        }
+
+        if (record.constant == ConstantType::NUMBER ||
+            record.constant == ConstantType::BOOL) {
+            record.number = value.as_number();
+        } else if (record.constant != ConstantType::NONE) {
+            std::string string = value.as_string();
+
+            record.string_offset = (uint32_t)strings.size();
+            record.string_length = (uint32_t)string.size();
+            strings += string;
+        }
+
+        // Constants propagate their values when the script starts
+        if (instruction.opcode == ScriptOpcode::CONSTANT) {
+            queue.push_back((uint32_t)nodes.size());
+        }
+
+        nodes.push_back(record);
+    }
+
+    ImageHeader header{};
+    header.magic = IMAGE_MAGIC;
+    header.version = IMAGE_VERSION;
+    header.source_hash = murmur_hash(source.c_str());
+    header.source_size = source.size();
+    header.node_count = (uint32_t)nodes.size();
+    header.input_count = (uint32_t)inputs.size();
+    header.root_count = (uint32_t)roots.size();
+    header.queue_count = (uint32_t)queue.size();
+    header.string_size = (uint32_t)strings.size();
+
+    std::shared_ptr<ScriptImage> image(new ScriptImage());
+
+    std::vector<uint8_t>& bytes = image->bytes_;
+    bytes.reserve(get_image_size(header));
+
+    auto append = [&bytes](const void* data, size_t size) {
+        bytes.insert(bytes.end(), (const uint8_t*)data,
+                     (const uint8_t*)data + size);
+    };
+
+    append(&header, sizeof(header));
+    append(nodes.data(), nodes.size() * sizeof(ImageNode));
+    append(inputs.data(), inputs.size() * sizeof(uint32_t));
+    append(root_records.data(), root_records.size() * sizeof(ImageRoot));
+    append(queue.data(), queue.size() * sizeof(uint32_t));
+    append(strings.data(), strings.size());
+
+    image->data_ = bytes.data();
+    image->size_ = bytes.size();
+    image->complete_ = tree.complete;
+
+    return image;
+}
+
+std::shared_ptr<const ScriptImage> ScriptImage::load(const std::string& path,
+                                                     hash_t hash,
+                                                     size_t size) {
+    struct stat status = {};
+    if (stat(path.c_str(), &status) != 0) return nullptr;
+
+    MmapResult mapping =
+        map_file(path.c_str(), O_RDONLY, PROT_READ, MAP_PRIVATE);
+    if (!mapping.ptr) return nullptr;
+
+    std::shared_ptr<ScriptImage> image(new ScriptImage());
+
+    image->mapping_ = mapping;
+    image->data_ = (const uint8_t*)mapping.ptr;
+    image->size_ = mapping.size;
+    image->complete_ = true;
+
+    if (!image->validate(hash, size)) {
+        log_printf(WARNINGS, "warning",
+                   "Ignoring damaged or outdated script image \"%s\".\n",
+                   path.c_str());
+        return nullptr;
+    }
+
+    return image;
+}
+
+bool ScriptImage::save(const std::string& path) const {
+    if (!write_file_atomic(path, data_, size_)) {
+        log_printf(WARNINGS, "warning",
+                   "Failed to write script image \"%s\".\n", path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+size_t ScriptImage::get_node_count() const {
+    return get_view(data_).header->node_count;
+}
+
+bool ScriptImage::validate(hash_t hash, size_t size) const {
+    if (size_ < sizeof(ImageHeader)) return false;
+
+    ImageView view = get_view(data_);
+    const ImageHeader& header = *view.header;
+
+    if (header.magic != IMAGE_MAGIC || header.version != IMAGE_VERSION ||
+        header.source_hash != hash || header.source_size != size ||
+        get_image_size(header) != size_)
+        return false;
+
+    uint32_t input_begin = 0;
+
+    for (uint32_t id = 0; id < header.node_count; ++id) {
+        const ImageNode& node = view.nodes[id];
+
+        if (node.opcode > ScriptOpcode::INPUT_METHOD ||
+            node.constant > ConstantType::COMPONENT)
+            return false;
+
+        if (node.input_end < input_begin ||
+            node.input_end > header.input_count ||
+            node.input_end - input_begin != get_arity(node.opcode))
+            return false;
+
+        for (uint32_t edge = input_begin; edge < node.input_end; ++edge) {
+            if (view.inputs[edge] >= id) return false;
+        }
+
+        if ((uint64_t)node.string_offset + node.string_length >
+            header.string_size)
+            return false;
+
+        input_begin = node.input_end;
+    }
+
+    for (uint32_t id = 0; id < header.root_count; ++id) {
+        if (view.roots[id].node >= header.node_count) return false;
+    }
+
+    for (uint32_t id = 0; id < header.queue_count; ++id) {
+        if (view.queue[id] >= header.node_count) return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Get the value of a constant record (names of the components for the
+ * component constants)
+ *
+ */
+static ScriptValue get_constant(const ImageView& view,
+                                const ImageNode& record) {
+    std::string_view text(view.strings + record.string_offset,
+                          record.string_length);
+
+    switch (record.constant) {
+        case ConstantType::NUMBER:
+            return record.number;
+        case ConstantType::BOOL:
+            return record.number != 0.0;
+        case ConstantType::STRING:
+        case ConstantType::COMPONENT:
+            return std::string(text);
+        default:
+            return ScriptValue();
+    }
+}
+
+ParsedTree ScriptImage::instantiate(const SubcomponentNameMap& name_map) const {
+    ImageView view = get_view(data_);
+    const ImageHeader& header = *view.header;
+
+    ParsedTree tree{};
+    tree.complete = complete_;
+
+    std::vector<std::shared_ptr<Script::Node>> nodes{};
+    nodes.reserve(header.node_count);
+
+    std::vector<Script::Node::ChildReference> inputs{};
+    uint32_t input_begin = 0;
+
+    for (uint32_t id = 0; id < header.node_count; ++id) {
+        const ImageNode& record = view.nodes[id];
+
+        inputs.clear();
+        for (uint32_t edge = input_begin; edge < record.input_end; ++edge) {
+            inputs.push_back(nodes[view.inputs[edge]]);
+        }
+
+        input_begin = record.input_end;
+
+        ScriptValue constant = get_constant(view, record);
+
+        if (record.constant == ConstantType::COMPONENT) {
+            std::string name = constant.as_string();
+            auto component = name_map.find(name);
+
+            if (component == name_map.end()) {
+                log_printf(ERROR_REPORTS, "error",
+                           "Could not find a component with the name "
+                           "\"%s\".\n",
+                           name.c_str());
+                constant = GUID();
+            } else {
+                constant = component->second->get_guid();
+            }
+        }
+
+        nodes.emplace_back(nodes::create(record.opcode, inputs, constant));
+        nodes.back()->set_location(record.line, record.column);
+
+        tree.nodes.push_back(nodes.back());
+    }
+
+    for (uint32_t id = 0; id < header.root_count; ++id) {
+        const ImageRoot& root = view.roots[id];
+
+        tree.roots.push_back(nodes[root.node]);
+        tree.root_locations.push_back({root.line, root.column});
+    }
+
+    for (uint32_t id = 0; id < header.queue_count; ++id) {
+        tree.queue.push_back(nodes[view.queue[id]]);
+    }
+
+    // Only the nodes reachable from the roots are kept alive by the tree
+    nodes.clear();
+
+    std::erase_if(tree.nodes, [](const std::weak_ptr<Script::Node>& node) {
+        return node.expired();
+    });
+    std::erase_if(tree.queue, [](const std::weak_ptr<Script::Node>& node) {
+        return node.expired();
+    });
+
+    return tree;
+}
+
+std::vector<ScriptInstruction> ScriptImage::get_instructions(
+    std::vector<uint32_t>& roots) const {
+    ImageView view = get_view(data_);
+    const ImageHeader& header = *view.header;
+
+    std::vector<ScriptInstruction> instructions(header.node_count);
+    uint32_t input_begin = 0;
+
+    for (uint32_t id = 0; id < header.node_count; ++id) {
+        const ImageNode& record = view.nodes[id];
+        ScriptInstruction& instruction = instructions[id];
+
+        instruction.opcode = record.opcode;
+        instruction.value = get_constant(view, record);
+        instruction.component = record.constant == ConstantType::COMPONENT;
+        instruction.inputs.assign(view.inputs + input_begin,
+                                  view.inputs + record.input_end);
+        instruction.line = record.line;
+        instruction.column = record.column;
+
+        input_begin = record.input_end;
+    }
+
+    roots.clear();
+
+    for (uint32_t id = 0; id < header.root_count; ++id) {
+        roots.push_back(view.roots[id].node);
+    }
+
+    return instructions;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file image.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Binary image of a parsed script
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hash/murmur.h"
+#include "io/mmap.h"
+#include "optimizer.h"
+#include "parser/tree_builder.h"
+
+/**
+ * @brief Parsed level script with unresolved component names
+ *
+ * The image is a flat blob of node records (opcodes, constants and input
+ * indices in creation order), which is either built from the script source or
+ * memory-mapped from a file, so instantiating a script from an image skips
+ * lexing and parsing and only resolves the component names.
+ */
+struct ScriptImage final {
+    ScriptImage(const ScriptImage&) = delete;
+    ScriptImage& operator=(const ScriptImage&) = delete;
+
+    ~ScriptImage();
+
+    /**
+     * @brief Lex and parse the script
+     *
+     * @param[in] source script text
+     * @return std::shared_ptr<const ScriptImage>
+     */
+    static std::shared_ptr<const ScriptImage> compile(
+        const std::string& source);
+
+    /**
+     * @brief Map an image file
+     *
+     * @param[in] path
+     * @param[in] hash hash of the source the image is expected to be built from
+     * @param[in] size length of the source
+     * @return std::shared_ptr<const ScriptImage> - the image or `nullptr` if
+     * the file does not exist, is damaged or was built from another source
+     */
+    static std::shared_ptr<const ScriptImage> load(const std::string& path,
+                                                   hash_t hash, size_t size);
+
+    /**
+     * @brief Write the image to a file
+     *
+     * @param[in] path
+     * @return true if the image was written
+     * @return false otherwise
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Create the nodes of the script
+     *
+     * @param[in] name_map components the script can refer to by name
+     * @return ParsedTree
+     */
+    ParsedTree instantiate(const SubcomponentNameMap& name_map) const;
+
+    /**
+     * @brief Decode the nodes of the script
+     *
+     * @param[out] roots indices of the root instructions
+     * @return std::vector<ScriptInstruction> - instructions in topological
+     * order (component constants hold the names of the components)
+     */
+    std::vector<ScriptInstruction> get_instructions(
+        std::vector<uint32_t>& roots) const;
+
+    /**
+     * @brief Check if the image covers the whole script (scripts with syntax
+     * errors are only partially parsed)
+     *
+     */
+    bool is_complete() const { return complete_; }
+
+    bool is_mapped() const { return mapping_.ptr != nullptr; }
+
+    size_t get_node_count() const;
+
+   private:
+    ScriptImage() = default;
+
+    /**
+     * @brief Check that the data is a consistent image of the source
+     *
+     */
+    bool validate(hash_t hash, size_t size) const;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+
+    // Storage of the images built from the source
+    std::vector<uint8_t> bytes_{};
+
+    MmapResult mapping_{};
+
+    bool complete_ = false;
+};
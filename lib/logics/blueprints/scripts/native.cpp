@@ -0,0 +1,647 @@
+#include "native.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "image.h"
+#include "logger/logger.h"
+
+bool NativeScript::enabled_ = true;
+
+struct NativeEntry {
+    size_t size;
+    NativeScript::Factory factory;
+};
+
+// Scripts are registered during static initialization, so the registry is
+// created on first use
+static std::unordered_map<hash_t, NativeEntry>& get_registry() {
+    static std::unordered_map<hash_t, NativeEntry> registry;
+    return registry;
+}
+
+void NativeScript::add(hash_t hash, size_t size, Factory factory) {
+    get_registry().insert({hash, {size, factory}});
+}
+
+NativeScript::Factory NativeScript::find(const std::string& source) {
+    std::unordered_map<hash_t, NativeEntry>& registry = get_registry();
+    if (registry.empty()) return nullptr;
+
+    auto found = registry.find(murmur_hash(source.c_str()));
+    if (found == registry.end() || found->second.size != source.size())
+        return nullptr;
+
+    return found->second.factory;
+}
+
+ScriptValue NativeScript::find_component(const SubcomponentNameMap& name_map,
+                                         const char* name) {
+    auto component = name_map.find(name);
+
+    if (component == name_map.end()) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Could not find a component with the name \"%s\".\n",
+                   name);
+        return GUID();
+    }
+
+    return component->second->get_guid();
+}
+
+void NativeScript::connect_output(Output& output, const ScriptValue& object,
+                                  const ScriptValue& method) {
+    if (method.is_none()) return;
+
+    connect_output(output, object, output.binding.resolve(method));
+}
+
+void NativeScript::connect_output(Output& output, const ScriptValue& object,
+                                  Symbol method) {
+    assert(scene_);
+
+    SceneComponent::Channel* channel =
+        nodes::find_output(*scene_, object, method);
+    if (!channel) return;
+
+    output.listener.unsubscribe();
+    channel->subscribe(output.listener);
+}
+
+void NativeScript::connect_input(Input& input, const ScriptValue& object,
+                                 const ScriptValue& method) {
+    input.output = SceneComponent::Channel();
+
+    if (method.is_none()) return;
+
+    connect_input(input, object, input.binding.resolve(method));
+}
+
+void NativeScript::connect_input(Input& input, const ScriptValue& object,
+                                 Symbol method) {
+    assert(scene_);
+
+    input.output = SceneComponent::Channel();
+
+    SceneComponent::InputChannel* listener =
+        nodes::find_input(*scene_, object, method);
+    if (!listener) return;
+
+    input.output.subscribe(*listener);
+
+    input.connected = true;
+}
+
+/**
+ * @brief Emitter of the C++ class implementing a script
+ *
+ */
+struct NativeGenerator final {
+    NativeGenerator(const std::vector<ScriptInstruction>& instructions,
+                    const std::string& class_name)
+        : instructions_(instructions), class_name_(class_name) {
+        build_dependents();
+    }
+
+    std::string generate();
+
+   private:
+    struct Dependent {
+        uint32_t node;
+        uint8_t mask;
+    };
+
+    void build_dependents();
+
+    void emit(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    std::string value(uint32_t node) const {
+        std::string name = "v";
+        name.append(std::to_string(node)).append("_");
+
+        return name;
+    }
+
+    /**
+     * @brief Check if the node always has a value known at compile time
+     *
+     */
+    bool is_literal(uint32_t node) const {
+        const ScriptInstruction& instruction = instructions_[node];
+
+        return instruction.opcode == ScriptOpcode::CONSTANT &&
+               !instruction.component && instruction.value.has_value();
+    }
+
+    std::string number(uint32_t node) const;
+    std::string boolean(uint32_t node) const;
+
+    void emit_members();
+    void emit_start();
+    void emit_update(uint32_t node);
+    void emit_operation(uint32_t node);
+    void emit_propagate(uint32_t node);
+
+    const std::vector<ScriptInstruction>& instructions_;
+    std::string class_name_;
+
+    std::vector<std::vector<Dependent>> dependents_{};
+
+    std::string result_{};
+};
+
+static std::string escape_string(const std::string& string) {
+    std::string result = "\"";
+
+    for (char symbol : string) {
+        switch (symbol) {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            default:
+                if ((uint8_t)symbol < 0x20 || (uint8_t)symbol >= 0x7f) {
+                    // Octal escapes have a fixed length, unlike the hex ones
+                    char escape[8] = "";
+                    snprintf(escape, sizeof(escape), "\\%03o",
+                             (unsigned)(uint8_t)symbol);
+                    result += escape;
+                } else {
+                    result += symbol;
+                }
+                break;
+        }
+    }
+
+    return result + "\"";
+}
+
+static std::string format_double(double number) {
+    if (isnan(number)) return "std::numeric_limits<double>::quiet_NaN()";
+
+    if (isinf(number)) {
+        return number > 0 ? "std::numeric_limits<double>::infinity()"
+                          : "(-std::numeric_limits<double>::infinity())";
+    }
+
+    // Hexadecimal literals represent the number exactly
+    char buffer[64] = "";
+    snprintf(buffer, sizeof(buffer), "(%a)", number);
+
+    return buffer;
+}
+
+void NativeGenerator::build_dependents() {
+    dependents_.resize(instructions_.size());
+
+    for (uint32_t id = 0; id < (uint32_t)instructions_.size(); ++id) {
+        const std::vector<uint32_t>& inputs = instructions_[id].inputs;
+
+        for (size_t edge = 0; edge < inputs.size(); ++edge) {
+            uint8_t mask = (uint8_t)(1 << edge);
+            std::vector<Dependent>& dependents = dependents_[inputs[edge]];
+
+            // Nodes using an input several times are listed once
+            if (!dependents.empty() && dependents.back().node == id) {
+                dependents.back().mask |= mask;
+            } else {
+                dependents.push_back({id, mask});
+            }
+        }
+    }
+}
+
+void NativeGenerator::emit(const char* format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(nullptr, 0, format, args);
+    va_end(args);
+
+    std::string line((size_t)length, '\0');
+
+    va_start(args, format);
+    vsnprintf(line.data(), line.size() + 1, format, args);
+    va_end(args);
+
+    result_ += line;
+}
+
+std::string NativeGenerator::number(uint32_t node) const {
+    if (is_literal(node)) {
+        return format_double(instructions_[node].value.as_number());
+    }
+
+    return value(node) + ".as_number()";
+}
+
+std::string NativeGenerator::boolean(uint32_t node) const {
+    if (is_literal(node)) {
+        return instructions_[node].value.as_bool() ? "true" : "false";
+    }
+
+    return value(node) + ".as_bool()";
+}
+
+std::string NativeGenerator::generate() {
+    emit("struct %s final : public NativeScript {\n", class_name_.c_str());
+
+    emit_start();
+
+    emit("\n   private:\n");
+
+    for (uint32_t id = 0; id < (uint32_t)instructions_.size(); ++id) {
+        if (instructions_[id].opcode != ScriptOpcode::CONSTANT) {
+            emit_update(id);
+        }
+
+        emit_propagate(id);
+    }
+
+    emit_members();
+
+    emit("};\n");
+
+    return result_;
+}
+
+void NativeGenerator::emit_start() {
+    emit("    void start(Scene& scene,\n"
+         "               const SubcomponentNameMap& name_map) override {\n"
+         "        scene_ = &scene;\n\n");
+
+    for (uint32_t id = 0; id < (uint32_t)instructions_.size(); ++id) {
+        const ScriptInstruction& instruction = instructions_[id];
+        if (!instruction.component) continue;
+
+        emit("        %s = find_component(name_map, %s);\n",
+             value(id).c_str(),
+             escape_string(instruction.value.as_string()).c_str());
+    }
+
+    emit("\n");
+
+    // Constants propagate their values when the script starts
+    for (uint32_t id = 0; id < (uint32_t)instructions_.size(); ++id) {
+        if (instructions_[id].opcode != ScriptOpcode::CONSTANT) continue;
+
+        emit("        propagate_%u();\n", id);
+    }
+
+    emit("    }\n");
+}
+
+void NativeGenerator::emit_members() {
+    emit("\n");
+
+    for (uint32_t id = 0; id < (uint32_t)instructions_.size(); ++id) {
+        const ScriptInstruction& instruction = instructions_[id];
+        const ScriptValue& constant = instruction.value;
+
+        std::string initializer = "{}";
+
+        if (instruction.opcode == ScriptOpcode::CONSTANT &&
+            !instruction.component) {
+            switch (constant.get_type()) {
+                case ScriptValue::Type::NUMBER:
+                    initializer = "{";
+                    initializer.append(format_double(constant.as_number()))
+                        .append("}");
+                    break;
+                case ScriptValue::Type::BOOL:
+                    initializer = constant.as_bool() ? "{true}" : "{false}";
+                    break;
+                case ScriptValue::Type::STRING: {
+                    std::string string = constant.as_string();
+                    initializer = "{std::string(";
+                    initializer.append(escape_string(string))
+                        .append(", ")
+                        .append(std::to_string(string.size()))
+                        .append(")}");
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        emit("    ScriptValue %s%s;\n", value(id).c_str(), initializer.c_str());
+
+        switch (instruction.opcode) {
+            case ScriptOpcode::DETECT_CHANGE:
+                emit("    std::optional<ScriptValue> previous_%u_{};\n", id);
+                break;
+            case ScriptOpcode::OUTPUT_METHOD:
+                emit("    Output output_%u_{"
+                     "SceneComponent::Channel::Listener(\n"
+                     "        [this](const ScriptValue& value) {\n"
+                     "            %s = value;\n"
+                     "            propagate_%u();\n"
+                     "        })};\n",
+                     id, value(id).c_str(), id);
+                break;
+            case ScriptOpcode::INPUT_METHOD:
+                emit("    Input input_%u_{};\n", id);
+                break;
+            default:
+                break;
+        }
+
+        // Channels with constant names are found by symbols hashed during
+        // the compilation
+        bool is_channel = instruction.opcode == ScriptOpcode::OUTPUT_METHOD ||
+                          instruction.opcode == ScriptOpcode::INPUT_METHOD;
+        uint32_t method = is_channel ? instruction.inputs[1] : 0;
+
+        if (is_channel && is_literal(method) &&
+            instructions_[method].value.get_type() ==
+                ScriptValue::Type::STRING) {
+            emit("    static inline const Symbol CHANNEL_%u{StaticName(%s)};\n",
+                 id,
+                 escape_string(instructions_[method].value.as_string())
+                     .c_str());
+        }
+    }
+}
+
+void NativeGenerator::emit_update(uint32_t node) {
+    emit("\n    bool update_%u(uint8_t changed) {\n", node);
+    emit_operation(node);
+    emit("    }\n");
+}
+
+void NativeGenerator::emit_operation(uint32_t node) {
+    const ScriptInstruction& instruction = instructions_[node];
+    const std::vector<uint32_t>& inputs = instruction.inputs;
+
+    std::string result = value(node);
+    const char* target = result.c_str();
+
+    auto input = [this, &inputs](size_t id) { return value(inputs[id]); };
+
+    auto channel = [this, &inputs, node]() {
+        uint32_t method = inputs[1];
+
+        if (is_literal(method) && instructions_[method].value.get_type() ==
+                                      ScriptValue::Type::STRING) {
+            return "CHANNEL_" + std::to_string(node);
+        }
+
+        return value(method);
+    };
+
+    switch (instruction.opcode) {
+        case ScriptOpcode::IS_VALID:
+            emit("        %s = %s.has_value();\n"
+                 "        return true;\n",
+                 target, input(0).c_str());
+            return;
+        case ScriptOpcode::CONDITIONAL:
+            emit("        if (%s.is_none()) {\n"
+                 "            %s = ScriptValue();\n"
+                 "        } else {\n"
+                 "            %s = %s ? %s : %s;\n"
+                 "        }\n\n"
+                 "        return true;\n",
+                 input(0).c_str(), target, target, boolean(inputs[0]).c_str(),
+                 input(1).c_str(), input(2).c_str());
+            return;
+        case ScriptOpcode::DETECT_CHANGE:
+            emit("        if (previous_%u_ == %s) return false;\n\n"
+                 "        previous_%u_ = %s;\n"
+                 "        %s = %s;\n\n"
+                 "        return true;\n",
+                 node, input(0).c_str(), node, input(0).c_str(), target,
+                 input(0).c_str());
+            return;
+        case ScriptOpcode::REQUIRE_VALIDITY:
+            emit("        if (%s.is_none()) return false;\n\n"
+                 "        %s = %s;\n"
+                 "        return true;\n",
+                 input(0).c_str(), target, input(0).c_str());
+            return;
+        case ScriptOpcode::DETECT_SOURCE:
+            emit("        %s = %s;\n"
+                 "        return true;\n",
+                 target, input(0).c_str());
+            return;
+        case ScriptOpcode::OUTPUT_METHOD:
+            emit("        connect_output(output_%u_, %s, %s);\n"
+                 "        return false;\n",
+                 node, input(0).c_str(), channel().c_str());
+            return;
+        case ScriptOpcode::INPUT_METHOD:
+            emit("        // Reconnect if the component or the channel have "
+                 "changed\n"
+                 "        if (changed & 0b011) {\n"
+                 "            connect_input(input_%u_, %s, %s);\n"
+                 "        }\n\n"
+                 "        if (!(changed & 0b100)) return false;\n\n"
+                 "        if (!input_%u_.connected) {\n"
+                 "            connect_input(input_%u_, %s, %s);\n"
+                 "        }\n\n"
+                 "        ScriptValue payload = %s;\n"
+                 "        if (payload.has_value()) "
+                 "input_%u_.output.trigger(payload);\n\n"
+                 "        return true;\n",
+                 node, input(0).c_str(), channel().c_str(), node, node,
+                 input(0).c_str(), channel().c_str(), input(2).c_str(), node);
+            return;
+        default:
+            break;
+    }
+
+    // Arithmetic and logical operations
+    std::string missing{};
+
+    for (size_t id = 0; id < inputs.size(); ++id) {
+        if (is_literal(inputs[id])) continue;
+
+        if (!missing.empty()) missing += " || ";
+        missing += input(id) + ".is_none()";
+    }
+
+    if (!missing.empty()) {
+        emit("        if (%s) {\n"
+             "            %s = ScriptValue();\n"
+             "            return true;\n"
+             "        }\n\n",
+             missing.c_str(), target);
+    }
+
+    uint32_t left = inputs[0];
+    uint32_t right = inputs.size() > 1 ? inputs[1] : left;
+
+    std::string expression{};
+
+    auto binary = [&](const std::string& alpha, const char* operation,
+                      const std::string& beta) {
+        return alpha + " " + operation + " " + beta;
+    };
+
+    switch (instruction.opcode) {
+        case ScriptOpcode::LENGTH:
+            expression = "(double)" + value(left) + ".as_string().length()";
+            break;
+        case ScriptOpcode::EQUAL:
+            expression = value(left) + ".equals(" + value(right) + ")";
+            break;
+        case ScriptOpcode::NOT_EQUAL:
+            expression = "!" + value(left) + ".equals(" + value(right) + ")";
+            break;
+        case ScriptOpcode::GREATER:
+            expression = binary(number(left), ">", number(right));
+            break;
+        case ScriptOpcode::LESS:
+            expression = binary(number(left), "<", number(right));
+            break;
+        case ScriptOpcode::GREATER_OR_EQUAL:
+            expression = binary(number(left), ">=", number(right));
+            break;
+        case ScriptOpcode::LESS_OR_EQUAL:
+            expression = binary(number(left), "<=", number(right));
+            break;
+        case ScriptOpcode::ADD:
+            expression = binary(number(left), "+", number(right));
+            break;
+        case ScriptOpcode::SUBTRACT:
+            expression = binary(number(left), "-", number(right));
+            break;
+        case ScriptOpcode::MULTIPLY:
+            expression = binary(number(left), "*", number(right));
+            break;
+        case ScriptOpcode::DIVIDE:
+            expression = binary(number(left), "/", number(right));
+            break;
+        case ScriptOpcode::NEGATIVE:
+            expression = "-" + number(left);
+            break;
+        case ScriptOpcode::ABSOLUTE:
+            expression = "fabs(" + number(left) + ")";
+            break;
+        case ScriptOpcode::SIGN:
+            expression = "get_sign(" + number(left) + ")";
+            break;
+        case ScriptOpcode::SIN:
+            expression = "sin(" + number(left) + ")";
+            break;
+        case ScriptOpcode::COS:
+            expression = "cos(" + number(left) + ")";
+            break;
+        case ScriptOpcode::LOG_E:
+            expression = "log(" + number(left) + ")";
+            break;
+        case ScriptOpcode::LOG_2:
+            expression = "log2(" + number(left) + ")";
+            break;
+        case ScriptOpcode::LOG_10:
+            expression = "log10(" + number(left) + ")";
+            break;
+        case ScriptOpcode::NOT:
+            expression = "!" + boolean(left);
+            break;
+        case ScriptOpcode::OR:
+            expression = binary(boolean(left), "||", boolean(right));
+            break;
+        case ScriptOpcode::AND:
+            expression = binary(boolean(left), "&&", boolean(right));
+            break;
+        case ScriptOpcode::XOR:
+            expression = binary(boolean(left), "!=", boolean(right));
+            break;
+        default:
+            expression = "ScriptValue()";
+            break;
+    }
+
+    emit("        %s = %s;\n"
+         "        return true;\n",
+         target, expression.c_str());
+}
+
+void NativeGenerator::emit_propagate(uint32_t node) {
+    emit("\n    void propagate_%u() {\n", node);
+
+    for (const Dependent& dependent : dependents_[node]) {
+        emit("        if (update_%u(0b%u%u%u)) propagate_%u();\n",
+             dependent.node, (dependent.mask >> 2) & 1u,
+             (dependent.mask >> 1) & 1u, dependent.mask & 1u, dependent.node);
+    }
+
+    // Source detectors only hold the value while it propagates
+    if (instructions_[node].opcode == ScriptOpcode::DETECT_SOURCE) {
+        emit("        %s = ScriptValue();\n", value(node).c_str());
+    }
+
+    emit("    }\n");
+}
+
+std::string generate_native_scripts(
+    const std::vector<std::pair<std::string, std::string>>& scripts) {
+    std::string result =
+        "// Native level scripts, generated by the script compiler.\n"
+        "// Do not edit.\n\n"
+        "#include <math.h>\n\n"
+        "#include <limits>\n\n"
+        "#include \"logics/blueprints/scripts/native.h\"\n\n"
+        "namespace {\n";
+
+    std::unordered_map<hash_t, size_t> generated{};
+
+    for (const auto& [origin, source] : scripts) {
+        hash_t hash = murmur_hash(source.c_str());
+
+        auto found = generated.find(hash);
+        if (found != generated.end() && found->second == source.size())
+            continue;
+
+        std::shared_ptr<const ScriptImage> image = ScriptImage::compile(source);
+
+        if (!image->is_complete()) {
+            log_printf(WARNINGS, "warning",
+                       "Script from %s has syntax errors and will be "
+                       "interpreted.\n",
+                       origin.c_str());
+            continue;
+        }
+
+        generated.insert({hash, source.size()});
+
+        std::vector<uint32_t> roots{};
+        std::vector<ScriptInstruction> instructions =
+            image->get_instructions(roots);
+
+        char class_name[64] = "";
+        snprintf(class_name, sizeof(class_name), "NativeScript_%016zx", hash);
+
+        // Origins are file names, which should not break the comment
+        std::string description = origin;
+        std::replace(description.begin(), description.end(), '\n', ' ');
+        std::replace(description.begin(), description.end(), '\\', '/');
+
+        result += "\n// Script from " + description + "\n";
+        result += NativeGenerator(instructions, class_name).generate();
+
+        char registration[160] = "";
+        snprintf(registration, sizeof(registration),
+                 "\nNATIVE_SCRIPT(%s, (hash_t)0x%016zxull, %zu);\n",
+                 class_name, hash, source.size());
+
+        result += registration;
+    }
+
+    return result + "\n}  // namespace\n";
+}
@@ -0,0 +1,174 @@
+/**
+ * @file native.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Level scripts compiled to C++ ahead of time
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hash/murmur.h"
+#include "hash/symbol.h"
+#include "logics/blueprints/component_factory.hpp"
+#include "logics/scene_component.h"
+#include "nodes/component_io.h"
+#include "value.h"
+
+/**
+ * @brief Script generated by the script compiler (`generate_native_scripts`),
+ * which implements the dataflow of a script source as C++ code
+ *
+ * Native scripts update the nodes in the same order as a `ScriptProgram` in
+ * the immediate mode. They are registered by the hash of their source, and
+ * compiled scripts with a registered native version use it instead of a
+ * program.
+ *
+ * @warning Native scripts capture their own address in channel listeners, so
+ * they can not be copied or moved
+ */
+struct NativeScript {
+    using Factory = std::unique_ptr<NativeScript> (*)();
+
+    NativeScript() = default;
+
+    NativeScript(const NativeScript&) = delete;
+    NativeScript& operator=(const NativeScript&) = delete;
+    NativeScript(NativeScript&&) = delete;
+    NativeScript& operator=(NativeScript&&) = delete;
+
+    virtual ~NativeScript() = default;
+
+    /**
+     * @brief Bind the script to the scene and propagate the initial values
+     *
+     * @param[in] scene
+     * @param[in] name_map components the script can refer to by name
+     */
+    virtual void start(Scene& scene, const SubcomponentNameMap& name_map) = 0;
+
+    /**
+     * @brief Register a native script
+     *
+     * @param[in] hash `murmur_hash` of the script source
+     * @param[in] size length of the script source
+     * @param[in] factory
+     */
+    static void add(hash_t hash, size_t size, Factory factory);
+
+    /**
+     * @brief Find the native version of the script
+     *
+     * @param[in] source script source
+     * @return Factory - factory of the native script or `nullptr`
+     */
+    static Factory find(const std::string& source);
+
+    /**
+     * @brief Set whether scripts should use their native versions (used to
+     * compare native scripts with the interpreter)
+     *
+     * @param[in] enabled
+     */
+    static void set_enabled(bool enabled) { enabled_ = enabled; }
+    static bool is_enabled() { return enabled_; }
+
+    struct Registration final {
+        Registration(hash_t hash, size_t size, Factory factory) {
+            add(hash, size, factory);
+        }
+    };
+
+   protected:
+    static double get_sign(double value) {
+        return value > 0 ? 1.0 : (value < 0 ? -1.0 : 0.0);
+    }
+
+    struct Output {
+        SceneComponent::Channel::Listener listener;
+        nodes::ChannelBinding binding{};
+    };
+
+    struct Input {
+        SceneComponent::Channel output{};
+        nodes::ChannelBinding binding{};
+        bool connected = false;
+    };
+
+    /**
+     * @brief Get the component constant of the script
+     *
+     * @note Reports an error if the component does not exist
+     *
+     * @param[in] name_map
+     * @param[in] name name of the component
+     * @return ScriptValue
+     */
+    static ScriptValue find_component(const SubcomponentNameMap& name_map,
+                                      const char* name);
+
+    /**
+     * @brief (Re)subscribe the output listener to the channel
+     *
+     * @param[in] output
+     * @param[in] object value referencing the component
+     * @param[in] method name of the channel
+     */
+    void connect_output(Output& output, const ScriptValue& object,
+                        const ScriptValue& method);
+    void connect_output(Output& output, const ScriptValue& object,
+                        Symbol method);
+
+    /**
+     * @brief (Re)connect the pipe to the input channel
+     *
+     * @param[in] input
+     * @param[in] object value referencing the component
+     * @param[in] method name of the channel
+     */
+    void connect_input(Input& input, const ScriptValue& object,
+                       const ScriptValue& method);
+    void connect_input(Input& input, const ScriptValue& object, Symbol method);
+
+    Scene* scene_ = nullptr;
+
+   private:
+    static bool enabled_;
+};
+
+/**
+ * @brief Register a native script class
+ *
+ * @param type class name
+ * @param hash `murmur_hash` of the script source
+ * @param size length of the script source
+ */
+#define NATIVE_SCRIPT(type, hash, size)                                     \
+    static const NativeScript::Registration type##_registration_(           \
+        hash, size, []() -> std::unique_ptr<NativeScript> {                 \
+            return std::make_unique<type>();                                \
+        })
+
+/**
+ * @brief Generate the C++ source of the native versions of the scripts
+ *
+ * @note Scripts with syntax errors are skipped, so that the interpreter
+ * reports the errors when they are loaded
+ *
+ * @param[in] scripts pairs of script origins (used in comments) and sources
+ * @return std::string - source of a translation unit registering the native
+ * scripts
+ */
+std::string generate_native_scripts(
+    const std::vector<std::pair<std::string, std::string>>& scripts);
@@ -11,10 +11,11 @@
 
 #pragma once
 
-#include <optional>
-
 #include "logics/scene.h"
+#include "opcode.h"
 #include "pipelining/event.hpp"
+#include "profile.h"
+#include "value.h"
 
 struct Script::Node {
     using ChildReference = std::shared_ptr<Node>;
@@ -40,9 +41,9 @@ struct Script::Node {
     /**
      * @brief Get the value of the node
      *
-     * @return const std::optional<std::string>&
+     * @return const ScriptValue&
      */
-    const std::optional<std::string>& get_value() const { return value_; }
+    const ScriptValue& get_value() const { return value_; }
 
     /**
      * @brief Check if the node has a valid value
@@ -61,6 +62,31 @@ struct Script::Node {
      */
     void assign_scene(Scene& scene) { scene_ = &scene; }
 
+    /**
+     * @brief Record the updates of the node into the profile
+     *
+     * @param[in] profile profile of the script (or `nullptr` to stop recording)
+     * @param[in] id index of the node in the profile
+     */
+    void set_profile(ScriptProfile* profile, uint32_t id) {
+        profile_ = profile;
+        profile_id_ = id;
+    }
+
+    /**
+     * @brief Set the position of the lexeme the node was parsed from
+     *
+     * @param[in] line
+     * @param[in] column
+     */
+    void set_location(uint32_t line, uint32_t column) {
+        line_ = line;
+        column_ = column;
+    }
+
+    uint32_t get_line() const { return line_; }
+    uint32_t get_column() const { return column_; }
+
     /**
      * @brief Return a string representation of the node
      *
@@ -70,6 +96,22 @@ struct Script::Node {
      */
     virtual std::string debug() const = 0;
 
+    /**
+     * @brief Get the operation the node performs (used to compile the script
+     * into a `ScriptProgram`)
+     *
+     * @return ScriptOpcode
+     */
+    virtual ScriptOpcode get_opcode() const = 0;
+
+    /**
+     * @brief Get the nodes this node is subscribed to, in the order of
+     * subscription
+     *
+     * @return std::vector<ChildReference>
+     */
+    virtual std::vector<ChildReference> get_inputs() const { return {}; }
+
    protected:
     using Update = Event<Node&>;
 
@@ -81,7 +123,8 @@ struct Script::Node {
     Update& get_update_event() { return update_event_; }
 
     /**
-     * @brief Subscribe the node to another node's updates
+     * @brief Subscribe the node to another node's updates (nodes using the
+     * same input several times are subscribed to it once)
      *
      * @param[in] other_node
      */
@@ -98,16 +141,26 @@ struct Script::Node {
      * @brief Trigger the update event of the node
      *
      */
-    void trigger() { update_event_.trigger(*this); }
+    void trigger() {
+        if (profile_) profile_->record_trigger(profile_id_);
+        update_event_.trigger(*this);
+    }
 
-    void set_value(const std::optional<std::string>& value) { value_ = value; }
+    void set_value(const ScriptValue& value) { value_ = value; }
 
    private:
-    std::optional<std::string> value_{};
+    ScriptValue value_{};
 
     Update update_event_{};
 
     Scene* scene_ = nullptr;
 
+    ScriptProfile* profile_ = nullptr;
+    uint32_t profile_id_ = 0;
+
+    uint32_t line_ = 0;
+    uint32_t column_ = 0;
+
     std::vector<Update::Listener> listeners_{};
+    std::vector<const Node*> sources_{};
 };
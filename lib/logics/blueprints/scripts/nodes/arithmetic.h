@@ -18,6 +18,10 @@ namespace nodes {
 struct IsValid : public UnaryNode {
     using UnaryNode::UnaryNode;
 
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::IS_VALID;
+    }
+
     virtual bool update(Node&) override;
 
    protected:
@@ -27,8 +31,11 @@ struct IsValid : public UnaryNode {
 struct Length : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::LENGTH;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "length"; }
@@ -37,8 +44,12 @@ struct Length : public UnaryNode {
 struct Equal : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::EQUAL;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "=="; }
@@ -47,8 +58,12 @@ struct Equal : public BinaryNode {
 struct NotEqual : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::NOT_EQUAL;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "!="; }
@@ -57,8 +72,12 @@ struct NotEqual : public BinaryNode {
 struct Greater : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::GREATER;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return ">"; }
@@ -67,8 +86,12 @@ struct Greater : public BinaryNode {
 struct Less : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::LESS;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "<"; }
@@ -77,8 +100,12 @@ struct Less : public BinaryNode {
 struct GreaterOrEqual : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::GREATER_OR_EQUAL;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return ">="; }
@@ -87,8 +114,12 @@ struct GreaterOrEqual : public BinaryNode {
 struct LessOrEqual : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::LESS_OR_EQUAL;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "<="; }
@@ -97,8 +128,12 @@ struct LessOrEqual : public BinaryNode {
 struct Add : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::ADD;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "+"; }
@@ -107,8 +142,12 @@ struct Add : public BinaryNode {
 struct Subtract : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::SUBTRACT;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "-"; }
@@ -117,8 +156,12 @@ struct Subtract : public BinaryNode {
 struct Multiply : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::MULTIPLY;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "*"; }
@@ -127,8 +170,12 @@ struct Multiply : public BinaryNode {
 struct Divide : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::DIVIDE;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "/"; }
@@ -137,8 +184,11 @@ struct Divide : public BinaryNode {
 struct Negative : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::NEGATIVE;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "-"; }
@@ -147,8 +197,11 @@ struct Negative : public UnaryNode {
 struct Absolute : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::ABSOLUTE;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "abs"; }
@@ -157,8 +210,11 @@ struct Absolute : public UnaryNode {
 struct Sign : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::SIGN;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "sign"; }
@@ -167,8 +223,11 @@ struct Sign : public UnaryNode {
 struct Sin : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::SIN;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "sin"; }
@@ -177,8 +236,11 @@ struct Sin : public UnaryNode {
 struct Cos : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::COS;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "cos"; }
@@ -187,8 +249,11 @@ struct Cos : public UnaryNode {
 struct LogE : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::LOG_E;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "logE"; }
@@ -197,8 +262,11 @@ struct LogE : public UnaryNode {
 struct Log2 : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::LOG_2;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "log2"; }
@@ -207,8 +275,11 @@ struct Log2 : public UnaryNode {
 struct Log10 : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::LOG_10;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "log10"; }
@@ -1,24 +1,67 @@
 #include "component_io.h"
 
-static SceneComponent* node_to_component(const Script::Node::
-                                             ChildReference& node,
-                                         Scene& scene) {
-    std::optional<std::string> string = node->get_value();
+static SceneComponent* value_to_component(const ScriptValue& object,
+                                          Scene& scene) {
+    if (object.is_none()) return nullptr;
 
-    if (!string) return nullptr;
-
-    GUID object_guid = GUID::from_string(string.value());
+    GUID object_guid = object.as_guid();
 
     auto result = scene.get_component(object_guid);
     if (!result) {
         log_printf(WARNINGS, "warning",
                    "Could not find a component with the guid \"%s\".\n",
-                   string.value().c_str());
+                   object_guid.to_string().c_str());
     }
 
     return result;
 }
 
+Symbol nodes::ChannelBinding::resolve(const ScriptValue& method) {
+    if (method.get_type() != ScriptValue::Type::STRING)
+        return Symbol(method.as_string());
+
+    InternedString name = method.get_string();
+
+    if (name != name_) {
+        name_ = name;
+        symbol_ = Symbol(name.str());
+    }
+
+    return symbol_;
+}
+
+SceneComponent::OutputChannel* nodes::
+    find_output(Scene& scene, const ScriptValue& object, Symbol method) {
+    SceneComponent* component = value_to_component(object, scene);
+    if (!component) return nullptr;
+
+    SceneComponent::OutputChannel* channel = component->get_output(method);
+    if (!channel) {
+        log_printf(
+            WARNINGS, "warning",
+            "Component %s does not have an output channel named \"%s\".\n",
+            object.as_string().c_str(), method.get_name().c_str());
+    }
+
+    return channel;
+}
+
+SceneComponent::InputChannel* nodes::
+    find_input(Scene& scene, const ScriptValue& object, Symbol method) {
+    SceneComponent* component = value_to_component(object, scene);
+    if (!component) return nullptr;
+
+    SceneComponent::InputChannel* listener = component->get_input(method);
+    if (!listener) {
+        log_printf(
+            WARNINGS, "warning",
+            "Component %s does not have an input channel named \"%s\".\n",
+            object.as_string().c_str(), method.get_name().c_str());
+    }
+
+    return listener;
+}
+
 nodes::OutputMethod::OutputMethod(ChildReference object, ChildReference method)
     : object_(object), method_(method) {
     subscribe_to(object_);
@@ -30,26 +73,16 @@ bool nodes::OutputMethod::update(Node&) {
 
     assert(scene);
 
-    std::optional<std::string> method_string = method_->get_value();
-    if (!method_string) return false;
+    if (!method_->has_value()) return false;
 
-    SceneComponent* component = node_to_component(object_, *scene);
-    if (!component) return false;
-
-    SceneComponent::
-        Channel* channel = component->get_output(method_string.value());
-    if (!channel) {
-        log_printf(
-            WARNINGS, "warning",
-            "Component %s does not have an output channel named \"%s\".\n",
-            object_->get_value().value_or("NONE").c_str(),
-            method_string->c_str());
-        return false;
-    }
+    SceneComponent::Channel* channel =
+        find_output(*scene, object_->get_value(),
+                    binding_.resolve(method_->get_value()));
+    if (!channel) return false;
 
     update_listener_ = SceneComponent::Channel::
-        Listener([this](const std::string& string) {
-            set_value(string);
+        Listener([this](const ScriptValue& value) {
+            set_value(value);
             trigger();
         });
 
@@ -71,9 +104,7 @@ bool nodes::InputMethod::update(Node& initiator) {
     if (&initiator == value_.get()) {
         if (!connected_) connect();
 
-        std::optional<std::string> string = value_->get_value();
-
-        if (string.has_value()) output_.trigger(string.value());
+        if (value_->has_value()) output_.trigger(value_->get_value());
 
         return true;
     } else {
@@ -89,29 +120,19 @@ void nodes::InputMethod::connect() {
 
     output_ = SceneComponent::Channel();
 
-    std::optional<std::string> method_string = method_->get_value();
-    if (!method_string) return;
+    if (!method_->has_value()) return;
 
-    SceneComponent* component = node_to_component(object_, *scene);
-    if (!component) return;
-
-    SceneComponent::
-        InputChannel* listener = component->get_input(method_string.value());
-    if (!listener) {
-        log_printf(
-            WARNINGS, "warning",
-            "Component %s does not have an input channel named \"%s\".\n",
-            object_->get_value().value_or("NONE").c_str(),
-            method_string->c_str());
-        return;
-    }
+    SceneComponent::InputChannel* listener =
+        find_input(*scene, object_->get_value(),
+                   binding_.resolve(method_->get_value()));
+    if (!listener) return;
 
     output_.subscribe(*listener);
 
     connected_ = true;
 }
 
-nodes::StringConstant::StringConstant(const std::string& value) {
+nodes::StringConstant::StringConstant(const ScriptValue& value) {
     set_value(value);
 }
 
@@ -13,11 +13,33 @@
 
 #include <memory>
 
+#include "hash/interned_string.h"
+#include "hash/symbol.h"
 #include "logics/blueprints/scripts/node.h"
 #include "logics/scene_component.h"
 
 namespace nodes {
 
+/**
+ * @brief Channel name of a script node, converted to a symbol once per name
+ * the node receives instead of on every reconnection
+ *
+ */
+struct ChannelBinding final {
+    /**
+     * @brief Get the symbol of the channel name
+     *
+     * @param[in] method value of the channel name
+     * @return Symbol
+     */
+    Symbol resolve(const ScriptValue& method);
+
+   private:
+    // The default string and the default symbol are both empty
+    InternedString name_{};
+    Symbol symbol_{};
+};
+
 struct OutputMethod : public Script::Node {
     OutputMethod(ChildReference object, ChildReference method);
 
@@ -27,11 +49,20 @@ struct OutputMethod : public Script::Node {
         return "{" + object_->debug() + " . " + method_->debug() + "}";
     }
 
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::OUTPUT_METHOD;
+    }
+
+    virtual std::vector<ChildReference> get_inputs() const override {
+        return {object_, method_};
+    }
+
    private:
     ChildReference object_;
     ChildReference method_;
 
     SceneComponent::Channel::Listener update_listener_{};
+    ChannelBinding binding_{};
 };
 
 struct InputMethod : public Script::Node {
@@ -45,6 +76,14 @@ struct InputMethod : public Script::Node {
                value_->debug() + "}";
     }
 
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::INPUT_METHOD;
+    }
+
+    virtual std::vector<ChildReference> get_inputs() const override {
+        return {object_, method_, value_};
+    }
+
    private:
     void connect();
 
@@ -55,16 +94,49 @@ struct InputMethod : public Script::Node {
     bool connected_ = false;
 
     SceneComponent::Channel output_{};
+    ChannelBinding binding_{};
 };
 
 struct StringConstant : public Script::Node {
-    StringConstant(const std::string& value);
+    StringConstant(const ScriptValue& value);
 
     virtual std::string debug() const override {
-        return "{\"" + get_value().value_or("NOTHING") + "\"}";
+        return "{\"" + get_value().as_string() + "\"}";
+    }
+
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::CONSTANT;
     }
 
     virtual bool update(Node& initiator) override;
 };
 
+/**
+ * @brief Find a component output channel referenced by a script
+ *
+ * @note Reports a warning if the component exists but the channel does not
+ *
+ * @param[in] scene scene to search the component in
+ * @param[in] object value referencing the component
+ * @param[in] method name of the channel
+ * @return SceneComponent::OutputChannel* - the channel or `nullptr`
+ */
+SceneComponent::OutputChannel* find_output(Scene& scene,
+                                           const ScriptValue& object,
+                                           Symbol method);
+
+/**
+ * @brief Find a component input channel referenced by a script
+ *
+ * @note Reports a warning if the component exists but the channel does not
+ *
+ * @param[in] scene scene to search the component in
+ * @param[in] object value referencing the component
+ * @param[in] method name of the channel
+ * @return SceneComponent::InputChannel* - the channel or `nullptr`
+ */
+SceneComponent::InputChannel* find_input(Scene& scene,
+                                         const ScriptValue& object,
+                                         Symbol method);
+
 };  // namespace nodes
@@ -1,7 +1,5 @@
 #include "logical.h"
 
-#include "booleans.h"
-
 nodes::Conditional::Conditional(ChildReference condition,
                                 ChildReference true_child,
                                 ChildReference false_child)
@@ -21,29 +19,28 @@ bool nodes::Conditional::update(Node &) {
     }
 
     ChildReference source =
-        get_bool(*condition_->get_value()) ? true_child_ : false_child_;
+        condition_->get_value().as_bool() ? true_child_ : false_child_;
 
     set_value(source->get_value());
 
     return true;
 }
 
-std::optional<std::string> nodes::LogicalNot::unary_update(
-    const std::string &input) {
-    return to_bool(!get_bool(input));
+ScriptValue nodes::LogicalNot::unary_update(const ScriptValue &input) {
+    return !input.as_bool();
 }
 
-std::optional<std::string> nodes::LogicalOr::binary_update(
-    const std::string &left, const std::string &right) {
-    return to_bool(get_bool(left) || get_bool(right));
+ScriptValue nodes::LogicalOr::binary_update(const ScriptValue &left,
+                                            const ScriptValue &right) {
+    return left.as_bool() || right.as_bool();
 }
 
-std::optional<std::string> nodes::LogicalAnd::binary_update(
-    const std::string &left, const std::string &right) {
-    return to_bool(get_bool(left) && get_bool(right));
+ScriptValue nodes::LogicalAnd::binary_update(const ScriptValue &left,
+                                             const ScriptValue &right) {
+    return left.as_bool() && right.as_bool();
 }
 
-std::optional<std::string> nodes::LogicalXor::binary_update(
-    const std::string &left, const std::string &right) {
-    return to_bool(get_bool(left) != get_bool(right));
+ScriptValue nodes::LogicalXor::binary_update(const ScriptValue &left,
+                                             const ScriptValue &right) {
+    return left.as_bool() != right.as_bool();
 }
@@ -26,6 +26,14 @@ struct Conditional : public Script::Node {
 
     virtual bool update(Node&) override;
 
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::CONDITIONAL;
+    }
+
+    virtual std::vector<ChildReference> get_inputs() const override {
+        return {condition_, true_child_, false_child_};
+    }
+
    private:
     ChildReference condition_;
     ChildReference true_child_;
@@ -35,8 +43,11 @@ struct Conditional : public Script::Node {
 struct LogicalNot : public UnaryNode {
     using UnaryNode::UnaryNode;
 
-    virtual std::optional<std::string> unary_update(const std::
-                                                        string& input) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::NOT;
+    }
+
+    virtual ScriptValue unary_update(const ScriptValue& input) override;
 
    protected:
     virtual const std::string symbol() const override { return "!"; }
@@ -45,8 +56,12 @@ struct LogicalNot : public UnaryNode {
 struct LogicalOr : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::OR;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "or"; }
@@ -55,8 +70,12 @@ struct LogicalOr : public BinaryNode {
 struct LogicalAnd : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::AND;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "and"; }
@@ -65,8 +84,12 @@ struct LogicalAnd : public BinaryNode {
 struct LogicalXor : public BinaryNode {
     using BinaryNode::BinaryNode;
 
-    virtual std::optional<std::string> binary_update(
-        const std::string& left, const std::string& right) override;
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::XOR;
+    }
+
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) override;
 
    protected:
     virtual const std::string symbol() const override { return "xor"; }
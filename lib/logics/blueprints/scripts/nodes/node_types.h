@@ -29,10 +29,14 @@ struct BinaryNode : public Script::Node {
                "}";
     }
 
+    virtual std::vector<ChildReference> get_inputs() const override {
+        return {left_, right_};
+    }
+
    protected:
-    virtual std::optional<std::string> binary_update(const std::string& left,
-                                                     const std::string& right) {
-        return "";
+    virtual ScriptValue binary_update(const ScriptValue& left,
+                                      const ScriptValue& right) {
+        return ScriptValue();
     }
 
     /**
@@ -55,6 +59,10 @@ struct UnaryNode : public Script::Node {
 
     virtual bool update(Node&) override;
 
+    virtual std::vector<ChildReference> get_inputs() const override {
+        return {value_};
+    }
+
    protected:
     /**
      * @brief Symbol used for debug string representation
@@ -63,8 +71,8 @@ struct UnaryNode : public Script::Node {
      */
     virtual const std::string symbol() const = 0;
 
-    virtual std::optional<std::string> unary_update(const std::string& input) {
-        return "";
+    virtual ScriptValue unary_update(const ScriptValue& input) {
+        return ScriptValue();
     }
 
     ChildReference value_;
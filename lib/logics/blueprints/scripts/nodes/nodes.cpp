@@ -0,0 +1,72 @@
+#include "nodes.h"
+
+Script::Node* nodes::create(ScriptOpcode opcode,
+                            const std::vector<Script::Node::ChildReference>& in,
+                            const ScriptValue& constant) {
+    switch (opcode) {
+        case ScriptOpcode::CONSTANT:
+            return new StringConstant(constant);
+        case ScriptOpcode::IS_VALID:
+            return new IsValid(in[0]);
+        case ScriptOpcode::LENGTH:
+            return new Length(in[0]);
+        case ScriptOpcode::EQUAL:
+            return new Equal(in[0], in[1]);
+        case ScriptOpcode::NOT_EQUAL:
+            return new NotEqual(in[0], in[1]);
+        case ScriptOpcode::GREATER:
+            return new Greater(in[0], in[1]);
+        case ScriptOpcode::LESS:
+            return new Less(in[0], in[1]);
+        case ScriptOpcode::GREATER_OR_EQUAL:
+            return new GreaterOrEqual(in[0], in[1]);
+        case ScriptOpcode::LESS_OR_EQUAL:
+            return new LessOrEqual(in[0], in[1]);
+        case ScriptOpcode::ADD:
+            return new Add(in[0], in[1]);
+        case ScriptOpcode::SUBTRACT:
+            return new Subtract(in[0], in[1]);
+        case ScriptOpcode::MULTIPLY:
+            return new Multiply(in[0], in[1]);
+        case ScriptOpcode::DIVIDE:
+            return new Divide(in[0], in[1]);
+        case ScriptOpcode::NEGATIVE:
+            return new Negative(in[0]);
+        case ScriptOpcode::ABSOLUTE:
+            return new Absolute(in[0]);
+        case ScriptOpcode::SIGN:
+            return new Sign(in[0]);
+        case ScriptOpcode::SIN:
+            return new Sin(in[0]);
+        case ScriptOpcode::COS:
+            return new Cos(in[0]);
+        case ScriptOpcode::LOG_E:
+            return new LogE(in[0]);
+        case ScriptOpcode::LOG_2:
+            return new Log2(in[0]);
+        case ScriptOpcode::LOG_10:
+            return new Log10(in[0]);
+        case ScriptOpcode::NOT:
+            return new LogicalNot(in[0]);
+        case ScriptOpcode::OR:
+            return new LogicalOr(in[0], in[1]);
+        case ScriptOpcode::AND:
+            return new LogicalAnd(in[0], in[1]);
+        case ScriptOpcode::XOR:
+            return new LogicalXor(in[0], in[1]);
+        case ScriptOpcode::CONDITIONAL:
+            return new Conditional(in[0], in[1], in[2]);
+        case ScriptOpcode::DETECT_CHANGE:
+            return new DetectChange(in[0]);
+        case ScriptOpcode::REQUIRE_VALIDITY:
+            return new RequireValidity(in[0]);
+        case ScriptOpcode::DETECT_SOURCE:
+            return new DetectSource(in[0]);
+        case ScriptOpcode::OUTPUT_METHOD:
+            return new OutputMethod(in[0], in[1]);
+        case ScriptOpcode::INPUT_METHOD:
+            return new InputMethod(in[0], in[1], in[2]);
+        default:
+            return nullptr;
+    }
+}
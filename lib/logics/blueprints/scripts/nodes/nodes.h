@@ -15,3 +15,19 @@
 #include "component_io.h"
 #include "logical.h"
 #include "update_suppression.h"
+
+namespace nodes {
+
+/**
+ * @brief Create a node performing the operation
+ *
+ * @param[in] opcode
+ * @param[in] inputs inputs of the node, in the order of `Node::get_inputs()`
+ * @param[in] constant value of the node if it is a constant
+ * @return Script::Node* - the node or `nullptr` if the opcode is unknown
+ */
+Script::Node* create(ScriptOpcode opcode,
+                     const std::vector<Script::Node::ChildReference>& inputs,
+                     const ScriptValue& constant = {});
+
+};  // namespace nodes
@@ -23,7 +23,7 @@ nodes::RequireValidity::RequireValidity(ChildReference value) : value_(value) {
 bool nodes::RequireValidity::update(Node &) {
     auto current = value_->get_value();
 
-    if (!current) return false;
+    if (current.is_none()) return false;
 
     set_value(current);
 
@@ -24,11 +24,19 @@ struct DetectChange : public Script::Node {
         return "{CHANGE " + value_->debug() + "}";
     }
 
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::DETECT_CHANGE;
+    }
+
+    virtual std::vector<ChildReference> get_inputs() const override {
+        return {value_};
+    }
+
    private:
     ChildReference value_;
 
-    std::optional<std::string> previous_value_ =
-        "__QUACKING_ABSOLUTELY_IMPOSSIBLE_STRING__";
+    // Empty until the first update, so that the first value always passes
+    std::optional<ScriptValue> previous_value_{};
 };
 
 struct RequireValidity : public Script::Node {
@@ -40,6 +48,14 @@ struct RequireValidity : public Script::Node {
         return "{VALIDITY " + value_->debug() + "}";
     }
 
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::REQUIRE_VALIDITY;
+    }
+
+    virtual std::vector<ChildReference> get_inputs() const override {
+        return {value_};
+    }
+
    private:
     ChildReference value_;
 };
@@ -53,6 +69,14 @@ struct DetectSource : public Script::Node {
         return "{SOURCE " + value_->debug() + "}";
     }
 
+    virtual ScriptOpcode get_opcode() const override {
+        return ScriptOpcode::DETECT_SOURCE;
+    }
+
+    virtual std::vector<ChildReference> get_inputs() const override {
+        return {value_};
+    }
+
    private:
     ChildReference value_;
 };
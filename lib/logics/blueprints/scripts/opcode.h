@@ -0,0 +1,59 @@
+/**
+ * @file opcode.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Script instruction codes
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+
+/**
+ * @brief Operation performed by a script node (one per node type)
+ *
+ */
+enum class ScriptOpcode : uint8_t {
+    CONSTANT,
+
+    IS_VALID,
+    LENGTH,
+
+    EQUAL,
+    NOT_EQUAL,
+    GREATER,
+    LESS,
+    GREATER_OR_EQUAL,
+    LESS_OR_EQUAL,
+
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+
+    NEGATIVE,
+    ABSOLUTE,
+    SIGN,
+    SIN,
+    COS,
+    LOG_E,
+    LOG_2,
+    LOG_10,
+
+    NOT,
+    OR,
+    AND,
+    XOR,
+    CONDITIONAL,
+
+    DETECT_CHANGE,
+    REQUIRE_VALIDITY,
+    DETECT_SOURCE,
+
+    OUTPUT_METHOD,
+    INPUT_METHOD,
+};
@@ -0,0 +1,153 @@
+#include "optimizer.h"
+
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "logger/metrics.h"
+#include "nodes/nodes.h"
+
+static bool is_pure(ScriptOpcode opcode) {
+    switch (opcode) {
+        case ScriptOpcode::CONSTANT:
+        case ScriptOpcode::DETECT_CHANGE:
+        case ScriptOpcode::REQUIRE_VALIDITY:
+        case ScriptOpcode::DETECT_SOURCE:
+        case ScriptOpcode::OUTPUT_METHOD:
+        case ScriptOpcode::INPUT_METHOD:
+            return false;
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Evaluate a pure instruction with constant inputs using the node
+ * implementing it, so that folded values match the values nodes produce
+ *
+ */
+static ScriptValue fold(const ScriptInstruction& instruction,
+                        const std::vector<ScriptInstruction>& instructions) {
+    std::vector<Script::Node::ChildReference> inputs{};
+
+    for (uint32_t input : instruction.inputs) {
+        inputs.emplace_back(nodes::create(ScriptOpcode::CONSTANT, {},
+                                          instructions[input].value));
+    }
+
+    std::shared_ptr<Script::Node> node(
+        nodes::create(instruction.opcode, inputs));
+    node->update(*node);
+
+    return node->get_value();
+}
+
+/**
+ * @brief Get a key equal for the instructions computing the same value
+ *
+ */
+static std::string get_key(const ScriptInstruction& instruction) {
+    std::string key{};
+
+    auto append = [&key](const void* data, size_t size) {
+        key.append((const char*)data, size);
+    };
+
+    ScriptValue::Type type = instruction.value.get_type();
+
+    append(&instruction.opcode, sizeof(instruction.opcode));
+    append(&instruction.component, sizeof(instruction.component));
+    append(&type, sizeof(type));
+
+    for (uint32_t input : instruction.inputs) append(&input, sizeof(input));
+
+    if (type == ScriptValue::Type::STRING) {
+        key += instruction.value.as_string();
+    } else if (type != ScriptValue::Type::NONE) {
+        double number = instruction.value.as_number();
+        append(&number, sizeof(number));
+    }
+
+    return key;
+}
+
+void optimize_script(std::vector<ScriptInstruction>& instructions,
+                     std::vector<uint32_t>& roots) {
+    static Counter& removed = Metrics::get_counter("script_nodes_optimized");
+
+    std::vector<ScriptInstruction> result{};
+    result.reserve(instructions.size());
+
+    // New indices of the instructions
+    std::vector<uint32_t> replacements(instructions.size());
+
+    std::unordered_map<std::string, uint32_t> known{};
+
+    for (size_t id = 0; id < instructions.size(); ++id) {
+        ScriptInstruction instruction = std::move(instructions[id]);
+
+        bool constant_inputs = true;
+
+        for (uint32_t& input : instruction.inputs) {
+            input = replacements[input];
+
+            const ScriptInstruction& source = result[input];
+            if (source.opcode != ScriptOpcode::CONSTANT || source.component) {
+                constant_inputs = false;
+            }
+        }
+
+        if (constant_inputs && is_pure(instruction.opcode)) {
+            instruction.value = fold(instruction, result);
+            instruction.opcode = ScriptOpcode::CONSTANT;
+            instruction.inputs.clear();
+        }
+
+        if (instruction.opcode != ScriptOpcode::INPUT_METHOD) {
+            auto [found, inserted] =
+                known.insert({get_key(instruction), (uint32_t)result.size()});
+
+            if (!inserted) {
+                replacements[id] = found->second;
+                continue;
+            }
+        }
+
+        replacements[id] = (uint32_t)result.size();
+        result.push_back(std::move(instruction));
+    }
+
+    for (uint32_t& root : roots) root = replacements[root];
+
+    // Remove the instructions the roots do not depend on
+    std::vector<bool> used(result.size(), false);
+    for (uint32_t root : roots) used[root] = true;
+
+    for (size_t id = result.size(); id-- > 0;) {
+        if (!used[id]) continue;
+
+        for (uint32_t input : result[id].inputs) used[input] = true;
+    }
+
+    size_t count = 0;
+
+    for (size_t id = 0; id < result.size(); ++id) {
+        if (!used[id]) continue;
+
+        replacements[id] = (uint32_t)count;
+
+        for (uint32_t& input : result[id].inputs) input = replacements[input];
+
+        if (count != id) result[count] = std::move(result[id]);
+        ++count;
+    }
+
+    result.resize(count);
+
+    for (uint32_t& root : roots) root = replacements[root];
+
+    removed.add(instructions.size() - result.size());
+
+    instructions = std::move(result);
+}
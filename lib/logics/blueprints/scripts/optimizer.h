@@ -0,0 +1,53 @@
+/**
+ * @file optimizer.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Script optimization pass
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+
+#include <vector>
+
+#include "opcode.h"
+#include "value.h"
+
+/**
+ * @brief Script node in a flat form, referring to its inputs by index
+ *
+ */
+struct ScriptInstruction {
+    ScriptOpcode opcode = ScriptOpcode::CONSTANT;
+
+    // Value of a constant (constants referring to components hold the name of
+    // the component)
+    ScriptValue value{};
+    bool component = false;
+
+    std::vector<uint32_t> inputs{};
+
+    // Position of the lexeme the instruction was parsed from (merged
+    // instructions keep the position of the first of them)
+    uint32_t line = 0;
+    uint32_t column = 0;
+};
+
+/**
+ * @brief Fold constant subexpressions, merge identical subexpressions and
+ * remove the instructions the roots do not depend on
+ *
+ * @note Pipes (`INPUT_METHOD`) are never merged, as each of them sends its
+ * own updates
+ *
+ * @param[inout] instructions instructions in topological order (inputs
+ * precede the instructions depending on them), the order is preserved
+ * @param[inout] roots indices of the root instructions
+ */
+void optimize_script(std::vector<ScriptInstruction>& instructions,
+                     std::vector<uint32_t>& roots);
@@ -11,67 +11,125 @@
 
 #pragma once
 
-#include <string.h>
+#include <inttypes.h>
+#include <stddef.h>
 
-#include <functional>
-#include <memory>
-#include <optional>
-#include <sstream>
+#include <array>
 #include <string>
+#include <string_view>
+#include <vector>
 
-#include "memory/abstract_holder.hpp"
 #include "templates/strings.h"
 
-struct Lexeme {
-    virtual ~Lexeme() = default;
-
-    using LexemePtr = Abstract<Lexeme>;
-
-    using Constructor =
-        std::function<std::optional<LexemePtr>(std::string_view&)>;
+enum class LexemeKind : uint8_t {
+    STRING,
+    NAMED_COMPONENT,
+
+    ASSIGNMENT_LEFT,
+    ASSIGNMENT_RIGHT,
+    ACCESS,
+
+    EQUAL,
+    NOT_EQUAL,
+    OR,
+    AND,
+    NOT,
+    CONDITIONAL_LEFT,
+    CONDITIONAL_RIGHT,
+
+    MACRO_ASSIGNMENT,
+
+    LESS,
+    GREATER,
+    LESS_EQ,
+    GREATER_EQ,
+
+    PLUS,
+    MINUS,
+    DIVIDE,
+    MULTIPLY,
+    POWER,
+
+    SINE,
+    COSINE,
+    LN,
+    LOG2,
+    LOG10,
+    ABSOLUTE,
+    SIGN,
+    LENGTH,
+    SKIP_INVALID,
+    VALID,
+
+    BRACKET_ROUND_OP,
+    BRACKET_ROUND_CL,
+    BRACKET_SQUARE_OP,
+    BRACKET_SQUARE_CL,
+    BRACKET_CURLY_OP,
+    BRACKET_CURLY_CL,
+};
 
-    static std::optional<LexemePtr> try_construct(std::string_view&) {
-        return {};
-    }
+/**
+ * @brief Lexeme of a script: its kind and the part of the source it spans
+ *
+ */
+struct Lexeme final {
+    LexemeKind kind = LexemeKind::STRING;
 
-    void assign_coords(size_t line, size_t column) {
-        line_ = line, column_ = column;
-    }
+    // Whether the string was quoted (and so is never a number or a variable)
+    bool exact = false;
 
-    size_t get_line() const { return line_; }
-    size_t get_column() const { return column_; }
+    // Span of the lexeme value in the source text (without the quotes of exact
+    // strings and the '@' of named components)
+    uint32_t offset = 0;
+    uint32_t length = 0;
 
-    virtual std::string dump() const = 0;
+    uint32_t line = 0;
+    uint32_t column = 0;
 
-   private:
-    size_t line_ = 0;
-    size_t column_ = 0;
+    template <class T>
+    bool is() const {
+        return kind == T::KIND;
+    }
 };
 
-template <StringLiteral... Values>
-struct StrictLexeme : public Lexeme {
-    static std::optional<LexemePtr> try_construct(std::string_view& view) {
-        return (compare_and_shift(view, Values.value) || ...)
-                   ? LexemePtr(new StrictLexeme<Values...>())
-                   : std::optional<LexemePtr>();
-    }
+/**
+ * @brief Contiguous sequence of lexemes and the source text they refer to
+ *
+ */
+struct LexemeBuffer final {
+    std::string source{};
+    std::vector<Lexeme> lexemes{};
 
-    virtual std::string dump() const override;
+    // Whether the whole source was split into lexemes
+    bool complete = false;
 
-   private:
-    static bool compare_and_shift(std::string_view& view,
-                                  const char* sequence) {
-        if (!view.starts_with(sequence)) return false;
+    std::string_view get_text(const Lexeme& lexeme) const {
+        return std::string_view(source).substr(lexeme.offset, lexeme.length);
+    }
 
-        view.remove_prefix(strlen(sequence));
+    /**
+     * @brief Get the value of a string lexeme with escape sequences resolved
+     *
+     * @param[in] lexeme
+     * @return std::string
+     */
+    std::string get_string(const Lexeme& lexeme) const;
+};
 
-        return true;
-    }
+template <LexemeKind Kind>
+struct LexemeTag {
+    static constexpr LexemeKind KIND = Kind;
 };
 
-template <StringLiteral... Values>
-inline std::string StrictLexeme<Values...>::dump() const {
-    std::stringstream stream;
-    (stream << ... << Values.value);
-    return stream.str();
-}
+/**
+ * @brief Lexeme with fixed spellings
+ *
+ * @tparam Kind
+ * @tparam Values spellings of the lexeme
+ */
+template <LexemeKind Kind, StringLiteral... Values>
+struct StrictLexeme : public LexemeTag<Kind> {
+    static constexpr std::array<const char*, sizeof...(Values)> SPELLINGS = {
+        Values.value...};
+};
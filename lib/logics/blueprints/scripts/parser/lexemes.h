@@ -11,12 +11,7 @@
 
 #pragma once
 
-#include <functional>
-#include <vector>
-
 #include "lexeme.h"
 #include "lexemes/brackets.h"
 #include "lexemes/operators.h"
 #include "lexemes/strings.h"
-
-extern const std::vector<Lexeme::Constructor> LEXEME_CONSTRUCTORS;
@@ -15,13 +15,13 @@
 
 namespace lexemes {
 
-using BracketRoundOp = StrictLexeme<"(">;
-using BracketRoundCl = StrictLexeme<")">;
+using BracketRoundOp = StrictLexeme<LexemeKind::BRACKET_ROUND_OP, "(">;
+using BracketRoundCl = StrictLexeme<LexemeKind::BRACKET_ROUND_CL, ")">;
 
-using BracketSquareOp = StrictLexeme<"[">;
-using BracketSquareCl = StrictLexeme<"]">;
+using BracketSquareOp = StrictLexeme<LexemeKind::BRACKET_SQUARE_OP, "[">;
+using BracketSquareCl = StrictLexeme<LexemeKind::BRACKET_SQUARE_CL, "]">;
 
-using BracketCurlyOp = StrictLexeme<"{">;
-using BracketCurlyCl = StrictLexeme<"}">;
+using BracketCurlyOp = StrictLexeme<LexemeKind::BRACKET_CURLY_OP, "{">;
+using BracketCurlyCl = StrictLexeme<LexemeKind::BRACKET_CURLY_CL, "}">;
 
 };  // namespace lexemes
\ No newline at end of file
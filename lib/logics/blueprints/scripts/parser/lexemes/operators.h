@@ -15,43 +15,41 @@
 
 namespace lexemes {
 
-using AssignmentLeft  = StrictLexeme<"::", "->">;
-using AssignmentRight = StrictLexeme<"<-">;
-using Access          = StrictLexeme<".">;
-
-using Equal            = StrictLexeme<"==">;
-using NotEqual         = StrictLexeme<"!=">;
-using Or               = StrictLexeme<"||", "or">;
-using And              = StrictLexeme<"&&", "and">;
-using Not              = StrictLexeme<"!", "not">;
-using ConditionalLeft  = StrictLexeme<"?">;
-using ConditionalRight = StrictLexeme<":">;
-
-using MacroAssignment = StrictLexeme<"=">;
-
-using Less         = StrictLexeme<"<">;
-using Greater      = StrictLexeme<">">;
-using LessEq       = StrictLexeme<"<=">;
-using GreaterEq    = StrictLexeme<">=">;
-using AlphaLess    = StrictLexeme<"#<">;
-using AlphaGreater = StrictLexeme<"#>">;
-
-using Plus     = StrictLexeme<"+">;
-using Minus    = StrictLexeme<"-">;
-using Divide   = StrictLexeme<"/">;
-using Multiply = StrictLexeme<"*">;
-using Power    = StrictLexeme<"^">;
-
-using Sine        = StrictLexeme<"sin">;
-using Cosine      = StrictLexeme<"cos">;
-using Ln          = StrictLexeme<"ln", "loge">;
-using Log2        = StrictLexeme<"log2">;
-using Log10       = StrictLexeme<"log10">;
-using Absolute    = StrictLexeme<"abs">;
-using Sign        = StrictLexeme<"sign">;
-using Length      = StrictLexeme<"len">;
-using SkipInvalid = StrictLexeme<"skip_invalid">;
-
-using Valid = StrictLexeme<"valid">;
+using AssignmentLeft  = StrictLexeme<LexemeKind::ASSIGNMENT_LEFT, "::", "->">;
+using AssignmentRight = StrictLexeme<LexemeKind::ASSIGNMENT_RIGHT, "<-">;
+using Access          = StrictLexeme<LexemeKind::ACCESS, ".">;
+
+using Equal            = StrictLexeme<LexemeKind::EQUAL, "==">;
+using NotEqual         = StrictLexeme<LexemeKind::NOT_EQUAL, "!=">;
+using Or               = StrictLexeme<LexemeKind::OR, "||", "or">;
+using And              = StrictLexeme<LexemeKind::AND, "&&", "and">;
+using Not              = StrictLexeme<LexemeKind::NOT, "!", "not">;
+using ConditionalLeft  = StrictLexeme<LexemeKind::CONDITIONAL_LEFT, "?">;
+using ConditionalRight = StrictLexeme<LexemeKind::CONDITIONAL_RIGHT, ":">;
+
+using MacroAssignment = StrictLexeme<LexemeKind::MACRO_ASSIGNMENT, "=">;
+
+using Less         = StrictLexeme<LexemeKind::LESS, "<">;
+using Greater      = StrictLexeme<LexemeKind::GREATER, ">">;
+using LessEq       = StrictLexeme<LexemeKind::LESS_EQ, "<=">;
+using GreaterEq    = StrictLexeme<LexemeKind::GREATER_EQ, ">=">;
+
+using Plus     = StrictLexeme<LexemeKind::PLUS, "+">;
+using Minus    = StrictLexeme<LexemeKind::MINUS, "-">;
+using Divide   = StrictLexeme<LexemeKind::DIVIDE, "/">;
+using Multiply = StrictLexeme<LexemeKind::MULTIPLY, "*">;
+using Power    = StrictLexeme<LexemeKind::POWER, "^">;
+
+using Sine        = StrictLexeme<LexemeKind::SINE, "sin">;
+using Cosine      = StrictLexeme<LexemeKind::COSINE, "cos">;
+using Ln          = StrictLexeme<LexemeKind::LN, "ln", "loge">;
+using Log2        = StrictLexeme<LexemeKind::LOG2, "log2">;
+using Log10       = StrictLexeme<LexemeKind::LOG10, "log10">;
+using Absolute    = StrictLexeme<LexemeKind::ABSOLUTE, "abs">;
+using Sign        = StrictLexeme<LexemeKind::SIGN, "sign">;
+using Length      = StrictLexeme<LexemeKind::LENGTH, "len">;
+using SkipInvalid = StrictLexeme<LexemeKind::SKIP_INVALID, "skip_invalid">;
+
+using Valid = StrictLexeme<LexemeKind::VALID, "valid">;
 
 };  // namespace lexemes
@@ -11,44 +11,14 @@
 
 #pragma once
 
-#include "hash/guid.h"
 #include "logics/blueprints/scripts/parser/lexeme.h"
 
 namespace lexemes {
 
-struct String : public Lexeme {
-    String(const std::string& value, bool exact)
-        : value_(value), exact_(exact) {}
+// Identifier, number or quoted string ("exact" lexemes)
+using String = LexemeTag<LexemeKind::STRING>;
 
-    static std::optional<LexemePtr> try_construct(std::string_view& view);
+// Name of a component, prefixed with '@'
+using NamedComponent = LexemeTag<LexemeKind::NAMED_COMPONENT>;
 
-    std::string get_value() const { return value_; }
-    bool        is_exact() const { return exact_; }
-
-    virtual std::string dump() const override;
-
-   private:
-    std::string value_;
-
-    bool exact_;
-};
-
-struct NamedComponent : public Lexeme {
-    NamedComponent(const std::string& name) : name_(name) {}
-
-    static std::optional<LexemePtr> try_construct(std::string_view& view);
-
-    std::string get_name() const { return name_; }
-    GUID        get_guid() const { return guid_; }
-
-    void set_guid(const GUID& guid) { guid_ = guid; }
-
-    virtual std::string dump() const override;
-
-   private:
-    std::string name_;
-
-    GUID guid_{};
-};
-
-};  // namespace lexemes
\ No newline at end of file
+};  // namespace lexemes
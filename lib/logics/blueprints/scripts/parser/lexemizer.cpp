@@ -2,74 +2,286 @@
 
 #include "logger/logger.h"
 
-static void remove_whitespace(std::string_view& view) {
-    bool has_changes = false;
+enum CharClass : uint8_t {
+    CHAR_SPACE = 1 << 0,
+    CHAR_WORD = 1 << 1,
+    CHAR_DIGIT = 1 << 2,
+};
 
-    do {
-        has_changes = false;
+static constexpr std::array<uint8_t, 256> build_char_classes() {
+    std::array<uint8_t, 256> classes{};
 
-        while (!view.empty() && std::isspace(view[0])) {
-            has_changes = true;
-            view.remove_prefix(1);
+    for (const char* space = " \t\n\v\f\r"; *space; ++space) {
+        classes[(uint8_t)*space] = CHAR_SPACE;
+    }
+
+    for (size_t symbol = 'a'; symbol <= 'z'; ++symbol) {
+        classes[symbol] = CHAR_WORD;
+    }
+    for (size_t symbol = 'A'; symbol <= 'Z'; ++symbol) {
+        classes[symbol] = CHAR_WORD;
+    }
+    for (size_t symbol = '0'; symbol <= '9'; ++symbol) {
+        classes[symbol] = CHAR_WORD | CHAR_DIGIT;
+    }
+
+    classes['_'] = CHAR_WORD;
+
+    return classes;
+}
+
+static constexpr std::array<uint8_t, 256> CHAR_CLASSES = build_char_classes();
+
+/**
+ * @brief Trie of the fixed lexeme spellings, walked as a DFA
+ *
+ */
+struct SpellingAutomaton final {
+    static constexpr size_t MAX_STATES = 128;
+    static constexpr size_t ALPHABET = 128;
+
+    // Transitions by ASCII characters (state 0 is the root, so 0 also means
+    // that there is no transition)
+    uint8_t next[MAX_STATES][ALPHABET] = {};
+
+    // Kinds of the lexemes spelled by the paths to the accepting states
+    LexemeKind kinds[MAX_STATES] = {};
+    bool accepting[MAX_STATES] = {};
+
+    size_t state_count = 1;
+    bool overflow = false;
+
+    template <class... Lexemes>
+    static constexpr SpellingAutomaton build() {
+        SpellingAutomaton automaton{};
+
+        (automaton.add_all(Lexemes::SPELLINGS, Lexemes::KIND), ...);
+
+        return automaton;
+    }
+
+    /**
+     * @brief Find the longest spelling the text starts with
+     *
+     * @param[in] text
+     * @param[in] size length of the text
+     * @param[out] kind kind of the lexeme found
+     * @return size_t - length of the spelling (0 if there is none)
+     */
+    size_t match(const char* text, size_t size, LexemeKind& kind) const {
+        size_t state = 0, result = 0;
+
+        for (size_t id = 0; id < size; ++id) {
+            uint8_t symbol = (uint8_t)text[id];
+            if (symbol >= ALPHABET) break;
+
+            state = next[state][symbol];
+            if (state == 0) break;
+
+            if (accepting[state]) {
+                kind = kinds[state];
+                result = id + 1;
+            }
         }
 
-        if (view.starts_with("//") || view.starts_with("#")) {
-            has_changes = true;
-            while (!view.empty() && view[0] != '\n') view.remove_prefix(1);
+        return result;
+    }
+
+   private:
+    template <size_t N>
+    constexpr void add_all(const std::array<const char*, N>& spellings,
+                           LexemeKind kind) {
+        for (const char* spelling : spellings) add(spelling, kind);
+    }
+
+    constexpr void add(const char* spelling, LexemeKind kind) {
+        size_t state = 0;
+
+        for (; *spelling; ++spelling) {
+            uint8_t& transition = next[state][(uint8_t)*spelling];
+
+            if (transition == 0) {
+                if (state_count == MAX_STATES) {
+                    overflow = true;
+                    return;
+                }
+
+                transition = (uint8_t)state_count++;
+            }
+
+            state = transition;
         }
-    } while (has_changes);
-}
 
-static std::optional<Lexeme::LexemePtr> lexeme_lookup(std::string_view& view) {
-    for (auto probe : LEXEME_CONSTRUCTORS) {
-        auto lexeme = probe(view);
+        kinds[state] = kind;
+        accepting[state] = true;
+    }
+};
+
+// `Valid` is not a part of the language yet, so "valid" is lexed as a string
+static constexpr SpellingAutomaton AUTOMATON = SpellingAutomaton::build<
+    lexemes::AssignmentLeft, lexemes::AssignmentRight, lexemes::Access,
+    lexemes::Equal, lexemes::NotEqual, lexemes::Or, lexemes::And, lexemes::Not,
+    lexemes::ConditionalLeft, lexemes::ConditionalRight,
+    lexemes::MacroAssignment, lexemes::Less, lexemes::Greater, lexemes::LessEq,
+    lexemes::GreaterEq, lexemes::Plus, lexemes::Minus, lexemes::Divide,
+    lexemes::Multiply, lexemes::Power, lexemes::Sine, lexemes::Cosine,
+    lexemes::Ln, lexemes::Log2, lexemes::Log10, lexemes::Absolute,
+    lexemes::Sign, lexemes::Length, lexemes::SkipInvalid,
+    lexemes::BracketRoundOp, lexemes::BracketRoundCl, lexemes::BracketSquareOp,
+    lexemes::BracketSquareCl, lexemes::BracketCurlyOp,
+    lexemes::BracketCurlyCl>();
+
+static_assert(!AUTOMATON.overflow, "Too many lexeme spellings");
 
-        if (lexeme) return lexeme;
+/**
+ * @brief Get the length of the identifier or the number the text starts with
+ * (letters, digits and '_', and '.' while the word only has digits)
+ *
+ */
+static size_t word_length(const char* text, size_t size) {
+    size_t length = 0;
+    bool only_numeric = true;
+
+    for (; length < size; ++length) {
+        uint8_t symbol_class = CHAR_CLASSES[(uint8_t)text[length]];
+
+        if (!(symbol_class & CHAR_WORD) &&
+            !(only_numeric && length > 0 && text[length] == '.'))
+            break;
+
+        if (!(symbol_class & CHAR_DIGIT)) only_numeric = false;
     }
 
-    return {};
+    return length;
 }
 
-static void update_position(const char* start, const std::string_view& view,
-                            size_t& line, size_t& column, size_t& index) {
-    size_t new_index = uintptr_t(view.data()) - uintptr_t(start);
+static size_t skip_separators(const char* text, size_t size, size_t position,
+                              uint32_t& line, size_t& line_start) {
+    while (position < size) {
+        char current = text[position];
 
-    for (; index < new_index; ++index) {
-        if (start[index] == '\n') {
-            column = 0;
+        if (current == '#' ||
+            (current == '/' && position + 1 < size &&
+             text[position + 1] == '/')) {
+            while (position < size && text[position] != '\n') ++position;
+            continue;
+        }
+
+        if (!(CHAR_CLASSES[(uint8_t)current] & CHAR_SPACE)) break;
+
+        if (current == '\n') {
             ++line;
-        } else {
-            ++column;
+            line_start = position + 1;
         }
+
+        ++position;
     }
+
+    return position;
 }
 
-std::vector<Lexeme::LexemePtr> lexify(const std::string& text) {
-    std::vector<Lexeme::LexemePtr> result;
+LexemeBuffer lexify(const std::string& text) {
+    LexemeBuffer buffer{};
+    buffer.source = text;
+
+    const char* source = buffer.source.data();
+    size_t size = buffer.source.size();
 
-    std::string_view view(text);
+    buffer.lexemes.reserve(size / 4);
 
-    size_t current_line = 0, current_column = 0, current_index = 0;
-    remove_whitespace(view);
+    size_t position = 0, line_start = 0;
+    uint32_t line = 0;
 
-    while (!view.empty()) {
-        update_position(text.c_str(), view, current_line, current_column,
-                        current_index);
-        auto lexeme = lexeme_lookup(view);
+    for (;;) {
+        position = skip_separators(source, size, position, line, line_start);
 
-        if (!lexeme) {
-            log_printf(
-                ERROR_REPORTS, "error",
-                "Could not distinguish lexeme at line %lu, column %lu.\n",
-                current_line, current_column);
+        if (position == size) {
+            buffer.complete = true;
             break;
         }
 
-        lexeme.value()->assign_coords(current_line, current_column);
+        Lexeme lexeme{};
+        lexeme.line = line;
+        lexeme.column = (uint32_t)(position - line_start);
+
+        char current = source[position];
+
+        if (current == '"') {
+            size_t end = position + 1;
+
+            for (; end < size && source[end] != '"'; ++end) {
+                if (source[end] == '\\' && end + 1 < size) ++end;
+
+                if (source[end] == '\n') {
+                    ++line;
+                    line_start = end + 1;
+                }
+            }
+
+            lexeme.exact = true;
+            lexeme.offset = (uint32_t)(position + 1);
+            lexeme.length = (uint32_t)(end - position - 1);
+
+            position = end < size ? end + 1 : end;
+        } else if (current == '@') {
+            size_t length =
+                word_length(source + position + 1, size - position - 1);
 
-        result.push_back(lexeme.value());
+            lexeme.kind = LexemeKind::NAMED_COMPONENT;
+            lexeme.offset = (uint32_t)(position + 1);
+            lexeme.length = (uint32_t)length;
 
-        remove_whitespace(view);
+            position += length + 1;
+        } else {
+            size_t length = word_length(source + position, size - position);
+
+            if (length > 0) {
+                // Keywords are only recognized as whole words
+                LexemeKind kind = LexemeKind::STRING;
+                if (AUTOMATON.match(source + position, length, kind) != length)
+                    kind = LexemeKind::STRING;
+
+                lexeme.kind = kind;
+            } else {
+                length =
+                    AUTOMATON.match(source + position, size - position,
+                                    lexeme.kind);
+            }
+
+            if (length == 0) {
+                log_printf(
+                    ERROR_REPORTS, "error",
+                    "Could not distinguish lexeme at line %u, column %u.\n",
+                    lexeme.line, lexeme.column);
+                break;
+            }
+
+            lexeme.offset = (uint32_t)position;
+            lexeme.length = (uint32_t)length;
+
+            position += length;
+        }
+
+        buffer.lexemes.push_back(lexeme);
+    }
+
+    return buffer;
+}
+
+std::string LexemeBuffer::get_string(const Lexeme& lexeme) const {
+    std::string_view text = get_text(lexeme);
+
+    if (!lexeme.exact) return std::string(text);
+
+    std::string result{};
+    result.reserve(text.size());
+
+    for (size_t id = 0; id < text.size(); ++id) {
+        if (text[id] != '\\') {
+            result.push_back(text[id]);
+        } else if (id + 1 < text.size()) {
+            result.push_back(text[++id]);
+        }
     }
 
     return result;
@@ -13,4 +13,10 @@
 
 #include "lexemes.h"
 
-std::vector<Lexeme::LexemePtr> lexify(const std::string& text);
+/**
+ * @brief Split the text into lexemes
+ *
+ * @param[in] text script source
+ * @return LexemeBuffer - lexemes up to the first unrecognized character
+ */
+LexemeBuffer lexify(const std::string& text);
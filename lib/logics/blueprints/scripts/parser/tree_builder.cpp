@@ -1,10 +1,12 @@
 #include "tree_builder.h"
 
+#include <stdlib.h>
+
 #include "lexemes.h"
 #include "logics/blueprints/scripts/nodes/nodes.h"
 #include "memory/match_to.hpp"
 
-using LexemeVector = std::vector<Lexeme::LexemePtr>;
+using LexemeVector = std::vector<Lexeme>;
 using LexemeIterator = LexemeVector::const_iterator;
 
 using NodePtr = std::shared_ptr<Script::Node>;
@@ -35,9 +37,10 @@ clang-format on
     std::optional<NodePtr> name(ParsedTree& data, LexemeIterator& iterator, \
                                 LexemeIterator end)
 
-static NodePtr new_node(Script::Node* node,
+static NodePtr new_node(Script::Node* node, const Lexeme& lexeme,
                         std::vector<std::weak_ptr<Script::Node>>& nodes) {
     NodePtr result(node);
+    result->set_location(lexeme.line, lexeme.column);
 
     nodes.push_back(result);
 
@@ -64,18 +67,20 @@ static void remove_expired(std::vector<std::weak_ptr<T>>& vector) {
     for (size_t id = 0; id < vector.size(); ++id) {
         if (vector[id].expired()) continue;
 
-        vector[left] = std::move(vector[id]);
+        // Self-move-assignment would leave the pointer empty
+        if (left != id) vector[left] = std::move(vector[id]);
         ++left;
     }
 
     vector.resize(left);
 }
 
-ParsedTree build_exec_ast(const std::vector<Lexeme::LexemePtr>& lexemes) {
+ParsedTree build_exec_ast(const LexemeBuffer& lexemes) {
     ParsedTree tree;
+    tree.lexemes = &lexemes;
 
-    auto iterator = lexemes.begin();
-    auto end = lexemes.end();
+    auto iterator = lexemes.lexemes.begin();
+    auto end = lexemes.lexemes.end();
 
     while (iterator != end) {
         auto current = iterator;
@@ -86,17 +91,21 @@ ParsedTree build_exec_ast(const std::vector<Lexeme::LexemePtr>& lexemes) {
         auto pipe = parse_pipe(tree, iterator, end);
         if (!pipe) {
             log_printf(ERROR_REPORTS, "error",
-                       "Failed to parse statement at line %lu, column %lu.\n",
-                       (*current)->get_line(), (*current)->get_column());
+                       "Failed to parse statement at line %u, column %u.\n",
+                       current->line, current->column);
             return {};
         }
 
         tree.roots.push_back(*pipe);
+        tree.root_locations.push_back({current->line, current->column});
     }
 
     remove_expired(tree.nodes);
     remove_expired(tree.queue);
 
+    tree.lexemes = nullptr;
+    tree.complete = lexemes.complete;
+
     return tree;
 }
 
@@ -105,10 +114,10 @@ ParsedTree build_exec_ast(const std::vector<Lexeme::LexemePtr>& lexemes) {
         log_printf(ERROR_REPORTS, "error",                              \
                    "Expected " message ", got EOF instead.\n");         \
         return {};                                                      \
-    } else if (!iterator->as<type>()) {                                 \
+    } else if (!iterator->is<type>()) {                                 \
         log_printf(ERROR_REPORTS, "error",                              \
-                   "Expected " message " at line %lu, column %lu.\n",   \
-                   (*iterator)->get_line(), (*iterator)->get_column()); \
+                   "Expected " message " at line %u, column %u.\n",     \
+                   iterator->line, iterator->column);                   \
         return {};                                                      \
     }                                                                   \
     ++iterator;
@@ -117,6 +126,8 @@ static PARSER(parse_pipe) {
     auto object = parse_statement(data, iterator, end);
     if (!object) return {};
 
+    auto assignment = iterator;
+
     EXPECT(lexemes::AssignmentLeft, "an output channel specification");
 
     auto channel = parse_statement(data, iterator, end);
@@ -128,17 +139,17 @@ static PARSER(parse_pipe) {
     if (!value) return {};
 
     return new_node(new nodes::InputMethod(*object, *channel, *value),
-                    data.nodes);
+                    *assignment, data.nodes);
 }
 
 static PARSER(parse_variable_decl) {
     if (iterator == end || iterator + 1 == end) return {};
 
-    if (!iterator->as<lexemes::String>() ||
-        !(iterator + 1)->as<lexemes::MacroAssignment>())
+    if (!iterator->is<lexemes::String>() ||
+        !(iterator + 1)->is<lexemes::MacroAssignment>())
         return {};
 
-    std::string name = iterator->as<lexemes::String>()->get_value();
+    std::string name = data.lexemes->get_string(*iterator);
 
     if (data.variables.find(name) != data.variables.end()) {
         log_printf(ERROR_REPORTS, "error",
@@ -164,8 +175,8 @@ static PARSER(parse_statement) {
 
     if (iterator == end) return first;
 
-    if (iterator->as<lexemes::ConditionalLeft>()) {
-        ++iterator;
+    if (iterator->is<lexemes::ConditionalLeft>()) {
+        auto condition = iterator++;
 
         auto second = parse_statement(data, iterator, end);
         if (!second) return {};
@@ -175,7 +186,8 @@ static PARSER(parse_statement) {
         auto third = parse_statement(data, iterator, end);
         if (!third) return {};
 
-        return std::make_shared<nodes::Conditional>(*first, *second, *third);
+        return new_node(new nodes::Conditional(*first, *second, *third),
+                        *condition, data.nodes);
     }
 
     return first;
@@ -192,19 +204,19 @@ static PARSER(parse_logical) {
 
         auto constructor = Match<lexemes::Or, lexemes::And>::
             To<Script::Node, nodes::LogicalOr, nodes::LogicalAnd>::
-                From<NodePtr, NodePtr>::constructor(&**iterator);
+                From<NodePtr, NodePtr>::constructor(&*iterator);
 
         if (!constructor) {
             return initial;
         }
 
-        ++iterator;
+        auto operation = iterator++;
 
         auto secondary = parse_comparator(data, iterator, end);
         if (!secondary) return {};
 
-        initial =
-            new_node(constructor->operator()(*initial, *secondary), data.nodes);
+        initial = new_node(constructor->operator()(*initial, *secondary),
+                           *operation, data.nodes);
     }
 
     return initial;
@@ -223,14 +235,17 @@ static PARSER(parse_comparator) {
               lexemes::GreaterEq, lexemes::Equal, lexemes::NotEqual>::
             To<Script::Node, nodes::Less, nodes::Greater, nodes::LessOrEqual,
                nodes::GreaterOrEqual, nodes::Equal, nodes::NotEqual>::
-                From<NodePtr, NodePtr>::constructor(&**iterator);
+                From<NodePtr, NodePtr>::constructor(&*iterator);
 
     if (!constructor) return initial;
 
+    auto operation = iterator++;
+
     auto secondary = parse_addition(data, iterator, end);
     if (!secondary) return {};
 
-    return new_node(constructor->operator()(*initial, *secondary), data.nodes);
+    return new_node(constructor->operator()(*initial, *secondary), *operation,
+                    data.nodes);
 }
 
 static PARSER(parse_addition) {
@@ -244,19 +259,19 @@ static PARSER(parse_addition) {
 
         auto constructor = Match<lexemes::Plus, lexemes::Minus>::
             To<Script::Node, nodes::Add, nodes::Subtract>::
-                From<NodePtr, NodePtr>::constructor(&**iterator);
+                From<NodePtr, NodePtr>::constructor(&*iterator);
 
         if (!constructor) {
             return initial;
         }
 
-        ++iterator;
+        auto operation = iterator++;
 
         auto secondary = parse_multiplication(data, iterator, end);
         if (!secondary) return {};
 
-        initial =
-            new_node(constructor->operator()(*initial, *secondary), data.nodes);
+        initial = new_node(constructor->operator()(*initial, *secondary),
+                           *operation, data.nodes);
     }
 
     return initial;
@@ -273,48 +288,50 @@ static PARSER(parse_multiplication) {
 
         auto constructor = Match<lexemes::Multiply, lexemes::Divide>::
             To<Script::Node, nodes::Multiply, nodes::Divide>::
-                From<NodePtr, NodePtr>::constructor(&**iterator);
+                From<NodePtr, NodePtr>::constructor(&*iterator);
 
         if (!constructor) {
             return initial;
         }
 
-        ++iterator;
+        auto operation = iterator++;
 
         auto secondary = parse_request(data, iterator, end);
         if (!secondary) return {};
 
-        initial =
-            new_node(constructor->operator()(*initial, *secondary), data.nodes);
+        initial = new_node(constructor->operator()(*initial, *secondary),
+                           *operation, data.nodes);
     }
 
     return initial;
 }
 
 static PARSER(parse_request) {
+    auto minus = iterator;
+
     bool unary_minus =
-        iterator != end && iterator->as<lexemes::Minus>() != nullptr;
+        iterator != end && iterator->is<lexemes::Minus>();
     if (unary_minus) ++iterator;
 
     auto initial = parse_value(data, iterator, end);
     if (!initial) return {};
 
     for (;;) {
-        if (iterator == end || !iterator->as<lexemes::Access>()) {
+        if (iterator == end || !iterator->is<lexemes::Access>()) {
             break;
         }
 
-        ++iterator;
+        auto operation = iterator++;
 
         auto secondary = parse_value(data, iterator, end);
         if (!secondary) return {};
 
-        initial =
-            new_node(new nodes::OutputMethod(*initial, *secondary), data.nodes);
+        initial = new_node(new nodes::OutputMethod(*initial, *secondary),
+                           *operation, data.nodes);
     }
 
     if (unary_minus) {
-        return new_node(new nodes::Negative(*initial), data.nodes);
+        return new_node(new nodes::Negative(*initial), *minus, data.nodes);
     }
 
     return initial;
@@ -326,12 +343,12 @@ static PARSER(parse_value) {
     auto wrapper_constructor =
         Match<lexemes::BracketCurlyOp, lexemes::BracketSquareOp>::
             To<Script::Node, nodes::DetectChange, nodes::DetectSource>::
-                From<NodePtr>::constructor(&**iterator);
+                From<NodePtr>::constructor(&*iterator);
 
-    bool just_separation = iterator->as<lexemes::BracketRoundOp>();
+    bool just_separation = iterator->is<lexemes::BracketRoundOp>();
 
     if (wrapper_constructor || just_separation) {
-        ++iterator;
+        auto bracket = iterator++;
 
         auto statement = parse_statement(data, iterator, end);
         if (!statement) return {};
@@ -344,12 +361,12 @@ static PARSER(parse_value) {
         }
 
         // TODO: Check for the exact type of bracket.
-        if (!iterator->as<lexemes::BracketCurlyCl>() &&
-            !iterator->as<lexemes::BracketSquareCl>() &&
-            !iterator->as<lexemes::BracketRoundCl>()) {
+        if (!iterator->is<lexemes::BracketCurlyCl>() &&
+            !iterator->is<lexemes::BracketSquareCl>() &&
+            !iterator->is<lexemes::BracketRoundCl>()) {
             log_printf(ERROR_REPORTS, "error",
-                       "Expected a closing bracket at line %lu, column %lu.\n",
-                       (*iterator)->get_line(), (*iterator)->get_column());
+                       "Expected a closing bracket at line %u, column %u.\n",
+                       iterator->line, iterator->column);
             return {};
         }
 
@@ -357,7 +374,7 @@ static PARSER(parse_value) {
 
         if (wrapper_constructor) {
             return new_node(wrapper_constructor->operator()(*statement),
-                            data.nodes);
+                            *bracket, data.nodes);
         }
 
         return statement;
@@ -375,8 +392,8 @@ static PARSER(parse_value) {
             "Expected a value in the end of the script, got EOF instead.\n");
     } else {
         log_printf(ERROR_REPORTS, "error",
-                   "Expected a value at line %lu, column %lu.\n",
-                   (*iterator)->get_line(), (*iterator)->get_column());
+                   "Expected a value at line %u, column %u.\n",
+                   iterator->line, iterator->column);
     }
 
     return {};
@@ -391,16 +408,36 @@ static PARSER(parse_function) {
               lexemes::SkipInvalid>::
             To<Script::Node, nodes::Sin, nodes::Cos, nodes::LogE, nodes::Log2,
                nodes::Log10, nodes::Absolute, nodes::Sign, nodes::Length,
-               nodes::RequireValidity>::From<NodePtr>::constructor(&**iterator);
+               nodes::RequireValidity>::From<NodePtr>::constructor(&*iterator);
 
     if (!constructor) return {};
 
-    ++iterator;
+    auto function = iterator++;
 
     auto value = parse_value(data, iterator, end);
     if (!value) return {};
 
-    return new_node(constructor->operator()(*value), data.nodes);
+    return new_node(constructor->operator()(*value), *function, data.nodes);
+}
+
+/**
+ * @brief Get the value of a string literal (unquoted literals that are valid
+ * numbers become numeric constants)
+ *
+ * @param[in] lexeme
+ * @param[in] string value of the lexeme
+ * @return ScriptValue
+ */
+static ScriptValue literal_value(const Lexeme& lexeme,
+                                 const std::string& string) {
+    if (!lexeme.exact && !string.empty()) {
+        char* end = nullptr;
+        double number = strtod(string.c_str(), &end);
+
+        if (*end == '\0') return number;
+    }
+
+    return string;
 }
 
 static PARSER(parse_constant) {
@@ -408,20 +445,26 @@ static PARSER(parse_constant) {
 
     NodePtr result;
 
-    if (auto lexeme = iterator->as<lexemes::String>()) {
-        result = new_node(new nodes::StringConstant(lexeme->get_value()),
-                          data.nodes);
+    if (iterator->is<lexemes::String>()) {
+        std::string string = data.lexemes->get_string(*iterator);
 
         // In case it is a name of a variable
-        auto variable_find = data.variables.find(lexeme->get_value());
-        if (!lexeme->is_exact() && variable_find != data.variables.end()) {
+        auto variable_find = data.variables.find(string);
+        if (!iterator->exact && variable_find != data.variables.end()) {
             ++iterator;
             return variable_find->second;
         }
+
+        result = new_node(
+            new nodes::StringConstant(literal_value(*iterator, string)),
+            *iterator, data.nodes);
     }
-    if (auto lexeme = iterator->as<lexemes::NamedComponent>()) {
-        std::string value = lexeme->get_guid().to_string();
-        result = new_node(new nodes::StringConstant(value), data.nodes);
+    if (iterator->is<lexemes::NamedComponent>()) {
+        result = new_node(new nodes::StringConstant(GUID()), *iterator,
+                          data.nodes);
+
+        data.component_names.push_back(
+            {result, data.lexemes->get_string(*iterator)});
     }
 
     if (!result) return {};
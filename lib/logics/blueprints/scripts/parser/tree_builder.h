@@ -14,13 +14,26 @@
 #include <set>
 #include <vector>
 
+#include "lexeme.h"
 #include "logics/blueprints/scripts/script.h"
 
+/**
+ * @brief Position of a statement in the script source
+ *
+ */
+struct SourceLocation {
+    uint32_t line = 0;
+    uint32_t column = 0;
+};
+
 struct ParsedTree {
     // Root nodes of a script
     std::vector<std::shared_ptr<Script::Node>> roots{};
 
-    // All nodes of a script
+    // Positions of the statements the roots were parsed from
+    std::vector<SourceLocation> root_locations{};
+
+    // All nodes of a script, in the order of creation
     std::vector<std::weak_ptr<Script::Node>> nodes{};
 
     // Initial update queue
@@ -28,6 +41,17 @@ struct ParsedTree {
 
     // Script variables
     std::unordered_map<std::string, std::shared_ptr<Script::Node>> variables{};
+
+    // Constants referring to components, with the names of the components
+    // (the constants hold invalid GUIDs until the names are resolved)
+    std::vector<std::pair<std::weak_ptr<Script::Node>, std::string>>
+        component_names{};
+
+    // Whether the whole script has been parsed
+    bool complete = false;
+
+    // Lexemes the tree is being built from (only set during the build)
+    const LexemeBuffer* lexemes = nullptr;
 };
 
 /**
@@ -36,4 +60,4 @@ struct ParsedTree {
  * @param[in] lexemes lexeme sequence
  * @return ParsedTree
  */
-ParsedTree build_exec_ast(const std::vector<Lexeme::LexemePtr>& lexemes);
+ParsedTree build_exec_ast(const LexemeBuffer& lexemes);
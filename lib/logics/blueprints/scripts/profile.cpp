@@ -0,0 +1,152 @@
+#include "profile.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "node.h"
+#include "parser/tree_builder.h"
+#include "time/world_timer.h"
+
+static const size_t MAX_TEXT_LENGTH = 64;
+
+static std::string get_text(const Script::Node& node) {
+    std::string text = node.debug();
+
+    if (text.size() > MAX_TEXT_LENGTH) {
+        text.resize(MAX_TEXT_LENGTH - 3);
+        text += "...";
+    }
+
+    return text;
+}
+
+ScriptProfile::ScriptProfile(const ParsedTree& tree) {
+    std::unordered_map<const Script::Node*, uint32_t> indices{};
+
+    for (const std::weak_ptr<Script::Node>& pointer : tree.nodes) {
+        std::shared_ptr<Script::Node> node = pointer.lock();
+
+        indices.insert({node.get(), (uint32_t)nodes_.size()});
+        nodes_.push_back({node->get_opcode(), NO_RULE, node->get_line(),
+                          node->get_column(), get_text(*node)});
+    }
+
+    std::vector<const Script::Node*> stack{};
+
+    for (size_t id = 0; id < tree.roots.size(); ++id) {
+        SourceLocation location{};
+        if (id < tree.root_locations.size()) location = tree.root_locations[id];
+
+        rules_.push_back(
+            {location.line, location.column, get_text(*tree.roots[id])});
+
+        stack.push_back(tree.roots[id].get());
+
+        while (!stack.empty()) {
+            const Script::Node* node = stack.back();
+            stack.pop_back();
+
+            auto found = indices.find(node);
+            if (found == indices.end()) continue;
+
+            uint32_t& rule = nodes_[found->second].rule;
+            if (rule != NO_RULE) continue;
+
+            rule = (uint32_t)id;
+
+            for (const Script::Node::ChildReference& input :
+                 node->get_inputs()) {
+                stack.push_back(input.get());
+            }
+        }
+    }
+}
+
+uint64_t ScriptProfile::begin_update() {
+    nested_ticks_.push_back(0);
+    return WorldTimer::get_wall_clock().get_time();
+}
+
+void ScriptProfile::end_update(uint32_t node, uint64_t begin) {
+    uint64_t duration = WorldTimer::get_wall_clock().get_time() - begin;
+
+    uint64_t nested = nested_ticks_.back();
+    nested_ticks_.pop_back();
+
+    if (!nested_ticks_.empty()) nested_ticks_.back() += duration;
+
+    Stats& stats = nodes_[node].stats;
+
+    ++stats.updates;
+    stats.ticks += duration > nested ? duration - nested : 0;
+}
+
+std::vector<ScriptProfile::RuleEntry> ScriptProfile::get_rules() const {
+    std::vector<RuleEntry> rules = rules_;
+
+    for (const NodeEntry& node : nodes_) {
+        if (node.rule == NO_RULE) continue;
+
+        Stats& stats = rules[node.rule].stats;
+
+        stats.updates += node.stats.updates;
+        stats.triggers += node.stats.triggers;
+        stats.ticks += node.stats.ticks;
+    }
+
+    std::stable_sort(rules.begin(), rules.end(),
+                     [](const RuleEntry& alpha, const RuleEntry& beta) {
+                         return alpha.stats.ticks > beta.stats.ticks;
+                     });
+
+    return rules;
+}
+
+static void format_entry(std::string& result, uint32_t line, uint32_t column,
+                         const ScriptProfile::Stats& stats,
+                         const std::string& text) {
+    double milliseconds = (double)stats.ticks * 1000.0 /
+                          (double)WorldTimer::get_wall_clock().get_frequency();
+
+    char buffer[512] = "";
+    snprintf(buffer, sizeof(buffer),
+             "line %u, column %u: %.3lf ms, %" PRIu64 " updates, %" PRIu64
+             " triggers: %s\n",
+             line, column, milliseconds, stats.updates, stats.triggers,
+             text.c_str());
+
+    result += buffer;
+}
+
+std::string ScriptProfile::format(size_t node_limit) const {
+    std::string result = "Rules:\n";
+
+    for (const RuleEntry& rule : get_rules()) {
+        format_entry(result, rule.line, rule.column, rule.stats, rule.text);
+    }
+
+    std::vector<const NodeEntry*> nodes{};
+    for (const NodeEntry& node : nodes_) nodes.push_back(&node);
+
+    std::stable_sort(nodes.begin(), nodes.end(),
+                     [](const NodeEntry* alpha, const NodeEntry* beta) {
+                         return alpha->stats.ticks > beta->stats.ticks;
+                     });
+
+    if (nodes.size() > node_limit) nodes.resize(node_limit);
+
+    result += "Nodes:\n";
+
+    for (const NodeEntry* node : nodes) {
+        format_entry(result, node->line, node->column, node->stats,
+                     node->text);
+    }
+
+    return result;
+}
+
+void ScriptProfile::clear() {
+    for (NodeEntry& node : nodes_) node.stats = Stats();
+}
@@ -0,0 +1,116 @@
+/**
+ * @file profile.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Update statistics of script nodes
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "opcode.h"
+
+struct ParsedTree;
+
+/**
+ * @brief Update counts and timings of the nodes of an assembled script,
+ * attributed to the rules (top-level statements) they were parsed from
+ *
+ * Node indices follow `ParsedTree::nodes`, which is also the order of the
+ * nodes of a `ScriptProgram`. A node shared between several rules is
+ * attributed to the first of them.
+ */
+struct ScriptProfile final {
+    struct Stats {
+        uint64_t updates = 0;
+        uint64_t triggers = 0;
+
+        // Time spent in the updates without the nested updates started by
+        // the channels (in wall clock ticks)
+        uint64_t ticks = 0;
+    };
+
+    struct NodeEntry {
+        ScriptOpcode opcode;
+
+        // Index of the rule of the node (`NO_RULE` if it does not have one)
+        uint32_t rule;
+
+        // Position of the lexeme the node was parsed from
+        uint32_t line;
+        uint32_t column;
+
+        std::string text;
+        Stats stats{};
+    };
+
+    struct RuleEntry {
+        uint32_t line;
+        uint32_t column;
+
+        std::string text;
+        Stats stats{};
+    };
+
+    static const uint32_t NO_RULE = UINT32_MAX;
+
+    explicit ScriptProfile(const ParsedTree& tree);
+
+    /**
+     * @brief Start timing an update
+     *
+     * @return uint64_t - start time, to be passed to `end_update`
+     */
+    uint64_t begin_update();
+
+    /**
+     * @brief Finish timing an update of the node
+     *
+     * @param[in] node node index
+     * @param[in] begin value returned by the matching `begin_update`
+     */
+    void end_update(uint32_t node, uint64_t begin);
+
+    void record_trigger(uint32_t node) { ++nodes_[node].stats.triggers; }
+
+    const std::vector<NodeEntry>& get_nodes() const { return nodes_; }
+
+    /**
+     * @brief Get the statistics of the rules, summed over their nodes
+     *
+     * @return std::vector<RuleEntry> - rules sorted by descending time
+     */
+    std::vector<RuleEntry> get_rules() const;
+
+    /**
+     * @brief Print the rules and the nodes sorted by descending time, one per
+     * line (`line <line>, column <column>: <time> ms, <updates> updates,
+     * <triggers> triggers: <text>`)
+     *
+     * @param[in] node_limit maximum number of nodes to print
+     * @return std::string
+     */
+    std::string format(size_t node_limit = 32) const;
+
+    /**
+     * @brief Reset the statistics
+     *
+     */
+    void clear();
+
+   private:
+    std::vector<NodeEntry> nodes_{};
+    std::vector<RuleEntry> rules_{};
+
+    // Durations of the updates nested into the ones being timed
+    std::vector<uint64_t> nested_ticks_{};
+};
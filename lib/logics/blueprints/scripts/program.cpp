@@ -0,0 +1,455 @@
+#include "program.h"
+
+#include <assert.h>
+#include <math.h>
+
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include "logger/metrics.h"
+#include "node.h"
+#include "nodes/component_io.h"
+
+ScriptProgram::ScriptProgram(const ParsedTree& tree, Propagation propagation)
+    : propagation_(propagation) {
+    size_t count = tree.nodes.size();
+
+    opcodes_.reserve(count);
+    values_.reserve(count);
+    states_.reserve(count);
+    input_offsets_.reserve(count + 1);
+
+    // Nodes are listed in the order of creation, so inputs of a node always
+    // precede it, and dependents of a node are listed in subscription order.
+    std::unordered_map<const Script::Node*, uint32_t> indices{};
+
+    input_offsets_.push_back(0);
+
+    for (const std::weak_ptr<Script::Node>& pointer : tree.nodes) {
+        std::shared_ptr<Script::Node> node = pointer.lock();
+
+        uint32_t id = (uint32_t)opcodes_.size();
+        indices.insert({node.get(), id});
+
+        ScriptOpcode opcode = node->get_opcode();
+
+        opcodes_.push_back(opcode);
+        values_.push_back(node->get_value());
+
+        for (const Script::Node::ChildReference& input : node->get_inputs()) {
+            auto found = indices.find(input.get());
+            assert(found != indices.end());
+
+            inputs_.push_back(found->second);
+        }
+
+        input_offsets_.push_back((uint32_t)inputs_.size());
+
+        switch (opcode) {
+            case ScriptOpcode::DETECT_CHANGE:
+                states_.push_back((uint32_t)previous_values_.size());
+                previous_values_.emplace_back();
+                break;
+            case ScriptOpcode::OUTPUT_METHOD:
+                states_.push_back((uint32_t)listeners_.size());
+                listeners_.emplace_back([this, id](const ScriptValue& value) {
+                    values_[id] = value;
+                    if (profile_) profile_->record_trigger(id);
+                    notify(id);
+                });
+                output_bindings_.emplace_back();
+                break;
+            case ScriptOpcode::INPUT_METHOD:
+                states_.push_back((uint32_t)connections_.size());
+                connections_.emplace_back();
+                break;
+            default:
+                states_.push_back(0);
+                break;
+        }
+    }
+
+    // Transpose the input table into the table of dependents
+    auto is_repeated = [this](uint32_t node, uint32_t edge) {
+        for (uint32_t other = input_offsets_[node]; other < edge; ++other) {
+            if (inputs_[other] == inputs_[edge]) return true;
+        }
+
+        return false;
+    };
+
+    output_offsets_.assign(opcodes_.size() + 1, 0);
+
+    for (uint32_t id = 0; id < (uint32_t)opcodes_.size(); ++id) {
+        for (uint32_t edge = input_offsets_[id]; edge < input_offsets_[id + 1];
+             ++edge) {
+            if (!is_repeated(id, edge)) ++output_offsets_[inputs_[edge] + 1];
+        }
+    }
+
+    for (size_t id = 0; id < opcodes_.size(); ++id) {
+        output_offsets_[id + 1] += output_offsets_[id];
+    }
+
+    outputs_.resize(output_offsets_.back());
+    output_masks_.resize(output_offsets_.back());
+
+    std::vector<uint32_t> filled(output_offsets_.begin(),
+                                 output_offsets_.end() - 1);
+
+    for (uint32_t id = 0; id < (uint32_t)opcodes_.size(); ++id) {
+        for (uint32_t edge = input_offsets_[id]; edge < input_offsets_[id + 1];
+             ++edge) {
+            uint8_t mask = (uint8_t)(1 << (edge - input_offsets_[id]));
+
+            // Dependents are filled in order, so the entry of a repeated
+            // input is the last one filled
+            if (is_repeated(id, edge)) {
+                output_masks_[filled[inputs_[edge]] - 1] |= mask;
+                continue;
+            }
+
+            uint32_t output = filled[inputs_[edge]]++;
+
+            outputs_[output] = id;
+            output_masks_[output] = mask;
+        }
+    }
+
+    for (const std::weak_ptr<Script::Node>& pointer : tree.queue) {
+        auto found = indices.find(pointer.lock().get());
+        if (found != indices.end()) initial_.push_back(found->second);
+    }
+
+    if (propagation_ == Propagation::BATCHED) {
+        pending_.assign(opcodes_.size(), 0);
+    }
+}
+
+void ScriptProgram::start(Scene& scene) {
+    scene_ = &scene;
+
+    for (uint32_t node : initial_) {
+        if (profile_) profile_->record_trigger(node);
+        notify(node);
+    }
+
+    flush();
+}
+
+void ScriptProgram::flush() {
+    static Counter& updates = Metrics::get_counter("script_node_updates");
+
+    uint64_t update_count = 0;
+
+    // Inputs of a node always precede it, so evaluating the nodes in the
+    // order of their indices evaluates every node after all its inputs.
+    while (!dirty_.empty()) {
+        std::pop_heap(dirty_.begin(), dirty_.end(), std::greater<uint32_t>());
+
+        uint32_t node = dirty_.back();
+        dirty_.pop_back();
+
+        uint8_t changed = pending_[node];
+        pending_[node] = 0;
+
+        ++update_count;
+
+        if (update(node, changed)) mark_dependents(node);
+    }
+
+    for (uint32_t node : fired_sources_) values_[node] = ScriptValue();
+    fired_sources_.clear();
+
+    updates.add(update_count);
+}
+
+void ScriptProgram::notify(uint32_t source) {
+    if (propagation_ == Propagation::BATCHED) {
+        mark_dependents(source);
+    } else {
+        propagate(source);
+    }
+}
+
+void ScriptProgram::mark_dependents(uint32_t source) {
+    for (uint32_t edge = output_offsets_[source];
+         edge < output_offsets_[source + 1]; ++edge) {
+        uint32_t target = outputs_[edge];
+
+        if (pending_[target] == 0) {
+            dirty_.push_back(target);
+            std::push_heap(dirty_.begin(), dirty_.end(),
+                           std::greater<uint32_t>());
+        }
+
+        pending_[target] |= output_masks_[edge];
+    }
+}
+
+size_t ScriptProgram::get_memory_usage() const {
+    return sizeof(*this) + opcodes_.capacity() * sizeof(ScriptOpcode) +
+           values_.capacity() * sizeof(ScriptValue) +
+           (output_masks_.capacity() + pending_.capacity()) * sizeof(uint8_t) +
+           (input_offsets_.capacity() + inputs_.capacity() +
+            output_offsets_.capacity() + outputs_.capacity() +
+            states_.capacity() + initial_.capacity() + dirty_.capacity() +
+            fired_sources_.capacity()) *
+               sizeof(uint32_t) +
+           previous_values_.capacity() * sizeof(std::optional<ScriptValue>) +
+           listeners_.capacity() * sizeof(SceneComponent::Channel::Listener) +
+           output_bindings_.capacity() * sizeof(nodes::ChannelBinding) +
+           connections_.capacity() * sizeof(InputConnection) +
+           stack_.capacity() * sizeof(Frame);
+}
+
+void ScriptProgram::propagate(uint32_t source) {
+    static Counter& updates = Metrics::get_counter("script_node_updates");
+
+    // Channel triggers can start nested propagations, which use the part of
+    // the stack above `base`.
+    size_t base = stack_.size();
+    uint64_t update_count = 0;
+
+    stack_.push_back({source, output_offsets_[source]});
+
+    while (stack_.size() > base) {
+        Frame& frame = stack_.back();
+
+        if (frame.edge == output_offsets_[frame.node + 1]) {
+            uint32_t node = frame.node;
+            stack_.pop_back();
+
+            // Source detectors only hold the value while it propagates
+            if (opcodes_[node] == ScriptOpcode::DETECT_SOURCE) {
+                values_[node] = ScriptValue();
+            }
+
+            continue;
+        }
+
+        uint32_t target = outputs_[frame.edge];
+        uint8_t mask = output_masks_[frame.edge];
+
+        ++frame.edge;
+        ++update_count;
+
+        if (update(target, mask)) {
+            stack_.push_back({target, output_offsets_[target]});
+        }
+    }
+
+    updates.add(update_count);
+}
+
+bool ScriptProgram::update(uint32_t node, uint8_t changed) {
+    if (!profile_) return evaluate(node, changed);
+
+    uint64_t begin = profile_->begin_update();
+    bool triggered = evaluate(node, changed);
+    profile_->end_update(node, begin);
+
+    if (triggered) profile_->record_trigger(node);
+
+    return triggered;
+}
+
+static double sign(double value) {
+    return value > 0 ? 1.0 : (value < 0 ? -1.0 : 0.0);
+}
+
+bool ScriptProgram::evaluate(uint32_t node, uint8_t changed) {
+    ScriptValue& value = values_[node];
+    ScriptOpcode opcode = opcodes_[node];
+
+    switch (opcode) {
+        case ScriptOpcode::CONSTANT:
+            return true;
+        case ScriptOpcode::IS_VALID:
+            value = get_input(node, 0).has_value();
+            return true;
+        case ScriptOpcode::CONDITIONAL: {
+            const ScriptValue& condition = get_input(node, 0);
+
+            if (condition.is_none()) {
+                value = ScriptValue();
+            } else {
+                value = get_input(node, condition.as_bool() ? 1 : 2);
+            }
+
+            return true;
+        }
+        case ScriptOpcode::DETECT_CHANGE: {
+            std::optional<ScriptValue>& previous =
+                previous_values_[states_[node]];
+            const ScriptValue& current = get_input(node, 0);
+
+            if (previous == current) return false;
+
+            previous = current;
+            value = current;
+
+            return true;
+        }
+        case ScriptOpcode::REQUIRE_VALIDITY:
+            if (get_input(node, 0).is_none()) return false;
+
+            value = get_input(node, 0);
+            return true;
+        case ScriptOpcode::DETECT_SOURCE:
+            value = get_input(node, 0);
+
+            if (propagation_ == Propagation::BATCHED) {
+                fired_sources_.push_back(node);
+            }
+
+            return true;
+        case ScriptOpcode::OUTPUT_METHOD:
+            connect_output(node);
+            return false;
+        case ScriptOpcode::INPUT_METHOD: {
+            // Reconnect if the component or the channel have changed
+            if (changed & 0b011) connect_input(node);
+
+            // Send the update event if the value has changed.
+            if (!(changed & 0b100)) return false;
+
+            InputConnection& connection = connections_[states_[node]];
+            if (!connection.connected) connect_input(node);
+
+            ScriptValue payload = get_input(node, 2);
+            if (payload.has_value()) connection.output.trigger(payload);
+
+            return true;
+        }
+        default:
+            break;
+    }
+
+    // Arithmetic and logical operations
+    uint32_t input_count = input_offsets_[node + 1] - input_offsets_[node];
+
+    for (uint32_t input = 0; input < input_count; ++input) {
+        if (get_input(node, input).is_none()) {
+            value = ScriptValue();
+            return true;
+        }
+    }
+
+    const ScriptValue& left = get_input(node, 0);
+    const ScriptValue& right = input_count > 1 ? get_input(node, 1) : left;
+
+    switch (opcode) {
+        case ScriptOpcode::LENGTH:
+            value = (double)left.as_string().length();
+            break;
+        case ScriptOpcode::EQUAL:
+            value = left.equals(right);
+            break;
+        case ScriptOpcode::NOT_EQUAL:
+            value = !left.equals(right);
+            break;
+        case ScriptOpcode::GREATER:
+            value = left.as_number() > right.as_number();
+            break;
+        case ScriptOpcode::LESS:
+            value = left.as_number() < right.as_number();
+            break;
+        case ScriptOpcode::GREATER_OR_EQUAL:
+            value = left.as_number() >= right.as_number();
+            break;
+        case ScriptOpcode::LESS_OR_EQUAL:
+            value = left.as_number() <= right.as_number();
+            break;
+        case ScriptOpcode::ADD:
+            value = left.as_number() + right.as_number();
+            break;
+        case ScriptOpcode::SUBTRACT:
+            value = left.as_number() - right.as_number();
+            break;
+        case ScriptOpcode::MULTIPLY:
+            value = left.as_number() * right.as_number();
+            break;
+        case ScriptOpcode::DIVIDE:
+            value = left.as_number() / right.as_number();
+            break;
+        case ScriptOpcode::NEGATIVE:
+            value = -left.as_number();
+            break;
+        case ScriptOpcode::ABSOLUTE:
+            value = fabs(left.as_number());
+            break;
+        case ScriptOpcode::SIGN:
+            value = sign(left.as_number());
+            break;
+        case ScriptOpcode::SIN:
+            value = sin(left.as_number());
+            break;
+        case ScriptOpcode::COS:
+            value = cos(left.as_number());
+            break;
+        case ScriptOpcode::LOG_E:
+            value = log(left.as_number());
+            break;
+        case ScriptOpcode::LOG_2:
+            value = log2(left.as_number());
+            break;
+        case ScriptOpcode::LOG_10:
+            value = log10(left.as_number());
+            break;
+        case ScriptOpcode::NOT:
+            value = !left.as_bool();
+            break;
+        case ScriptOpcode::OR:
+            value = left.as_bool() || right.as_bool();
+            break;
+        case ScriptOpcode::AND:
+            value = left.as_bool() && right.as_bool();
+            break;
+        case ScriptOpcode::XOR:
+            value = left.as_bool() != right.as_bool();
+            break;
+        default:
+            value = ScriptValue();
+            break;
+    }
+
+    return true;
+}
+
+void ScriptProgram::connect_output(uint32_t node) {
+    assert(scene_);
+
+    const ScriptValue& method = get_input(node, 1);
+    if (method.is_none()) return;
+
+    SceneComponent::Channel* channel = nodes::find_output(
+        *scene_, get_input(node, 0),
+        output_bindings_[states_[node]].resolve(method));
+    if (!channel) return;
+
+    SceneComponent::Channel::Listener& listener = listeners_[states_[node]];
+
+    listener.unsubscribe();
+    channel->subscribe(listener);
+}
+
+void ScriptProgram::connect_input(uint32_t node) {
+    assert(scene_);
+
+    InputConnection& connection = connections_[states_[node]];
+
+    connection.output = SceneComponent::Channel();
+
+    const ScriptValue& method = get_input(node, 1);
+    if (method.is_none()) return;
+
+    SceneComponent::InputChannel* listener = nodes::find_input(
+        *scene_, get_input(node, 0), connection.binding.resolve(method));
+    if (!listener) return;
+
+    connection.output.subscribe(*listener);
+
+    connection.connected = true;
+}
@@ -0,0 +1,207 @@
+/**
+ * @file program.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Compiled level script
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include <optional>
+#include <vector>
+
+#include "logics/scene_component.h"
+#include "nodes/component_io.h"
+#include "opcode.h"
+#include "parser/tree_builder.h"
+#include "profile.h"
+#include "value.h"
+
+/**
+ * @brief Level script lowered into a flat dataflow program
+ *
+ * Nodes of the execution tree become indices into parallel arrays, and update
+ * subscriptions become a compressed (CSR) table of dependent nodes, which is
+ * walked by a single interpreter loop instead of recursive virtual calls.
+ * Dependents of a node are updated in the order they subscribed to it.
+ *
+ * In the batched mode updates of the channels only mark the dependent nodes
+ * dirty, and dirty nodes are evaluated on `flush()` in topological order, so
+ * every node is evaluated at most once per flush and outputs never see
+ * intermediate values of expressions with shared inputs.
+ *
+ * @warning Programs capture their own address in channel listeners, so they
+ * can not be copied or moved
+ */
+struct ScriptProgram final {
+    enum class Propagation : uint8_t {
+        // Updates are propagated depth-first as soon as they happen
+        IMMEDIATE,
+        // Updates are propagated on `flush()`
+        BATCHED,
+    };
+
+    /**
+     * @brief Lower an execution tree into a program
+     *
+     * @param[in] tree execution tree built by `build_exec_ast`
+     * @param[in] propagation update propagation mode
+     */
+    explicit ScriptProgram(const ParsedTree& tree,
+                           Propagation propagation = Propagation::IMMEDIATE);
+
+    ScriptProgram(const ScriptProgram&) = delete;
+    ScriptProgram& operator=(const ScriptProgram&) = delete;
+    ScriptProgram(ScriptProgram&&) = delete;
+    ScriptProgram& operator=(ScriptProgram&&) = delete;
+
+    /**
+     * @brief Bind the program to the scene and propagate the initial values
+     *
+     * @param[in] scene
+     */
+    void start(Scene& scene);
+
+    /**
+     * @brief Evaluate the nodes marked dirty since the last flush (does nothing
+     * in the immediate mode)
+     *
+     */
+    void flush();
+
+    Propagation get_propagation() const { return propagation_; }
+
+    /**
+     * @brief Record the updates of the nodes into the profile
+     *
+     * @param[in] profile profile built from the tree of the program (or
+     * `nullptr` to stop recording)
+     */
+    void set_profile(ScriptProfile* profile) { profile_ = profile; }
+
+    size_t get_node_count() const { return opcodes_.size(); }
+
+    /**
+     * @brief Get the value of the node
+     *
+     * @param[in] node node index
+     * @return const ScriptValue&
+     */
+    const ScriptValue& get_value(uint32_t node) const { return values_[node]; }
+
+    /**
+     * @brief Estimate the amount of memory used by the program
+     *
+     * @return size_t - size in bytes
+     */
+    size_t get_memory_usage() const;
+
+   private:
+    struct Frame {
+        uint32_t node;
+        uint32_t edge;
+    };
+
+    struct InputConnection {
+        SceneComponent::Channel output{};
+        nodes::ChannelBinding binding{};
+        bool connected = false;
+    };
+
+    /**
+     * @brief Notify the dependents of the node about its update
+     *
+     * @param[in] source index of the updated node
+     */
+    void propagate(uint32_t source);
+
+    /**
+     * @brief Mark the dependents of the node dirty
+     *
+     * @param[in] source index of the updated node
+     */
+    void mark_dependents(uint32_t source);
+
+    /**
+     * @brief Notify the dependents of the node about its update in the way
+     * the propagation mode requires
+     *
+     * @param[in] source index of the updated node
+     */
+    void notify(uint32_t source);
+
+    /**
+     * @brief Update the value of the node
+     *
+     * @param[in] node index of the node to update
+     * @param[in] changed mask of the inputs that have changed
+     * @return true if the dependents of the node should be updated
+     * @return false otherwise
+     */
+    bool evaluate(uint32_t node, uint8_t changed);
+
+    /**
+     * @brief Evaluate the node, recording the update into the profile
+     *
+     * @see `evaluate`
+     */
+    bool update(uint32_t node, uint8_t changed);
+
+    void connect_output(uint32_t node);
+    void connect_input(uint32_t node);
+
+    const ScriptValue& get_input(uint32_t node, uint32_t input) const {
+        return values_[inputs_[input_offsets_[node] + input]];
+    }
+
+    std::vector<ScriptOpcode> opcodes_{};
+    std::vector<ScriptValue> values_{};
+
+    // Inputs of the node `id` are `inputs_[input_offsets_[id] ...
+    // input_offsets_[id + 1]]`, in the same order as `Node::get_inputs()`
+    std::vector<uint32_t> input_offsets_{};
+    std::vector<uint32_t> inputs_{};
+
+    // Nodes updated after an update of the node, laid out the same way, and
+    // the masks of the positions of the node among their inputs (a node using
+    // an input several times is listed once)
+    std::vector<uint32_t> output_offsets_{};
+    std::vector<uint32_t> outputs_{};
+    std::vector<uint8_t> output_masks_{};
+
+    // Index of the node's state in the table of its opcode
+    std::vector<uint32_t> states_{};
+
+    std::vector<std::optional<ScriptValue>> previous_values_{};
+    std::vector<SceneComponent::Channel::Listener> listeners_{};
+    std::vector<nodes::ChannelBinding> output_bindings_{};
+    std::vector<InputConnection> connections_{};
+
+    // Nodes that propagate their values on start
+    std::vector<uint32_t> initial_{};
+
+    // Propagation stack, shared between nested propagations
+    std::vector<Frame> stack_{};
+
+    Propagation propagation_;
+
+    // Masks of the changed inputs of the nodes waiting for a batched update
+    std::vector<uint8_t> pending_{};
+
+    // Min-heap of the dirty node indices
+    std::vector<uint32_t> dirty_{};
+
+    // Source detectors that fired during the flush
+    std::vector<uint32_t> fired_sources_{};
+
+    Scene* scene_ = nullptr;
+
+    ScriptProfile* profile_ = nullptr;
+};
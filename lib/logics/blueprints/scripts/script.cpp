@@ -1,44 +1,55 @@
 #include "script.h"
 
+#include "logger/metrics.h"
 #include "logics/scene.h"
 #include "logics/scene_component.h"
-#include "parser/lexemizer.h"
+#include "native.h"
 #include "parser/tree_builder.h"
+#include "profile.h"
+#include "program.h"
+#include "script_cache.h"
 
-Script::Script(const std::string& string) : lexemes_(lexify(string)) {}
+Script::Script(const std::string& string)
+    : image_(ScriptCache::get(string)),
+      native_factory_(NativeScript::find(string)) {}
 
-static void insert_guids(std::vector<Lexeme::LexemePtr>& lexemes,
-                         const SubcomponentNameMap& name_map) {
-    for (auto& lexeme : lexemes) {
-        lexemes::NamedComponent* named_component =
-            lexeme.as<lexemes::NamedComponent>();
+void Script::assemble(Scene& scene, const SubcomponentNameMap& name_map) {
+    // Nodes of the previous assembly refer to the previous profile
+    nodes_.clear();
+    program_.reset();
+    native_.reset();
+    profile_.reset();
 
-        if (!named_component) continue;
+    if (native_factory_ && NativeScript::is_enabled() && compiled_ &&
+        !batched_ && !profiled_) {
+        native_ = native_factory_();
+        native_->start(scene, name_map);
+        return;
+    }
 
-        std::string name = named_component->get_name();
-        auto component = name_map.find(name);
+    ParsedTree tree = image_->instantiate(name_map);
 
-        if (component == name_map.end()) {
-            log_printf(ERROR_REPORTS, "error",
-                       "Could not find a component with the name \"%s\" "
-                       "(mentioned at line %lu, column %lu).\n",
-                       name.c_str(), lexeme->get_line(), lexeme->get_column());
-            continue;
-        }
-
-        named_component->set_guid(component->second->get_guid());
-    }
-}
+    if (profiled_) profile_ = std::make_shared<ScriptProfile>(tree);
 
-void Script::assemble(Scene& scene, const SubcomponentNameMap& name_map) {
-    insert_guids(lexemes_, name_map);
+    if (compiled_ || batched_) {
+        ScriptProgram::Propagation propagation =
+            batched_ ? ScriptProgram::Propagation::BATCHED
+                     : ScriptProgram::Propagation::IMMEDIATE;
 
-    ParsedTree tree = build_exec_ast(lexemes_);
+        // The tree is released once the program is built
+        program_ = std::make_shared<ScriptProgram>(tree, propagation);
+        program_->set_profile(profile_.get());
+        program_->start(scene);
+        return;
+    }
 
     nodes_ = tree.roots;
 
-    for (auto node : tree.nodes) {
-        node.lock()->assign_scene(scene);
+    for (size_t id = 0; id < tree.nodes.size(); ++id) {
+        std::shared_ptr<Node> node = tree.nodes[id].lock();
+
+        node->assign_scene(scene);
+        node->set_profile(profile_.get(), (uint32_t)id);
     }
 
     for (auto node : tree.queue) {
@@ -46,15 +57,36 @@ void Script::assemble(Scene& scene, const SubcomponentNameMap& name_map) {
     }
 }
 
+void Script::flush() {
+    if (program_) program_->flush();
+}
+
 void Script::Node::subscribe_to(ChildReference other_node) {
+    for (const Node* source : sources_) {
+        if (source == other_node.get()) return;
+    }
+
+    sources_.push_back(other_node.get());
+
     Update::Listener listener([this](Script::Node& node) {
-        bool should_notify = update(node);
+        static Counter& updates = Metrics::get_counter("script_node_updates");
+        updates.add();
+
+        bool should_notify = false;
+
+        if (profile_) {
+            uint64_t begin = profile_->begin_update();
+            should_notify = update(node);
+            profile_->end_update(profile_id_, begin);
+        } else {
+            should_notify = update(node);
+        }
+
         if (should_notify) {
             trigger();
         }
     });
 
-    other_node->get_update_event().subscribe(listener);
-
-    listeners_.push_back(listener);
+    listeners_.push_back(std::move(listener));
+    other_node->get_update_event().subscribe(listeners_.back());
 }
@@ -11,32 +11,131 @@
 
 #pragma once
 
+#include <memory>
+
 #include "logics/blueprints/component_factory.hpp"
-#include "parser/lexeme.h"
 
+struct NativeScript;
 struct Scene;
+struct ScriptImage;
+struct ScriptProfile;
+struct ScriptProgram;
 
 struct Script {
     struct Node;
 
+    /**
+     * @brief Parse the script or map its image from the script cache
+     *
+     * @param[in] string script source
+     */
     Script(const std::string& string);
 
-    Script(const Script& other) : lexemes_(other.lexemes_) {}
+    Script(const Script& other)
+        : image_(other.image_),
+          native_factory_(other.native_factory_),
+          compiled_(other.compiled_),
+          batched_(other.batched_),
+          profiled_(other.profiled_) {}
     Script& operator=(const Script& other) {
-        lexemes_ = other.lexemes_;
+        image_ = other.image_;
+        native_factory_ = other.native_factory_;
+        compiled_ = other.compiled_;
+        batched_ = other.batched_;
+        profiled_ = other.profiled_;
         nodes_.clear();
+        program_.reset();
+        native_.reset();
+        profile_.reset();
         return *this;
     }
 
     Script(Script&&) = default;
     Script& operator=(Script&&) = default;
 
+    /**
+     * @brief Build the script and bind it to the scene
+     *
+     * @note Compiled scripts that have a native version (see `NativeScript`)
+     * use it instead of a program, unless they are batched or profiled
+     * @param[in] scene
+     * @param[in] name_map components the script can refer to by name
+     */
     void assemble(Scene& scene, const SubcomponentNameMap& name_map);
 
+    /**
+     * @brief Set whether the script should be compiled into a `ScriptProgram`
+     * on assembly instead of being run as a tree of nodes
+     *
+     * @param[in] compiled
+     */
+    void set_compiled(bool compiled) { compiled_ = compiled; }
+    bool is_compiled() const { return compiled_; }
+
+    /**
+     * @brief Set whether updates of the script should be batched: nodes are
+     * marked dirty when their inputs change and evaluated once on `flush()`
+     *
+     * @note Batched scripts are always compiled
+     *
+     * @param[in] batched
+     */
+    void set_batched(bool batched) { batched_ = batched; }
+    bool is_batched() const { return batched_; }
+
+    /**
+     * @brief Evaluate the batched updates of the script (called by the scene
+     * once per physics tick)
+     *
+     */
+    void flush();
+
+    /**
+     * @brief Set whether the script should count and time the updates of its
+     * nodes (takes effect on the next assembly)
+     *
+     * @param[in] profiled
+     */
+    void set_profiled(bool profiled) { profiled_ = profiled; }
+    bool is_profiled() const { return profiled_; }
+
+    /**
+     * @brief Get the profile of the assembled profiled script
+     *
+     * @return const ScriptProfile* - the profile or `nullptr`
+     */
+    const ScriptProfile* get_profile() const { return profile_.get(); }
+
+    /**
+     * @brief Check if the assembled script runs its native version
+     *
+     */
+    bool is_native() const { return native_ != nullptr; }
+
+    /**
+     * @brief Get the program of the assembled compiled script
+     *
+     * @return const ScriptProgram* - the program or `nullptr`
+     */
+    const ScriptProgram* get_program() const { return program_.get(); }
+
    private:
-    std::vector<Lexeme::LexemePtr> lexemes_{};
+    // Parsed script, shared between the copies
+    std::shared_ptr<const ScriptImage> image_{};
+
+    // Factory of the native version of the script (if there is one)
+    std::unique_ptr<NativeScript> (*native_factory_)() = nullptr;
+
+    bool compiled_ = false;
+    bool batched_ = false;
+    bool profiled_ = false;
+
+    // Nodes and programs refer to the profile, so it is destroyed after them
+    std::shared_ptr<ScriptProfile> profile_{};
 
     std::vector<std::shared_ptr<Node>> nodes_{};
+    std::shared_ptr<ScriptProgram> program_{};
+    std::shared_ptr<NativeScript> native_{};
 };
 
 #include "node.h"
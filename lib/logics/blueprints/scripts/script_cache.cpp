@@ -0,0 +1,56 @@
+#include "script_cache.h"
+
+#include <stdio.h>
+
+#include "io/files.h"
+#include "logger/logger.h"
+#include "logger/metrics.h"
+
+std::string ScriptCache::directory_ = "";
+
+void ScriptCache::set_directory(const std::string& directory) {
+    directory_ = directory;
+}
+
+const std::string& ScriptCache::get_directory() { return directory_; }
+
+std::shared_ptr<const ScriptImage> ScriptCache::get(const std::string& source) {
+    static Counter& hits = Metrics::get_counter("script_cache_hits");
+    static Counter& misses = Metrics::get_counter("script_cache_misses");
+
+    if (directory_.empty()) return ScriptImage::compile(source);
+
+    hash_t hash = murmur_hash(source.c_str());
+
+    char name[32] = "";
+    snprintf(name, sizeof(name), "/%016zx.script.bin", hash);
+
+    std::string path = directory_ + name;
+
+    std::shared_ptr<const ScriptImage> image =
+        ScriptImage::load(path, hash, source.size());
+
+    if (image) {
+        hits.add();
+        return image;
+    }
+
+    misses.add();
+
+    image = ScriptImage::compile(source);
+
+    // Incomplete images are not stored, so that syntax errors are reported
+    // every time the script is loaded
+    if (image->is_complete()) {
+        if (create_directories(directory_)) {
+            image->save(path);
+        } else {
+            log_printf(WARNINGS, "warning",
+                       "Failed to create the script cache directory "
+                       "\"%s\".\n",
+                       directory_.c_str());
+        }
+    }
+
+    return image;
+}
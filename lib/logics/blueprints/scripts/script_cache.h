@@ -0,0 +1,46 @@
+/**
+ * @file script_cache.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief On-disk cache of parsed scripts
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "image.h"
+
+/**
+ * @brief Cache of script images, stored as files named by the hash of the
+ * script source
+ *
+ */
+struct ScriptCache final {
+    /**
+     * @brief Set the directory of the cache files (the directory is created
+     * when the first image is stored, an empty path disables the cache)
+     *
+     * @param[in] directory
+     */
+    static void set_directory(const std::string& directory);
+
+    static const std::string& get_directory();
+
+    /**
+     * @brief Get the image of the script, mapping it from the cache or parsing
+     * the script and storing its image on a miss
+     *
+     * @param[in] source script text
+     * @return std::shared_ptr<const ScriptImage>
+     */
+    static std::shared_ptr<const ScriptImage> get(const std::string& source);
+
+   private:
+    static std::string directory_;
+};
@@ -30,6 +30,15 @@ XML_IMPORTER(Script, "script") {
 
     const char* content = nullptr;
 
+    bool compiled = false;
+    data.QueryBoolAttribute("compiled", &compiled);
+
+    bool batched = false;
+    data.QueryBoolAttribute("batched", &batched);
+
+    bool profiled = false;
+    data.QueryBoolAttribute("profiled", &profiled);
+
     data.QueryStringAttribute("content", &content);
     data.QueryStringAttribute("script", &content);
     data.QueryStringAttribute("code", &content);
@@ -41,14 +50,23 @@ XML_IMPORTER(Script, "script") {
                    "will be used.\n");
     }
 
-    if (path) return AssetImporter<Script, "script">::import(std::string(path));
+    Asset<Script>* asset = nullptr;
 
-    if (!content) {
+    if (path) {
+        asset = static_cast<Asset<Script>*>(
+            AssetImporter<Script, "script">::import(std::string(path)));
+    } else if (content) {
+        asset = new Asset<Script>(std::string(content));
+    } else {
         log_printf(ERROR_REPORTS, "error",
                    "Neither path nor content of a script were found.\n");
+    }
 
-        return nullptr;
+    if (asset) {
+        asset->content.set_compiled(compiled);
+        asset->content.set_batched(batched);
+        asset->content.set_profiled(profiled);
     }
 
-    return new Asset<Script>(std::string(content));
+    return asset;
 }
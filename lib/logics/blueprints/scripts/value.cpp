@@ -0,0 +1,102 @@
+#include "value.h"
+
+#include <stdlib.h>
+
+double ScriptValue::as_number() const {
+    switch (type_) {
+        case Type::NUMBER:
+            return number_;
+        case Type::BOOL:
+            return boolean_ ? 1.0 : 0.0;
+        case Type::STRING:
+            return strtod(string_.c_str(), nullptr);
+        default:
+            return 0.0;
+    }
+}
+
+bool ScriptValue::as_bool() const {
+    switch (type_) {
+        case Type::NUMBER:
+            return number_ != 0.0;
+        case Type::BOOL:
+            return boolean_;
+        case Type::STRING:
+            return !string_.empty();
+        case Type::COMPONENT:
+            return guid_.valid();
+        default:
+            return false;
+    }
+}
+
+std::string ScriptValue::as_string() const {
+    switch (type_) {
+        case Type::NUMBER:
+            return std::to_string(number_);
+        case Type::BOOL:
+            return boolean_ ? "1" : "";
+        case Type::STRING:
+            return string_.str();
+        case Type::COMPONENT:
+            return guid_.to_string();
+        default:
+            return "";
+    }
+}
+
+GUID ScriptValue::as_guid() const {
+    switch (type_) {
+        case Type::COMPONENT:
+            return guid_;
+        case Type::STRING:
+            return GUID::from_string(string_.str());
+        default:
+            return GUID();
+    }
+}
+
+static bool is_numeric(ScriptValue::Type type) {
+    return type == ScriptValue::Type::NUMBER || type == ScriptValue::Type::BOOL;
+}
+
+bool ScriptValue::equals(const ScriptValue& other) const {
+    if (type_ == other.type_) return *this == other;
+
+    if (is_none() || other.is_none()) return false;
+
+    if (is_numeric(type_) && is_numeric(other.type_)) {
+        return as_number() == other.as_number();
+    }
+
+    if (type_ == Type::COMPONENT || other.type_ == Type::COMPONENT) {
+        return as_guid() == other.as_guid();
+    }
+
+    // A string and a number
+    const ScriptValue& string = type_ == Type::STRING ? *this : other;
+    const ScriptValue& number = type_ == Type::STRING ? other : *this;
+
+    char* end = nullptr;
+    double parsed = strtod(string.string_.c_str(), &end);
+
+    return !string.string_.empty() && *end == '\0' &&
+           parsed == number.as_number();
+}
+
+bool operator==(const ScriptValue& alpha, const ScriptValue& beta) {
+    if (alpha.type_ != beta.type_) return false;
+
+    switch (alpha.type_) {
+        case ScriptValue::Type::NUMBER:
+            return alpha.number_ == beta.number_;
+        case ScriptValue::Type::BOOL:
+            return alpha.boolean_ == beta.boolean_;
+        case ScriptValue::Type::STRING:
+            return alpha.string_ == beta.string_;
+        case ScriptValue::Type::COMPONENT:
+            return alpha.guid_ == beta.guid_;
+        default:
+            return true;
+    }
+}
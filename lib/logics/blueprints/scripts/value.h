@@ -0,0 +1,164 @@
+/**
+ * @file value.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Typed script value
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+
+#include <new>
+#include <string>
+
+#include "hash/guid.h"
+#include "hash/interned_string.h"
+
+/**
+ * @brief Value passed between script nodes and component channels
+ *
+ * Values keep their original type and are only converted when a consumer
+ * requests a different one.
+ */
+struct ScriptValue final {
+    enum class Type : uint8_t {
+        NONE,
+        NUMBER,
+        BOOL,
+        STRING,
+        COMPONENT,
+    };
+
+    ScriptValue() : number_(0.0) {}
+
+    ScriptValue(double number) : type_(Type::NUMBER), number_(number) {}
+    ScriptValue(int number) : ScriptValue((double)number) {}
+    ScriptValue(bool value) : type_(Type::BOOL), boolean_(value) {}
+
+    ScriptValue(InternedString string) : type_(Type::STRING), string_(string) {}
+    ScriptValue(const char* string) : ScriptValue(InternedString(string)) {}
+    ScriptValue(const std::string& string)
+        : ScriptValue(InternedString(string)) {}
+
+    ScriptValue(const GUID& guid) : type_(Type::COMPONENT), guid_(guid) {}
+
+    ScriptValue(const ScriptValue& other) : number_(0.0) { assign(other); }
+
+    ScriptValue& operator=(const ScriptValue& other) {
+        if (&other == this) return *this;
+
+        reset();
+        assign(other);
+
+        return *this;
+    }
+
+    ~ScriptValue() { reset(); }
+
+    Type get_type() const { return type_; }
+
+    bool is_none() const { return type_ == Type::NONE; }
+    bool has_value() const { return type_ != Type::NONE; }
+
+    /**
+     * @brief Interpret the value as a number (strings are parsed, `0.0` is
+     * returned for values without a numeric meaning)
+     *
+     * @return double
+     */
+    double as_number() const;
+
+    /**
+     * @brief Interpret the value as a boolean (numbers are true if non-zero,
+     * strings if not empty, components if their GUID is valid)
+     *
+     * @return bool
+     */
+    bool as_bool() const;
+
+    /**
+     * @brief Get string representation of the value
+     *
+     * @return std::string
+     */
+    std::string as_string() const;
+
+    /**
+     * @brief Get the string the value holds, without conversions
+     *
+     * @return InternedString - the string (empty if the value is not a string)
+     */
+    InternedString get_string() const {
+        return type_ == Type::STRING ? string_ : InternedString();
+    }
+
+    /**
+     * @brief Interpret the value as a component GUID (strings are parsed)
+     *
+     * @return GUID
+     */
+    GUID as_guid() const;
+
+    /**
+     * @brief Compare values the way the script `==` operator does: values of
+     * different types are compared after a conversion to the common type
+     *
+     * @param[in] other
+     * @return true
+     * @return false
+     */
+    bool equals(const ScriptValue& other) const;
+
+    /**
+     * @brief Check if the values have the same type and contents
+     *
+     */
+    friend bool operator==(const ScriptValue& alpha, const ScriptValue& beta);
+
+    friend bool operator!=(const ScriptValue& alpha, const ScriptValue& beta) {
+        return !(alpha == beta);
+    }
+
+   private:
+    void assign(const ScriptValue& other) {
+        type_ = other.type_;
+
+        switch (type_) {
+            case Type::NUMBER:
+                number_ = other.number_;
+                break;
+            case Type::BOOL:
+                boolean_ = other.boolean_;
+                break;
+            case Type::STRING:
+                new (&string_) InternedString(other.string_);
+                break;
+            case Type::COMPONENT:
+                guid_ = other.guid_;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void reset() {
+        if (type_ == Type::STRING) string_.~InternedString();
+
+        type_ = Type::NONE;
+        number_ = 0.0;
+    }
+
+    Type type_ = Type::NONE;
+
+    union {
+        double number_;
+        bool boolean_;
+        InternedString string_;
+        GUID guid_;
+    };
+};
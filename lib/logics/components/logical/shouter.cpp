@@ -2,10 +2,13 @@
 
 #include "logger/logger.h"
 
+const SceneComponent::ChannelTable ShouterComponent::CHANNELS =
+    ChannelTable().input<&ShouterComponent::input_>("shout");
+
 ShouterComponent::ShouterComponent(const std::string& name)
-    : name_(name), input_([name = name_](const std::string& message) {
+    : name_(name), input_([name = name_](const ScriptValue& message) {
           log_dup(ABSOLUTE_IMPORTANCE, "output", "%s: %s\n", name.c_str(),
-                  message.c_str());
+                  message.as_string().c_str());
       }) {
-    register_input("shout", input_);
+    use_channels(CHANNELS);
 }
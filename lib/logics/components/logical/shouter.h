@@ -17,6 +17,8 @@ struct ShouterComponent : public SceneComponent {
     ShouterComponent(const std::string& name);
 
    private:
+    static const ChannelTable CHANNELS;
+
     std::string name_;
     InputChannel input_;
 };
@@ -11,12 +11,27 @@
 
 #pragma once
 
+#include <memory>
+
 #include "graphics/objects/complex_model.h"
 #include "logics/scene_component.h"
+#include "managers/asset_manager.h"
 
 struct StaticMesh : public SceneComponent {
     explicit StaticMesh(const ComplexModel& model);
 
+    /**
+     * @brief Construct a static mesh of an acquired model, which is kept
+     * loaded while the mesh exists
+     *
+     * @tparam T model type
+     * @param[in] model
+     */
+    template <class T>
+    explicit StaticMesh(const AssetRef<T>& model) : StaticMesh(*model) {
+        source_ = std::make_shared<const AssetRef<T>>(model);
+    }
+
     void set_transform(const glm::mat4& transform);
     const glm::mat4& get_transform() const {
         return model_->get_object_matrix();
@@ -34,4 +49,7 @@ struct StaticMesh : public SceneComponent {
 
    private:
     Visual<ComplexModel> model_;
+
+    // Reference to the model asset, the parts of which are shared by the copy
+    std::shared_ptr<const void> source_{};
 };
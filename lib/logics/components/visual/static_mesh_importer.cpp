@@ -41,27 +41,31 @@ XML_BASED_IMPORTER(Producer, "static_mesh") {
 
     std::string path = demand<std::string>(data, "source", "NOT_MENTIONED");
 
-    const ComplexModel* model = AssetManager::request<ComplexModel>(path);
+    // The level keeps the assets loaded through its producers, and the meshes
+    // through their components
+    AssetRef<ComplexModel> model = AssetManager::acquire<ComplexModel>(path);
 
-    if (model == nullptr) {
+    if (!model) {
         ERROR("Failed to load underlying complex model \"%s\"\n", path.c_str());
+        return nullptr;
     }
 
-    bool import_collision = request<bool>(data, "collision", false);
+    AssetRef<CollisionGroup> colliders{};
+
+    if (request<bool>(data, "collision", false)) {
+        colliders = AssetManager::acquire<CollisionGroup>(path);
+    }
 
     return new Asset<Producer>(PRODUCER {
-        Subcomponent<StaticMesh> mesh(*model);
+        Subcomponent<StaticMesh> mesh(model);
         mesh->set_transform(parent_tform * transform);
 
-        if (!import_collision) return mesh;
+        if (!colliders) return mesh;
 
         Subcomponent<ComponentPack> pack;
 
         pack->add_component(mesh);
 
-        const CollisionGroup* colliders =
-            AssetManager::request<CollisionGroup>(path);
-
         for (BoxCollider collider : *colliders) {
             pack->add_component(Subcomponent<StaticBoxCollider>(
                 transform_collider(collider, parent_tform * transform)));
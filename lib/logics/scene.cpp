@@ -1,7 +1,11 @@
 #include "scene.h"
 
+#include <stdio.h>
+
+#include "blueprints/scripts/profile.h"
 #include "logger/logger.h"
 #include "scene_component.h"
+#include "time/profiler.h"
 
 Scene::Scene(double width, double height, double cell_size)
     : width_(width),
@@ -11,6 +15,9 @@ Scene::Scene(double width, double height, double cell_size)
                  (size_t)(width / cell_size), (size_t)(height / cell_size)) {}
 
 Scene::~Scene() {
+    // Tasks may refer to the components
+    tasks_.stop_all();
+
     for (auto& [guid, component] : shared_components_) {
         component->destroy(SceneComponent::EndPlayReason::Quit);
     }
@@ -30,6 +37,72 @@ std::shared_ptr<Script> Scene::add_script(const Script& script) {
     return scripts_.back();
 }
 
+bool Scene::dump_script_profiles(const char* path) const {
+    FILE* file = fopen(path, "w");
+
+    if (file == nullptr) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Failed to open file \"%s\" for the script profiles\n",
+                   path);
+        return false;
+    }
+
+    size_t count = 0;
+
+    for (size_t id = 0; id < scripts_.size(); ++id) {
+        const ScriptProfile* profile = scripts_[id]->get_profile();
+        if (profile == nullptr) continue;
+
+        fprintf(file, "Script %zu\n%s\n", id, profile->format().c_str());
+        ++count;
+    }
+
+    fclose(file);
+
+    log_printf(STATUS_REPORTS, "status",
+               "Dumped profiles of %zu scripts to \"%s\"\n", count, path);
+
+    return true;
+}
+
+void Scene::capture_state(SceneSnapshot& snapshot) const {
+    // Cleared buffers keep their capacity, so repeated captures into the same
+    // snapshot do not allocate.
+    snapshot.clear();
+
+    for (auto& [guid, component] : shared_components_) {
+        size_t size = component->get_state_size();
+        if (size == 0) continue;
+
+        size_t offset = snapshot.data.size();
+
+        snapshot.records.push_back({guid, offset, size});
+        snapshot.data.resize(offset + size);
+
+        component->save_state(snapshot.data.data() + offset);
+    }
+}
+
+void Scene::restore_state(const SceneSnapshot& snapshot) {
+    for (const SceneSnapshot::Record& record : snapshot.records) {
+        SceneComponent* component = get_component(record.guid);
+
+        if (component == nullptr || !component->is_valid()) continue;
+
+        if (component->get_state_size() != record.size) {
+            log_printf(ERROR_REPORTS, "error",
+                       "Snapshot state size mismatch for component "
+                       "(GUID " GUID_FMT_PRINTF ")\n",
+                       GUID_OUT(record.guid));
+            continue;
+        }
+
+        component->load_state(snapshot.data.data() + record.offset);
+
+        update_boxable_component(*component);
+    }
+}
+
 std::set<GUID> Scene::
     get_components_in_area(const Box& box, ComponentLayerId layer,
                            IntersectionType intersection) const {
@@ -101,11 +174,23 @@ void Scene::add_component(Subcomponent<SceneComponent> component) {
 }
 
 void Scene::phys_tick(double delta_time) {
+    PROFILE_ZONE("Scene::phys_tick");
+
+    // Events posted by other threads are delivered before the tick
+    DeferredEventQueue::get_default().dispatch();
+
     phys_tick_.trigger(delta_time);
 
+    tasks_.update(delta_time);
+
+    // Batched script updates are evaluated once per tick
+    for (const std::shared_ptr<Script>& script : scripts_) script->flush();
+
     process_deletions();
 }
 
 void Scene::draw_tick(double delta_time, double subtick_time) {
+    PROFILE_ZONE("Scene::draw_tick");
+
     draw_tick_.trigger(delta_time, subtick_time);
 }
\ No newline at end of file
@@ -21,7 +21,9 @@
 #include "graphics/objects/scene.h"
 #include "hash/guid.h"
 #include "physics/level_geometry.h"
+#include "snapshot.h"
 #include "subcomponent.hpp"
+#include "task.h"
 
 struct SceneComponent;
 
@@ -63,6 +65,53 @@ struct Scene {
 
     std::shared_ptr<Script> add_script(const Script& script);
 
+    /**
+     * @brief Write the profiles of the profiled scripts of the scene into a
+     * file (see `Script::set_profiled`)
+     *
+     * @param[in] path file name
+     * @return true on success
+     * @return false
+     */
+    bool dump_script_profiles(const char* path) const;
+
+    /**
+     * @brief Start a task that is run by the scene (see `Task`)
+     *
+     * @note Tasks waiting for `Task::next_tick()` are resumed after the
+     * physics tick event
+     *
+     * @param[in] task
+     */
+    void start_task(Task task) { tasks_.start(std::move(task)); }
+
+    /**
+     * @brief Get a token that expires along with the scene, so that deferred
+     * work (e.g. level streams) can tell whether the scene is still there
+     *
+     * @return std::weak_ptr<const void>
+     */
+    std::weak_ptr<const void> get_lifetime() const { return lifetime_; }
+
+    TaskScheduler& get_tasks() { return tasks_; }
+    const TaskScheduler& get_tasks() const { return tasks_; }
+
+    /**
+     * @brief Capture registered simulation state of all the scene components
+     *
+     * @param[out] snapshot
+     */
+    void capture_state(SceneSnapshot& snapshot) const;
+
+    /**
+     * @brief Restore the simulation state of the scene components
+     *
+     * @note Components that are no longer present on the scene are skipped
+     *
+     * @param[in] snapshot
+     */
+    void restore_state(const SceneSnapshot& snapshot);
+
     using ComponentLayerId = GUID;
 
     std::set<GUID> get_components_in_area(
@@ -103,10 +152,14 @@ struct Scene {
 
     std::vector<std::shared_ptr<Script>> scripts_{};
 
+    TaskScheduler tasks_{};
+
     TickEvent phys_tick_{};
     SubtickEvent draw_tick_{};
 
     std::map<ComponentLayerId, BoxField<GUID>> box_fields_{};
+
+    std::shared_ptr<const void> lifetime_ = std::make_shared<char>();
 };
 
 template <class T>
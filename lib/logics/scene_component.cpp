@@ -29,18 +29,38 @@ void SceneComponent::destroy(EndPlayReason reason) {
     if (scene_) scene_->delete_component(*this);
 }
 
-SceneComponent::OutputChannel* SceneComponent::
-    get_output(const std::string& name) {
-    auto found = outputs_.find(name);
-    if (found == outputs_.end()) return nullptr;
-    return &found->second.of(this);
+SceneComponent::OutputChannel* SceneComponent::get_output(Symbol name) {
+    if (!channels_) return nullptr;
+
+    for (const ChannelTable::Entry<OutputChannel>& entry : channels_->outputs) {
+        if (entry.name == name) return &entry.access(*this);
+    }
+
+    return nullptr;
+}
+
+SceneComponent::InputChannel* SceneComponent::get_input(Symbol name) {
+    if (!channels_) return nullptr;
+
+    for (const ChannelTable::Entry<InputChannel>& entry : channels_->inputs) {
+        if (entry.name == name) return &entry.access(*this);
+    }
+
+    return nullptr;
 }
 
-SceneComponent::InputChannel* SceneComponent::
-    get_input(const std::string& name) {
-    auto found = inputs_.find(name);
-    if (found == inputs_.end()) return nullptr;
-    return &found->second.of(this);
+void SceneComponent::save_state(char* buffer) const {
+    for (const StateBlock& block : state_blocks_) {
+        memcpy(buffer, &block.data.of(this), block.size);
+        buffer += block.size;
+    }
+}
+
+void SceneComponent::load_state(const char* buffer) {
+    for (const StateBlock& block : state_blocks_) {
+        memcpy(&block.data.of(this), buffer, block.size);
+        buffer += block.size;
+    }
 }
 
 void SceneComponent::use_positional_layer(Scene::ComponentLayerId layer) {
@@ -78,15 +98,6 @@ void SceneComponent::receive_draw_ticks() {
     get_scene().get_draw_tick_event().subscribe(draw_ticker_);
 }
 
-void SceneComponent::register_output(const std::string& name, Channel& output) {
-    outputs_.insert({name, RelativePtr<Channel>(&output, this)});
-}
-
-void SceneComponent::
-    register_input(const std::string& name, InputChannel& input) {
-    inputs_.insert({name, RelativePtr<InputChannel>(&input, this)});
-}
-
 void SceneComponent::attach(Subcomponent<SceneComponent> child) {
     WeakSubcomponent<SceneComponent> weak_child = child;
 
@@ -12,13 +12,18 @@
 #pragma once
 
 #include <concepts>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "events.h"
 #include "graphics/objects/scene.h"
 #include "hash/guid.h"
+#include "hash/symbol.h"
+#include "logics/blueprints/scripts/value.h"
 #include "memory/relative_ptr.hpp"
 #include "physics/level_geometry.h"
 #include "scene.h"
@@ -27,7 +32,7 @@
 struct SceneComponent {
     friend struct Scene;
 
-    using Channel = Event<const std::string&>;
+    using Channel = Event<const ScriptValue&>;
     using OutputChannel = Channel;
     using InputChannel = Channel::Multilistener;
 
@@ -37,6 +42,54 @@ struct SceneComponent {
         Quit,
     };
 
+    /**
+     * @brief Channels of a component class, shared by all of its instances
+     *
+     * Tables are built once per class from member pointers, e.g.
+     * `ChannelTable().output<&Ball::hit_>("hit")`, and a subclass extends
+     * the table of its parent by copying it first.
+     */
+    struct ChannelTable final {
+        template <class T>
+        struct Entry {
+            Symbol name;
+            T& (*access)(SceneComponent& component);
+        };
+
+        /**
+         * @brief Add an output channel
+         *
+         * @tparam Member pointer to the channel member of the component class
+         * @param[in] name name of the channel
+         * @return ChannelTable&
+         */
+        template <auto Member>
+        ChannelTable& output(StaticName name);
+
+        /**
+         * @brief Add an input channel listener
+         *
+         * @tparam Member pointer to the listener member of the component class
+         * @param[in] name name of the channel
+         * @return ChannelTable&
+         */
+        template <auto Member>
+        ChannelTable& input(StaticName name);
+
+        // Components have few channels, so they are searched linearly
+        std::vector<Entry<OutputChannel>> outputs{};
+        std::vector<Entry<InputChannel>> inputs{};
+
+       private:
+        template <auto Member>
+        static auto& access(SceneComponent& component);
+
+        template <class Owner, class T>
+        static Owner& get_owner(T Owner::*, SceneComponent& component) {
+            return static_cast<Owner&>(component);
+        }
+    };
+
     SceneComponent();
 
     SceneComponent(const SceneComponent&) = delete;
@@ -85,8 +138,14 @@ struct SceneComponent {
      */
     void destroy(EndPlayReason reason = EndPlayReason::Destroyed);
 
-    OutputChannel* get_output(const std::string& name);
-    InputChannel* get_input(const std::string& name);
+    /**
+     * @brief Find a registered channel of the component
+     *
+     * @param[in] name name of the channel
+     * @return OutputChannel* - the channel or `nullptr`
+     */
+    OutputChannel* get_output(Symbol name);
+    InputChannel* get_input(Symbol name);
 
     /**
      * @brief Capture component state for restoration
@@ -104,6 +163,27 @@ struct SceneComponent {
      */
     virtual void reset() {}
 
+    /**
+     * @brief Get the size of the component's registered simulation state
+     *
+     * @return size_t - size of the state in bytes
+     */
+    size_t get_state_size() const { return state_size_; }
+
+    /**
+     * @brief Write the registered simulation state into the buffer
+     *
+     * @param[out] buffer buffer of at least `get_state_size()` bytes
+     */
+    void save_state(char* buffer) const;
+
+    /**
+     * @brief Read the registered simulation state from the buffer
+     *
+     * @param[in] buffer buffer previously filled by `save_state`
+     */
+    void load_state(const char* buffer);
+
    protected:
     /**
      * @brief Make the component detectable on a component layer.
@@ -155,24 +235,27 @@ struct SceneComponent {
     void receive_draw_ticks();
 
     /**
-     * @brief Register an abstract output channel of the component
+     * @brief Set the channels of the component
      *
-     * @warning `output` must refer to a class member
+     * @warning The table must outlive the component and describe members of
+     * the component's class
      *
-     * @param[in] name name of the channel
-     * @param[in] output output channel member
+     * @param[in] channels static channel table of the class
      */
-    void register_output(const std::string& name, OutputChannel& output);
+    void use_channels(const ChannelTable& channels) { channels_ = &channels; }
 
     /**
-     * @brief Register abstract input channel listener of the component
+     * @brief Register a part of the component's simulation state, which gets
+     * captured by and restored from scene snapshots
      *
-     * @warning `input` must refer to a class member
+     * @warning `state` must refer to a class member
      *
-     * @param[in] name name of the channel
-     * @param[in] input channel listener member
+     * @tparam T state type
+     * @param[in] state state member
      */
-    void register_input(const std::string& name, InputChannel& input);
+    template <class T>
+        requires std::is_trivially_copyable_v<T>
+    void register_state(T& state);
 
     /**
      * @brief Construct a child object
@@ -233,8 +316,15 @@ struct SceneComponent {
     Event<Scene&>::Listener parent_spawned_listener_{};
     Event<EndPlayReason>::Listener parent_destroyed_listener_{};
 
-    std::unordered_map<std::string, RelativePtr<OutputChannel>> outputs_{};
-    std::unordered_map<std::string, RelativePtr<InputChannel>> inputs_{};
+    const ChannelTable* channels_ = nullptr;
+
+    struct StateBlock {
+        RelativePtr<char> data;
+        size_t size;
+    };
+
+    std::vector<StateBlock> state_blocks_{};
+    size_t state_size_ = 0;
 
     std::set<Scene::ComponentLayerId> registration_layers_{};
 
@@ -242,6 +332,34 @@ struct SceneComponent {
     bool box_update_scheduled_ = false;
 };
 
+template <auto Member>
+inline auto& SceneComponent::ChannelTable::access(SceneComponent& component) {
+    return get_owner(Member, component).*Member;
+}
+
+template <auto Member>
+inline SceneComponent::ChannelTable& SceneComponent::ChannelTable::
+    output(StaticName name) {
+    outputs.push_back({Symbol(name), &access<Member>});
+    return *this;
+}
+
+template <auto Member>
+inline SceneComponent::ChannelTable& SceneComponent::ChannelTable::
+    input(StaticName name) {
+    inputs.push_back({Symbol(name), &access<Member>});
+    return *this;
+}
+
+template <class T>
+    requires std::is_trivially_copyable_v<T>
+inline void SceneComponent::register_state(T& state) {
+    char* data = reinterpret_cast<char*>(&state);
+
+    state_blocks_.push_back({RelativePtr<char>(data, this), sizeof(T)});
+    state_size_ += sizeof(T);
+}
+
 template <class T, class... Ts>
     requires std::derived_from<T, SceneComponent>
 inline Subcomponent<T> SceneComponent::new_child(Ts&&... args) {
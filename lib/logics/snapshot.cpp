@@ -0,0 +1,158 @@
+#include "snapshot.h"
+
+#include <string.h>
+
+bool SceneSnapshot::has_same_layout(const SceneSnapshot& other) const {
+    if (records.size() != other.records.size()) return false;
+    if (data.size() != other.data.size()) return false;
+
+    for (size_t id = 0; id < records.size(); ++id) {
+        if (records[id].guid != other.records[id].guid) return false;
+        if (records[id].size != other.records[id].size) return false;
+    }
+
+    return true;
+}
+
+void SceneSnapshot::clear() {
+    records.clear();
+    data.clear();
+}
+
+SnapshotHistory::SnapshotHistory(size_t capacity, size_t keyframe_period)
+    : capacity_(capacity > 0 ? capacity : 1),
+      keyframe_period_(keyframe_period) {}
+
+void SnapshotHistory::push(const SceneSnapshot& snapshot) {
+    Frame frame;
+
+    if (frames_.empty() || frames_since_key_ >= keyframe_period_ ||
+        !snapshot.has_same_layout(latest_)) {
+        frame.key = snapshot;
+        frames_since_key_ = 0;
+    } else {
+        encode(latest_, snapshot, frame);
+        ++frames_since_key_;
+    }
+
+    frames_.push_back(std::move(frame));
+    latest_ = snapshot;
+
+    if (frames_.size() <= capacity_) return;
+
+    // The oldest frame is always a key frame, so its successor has to take
+    // its role before it gets dropped.
+    if (frames_.size() > 1 && !frames_[1].is_key) {
+        SceneSnapshot successor = frames_[0].key;
+        apply(frames_[1], successor);
+
+        frames_[1] = Frame();
+        frames_[1].key = std::move(successor);
+    }
+
+    frames_.pop_front();
+}
+
+bool SnapshotHistory::get(size_t age, SceneSnapshot& snapshot) const {
+    if (age >= frames_.size()) return false;
+
+    if (age == 0) {
+        snapshot = latest_;
+        return true;
+    }
+
+    reconstruct(frames_.size() - 1 - age, snapshot);
+
+    return true;
+}
+
+void SnapshotHistory::rewind(size_t age) {
+    if (age >= frames_.size()) {
+        clear();
+        return;
+    }
+
+    frames_.erase(frames_.end() - (ptrdiff_t)age, frames_.end());
+
+    reconstruct(frames_.size() - 1, latest_);
+
+    frames_since_key_ = 0;
+    for (size_t id = frames_.size() - 1; !frames_[id].is_key; --id) {
+        ++frames_since_key_;
+    }
+}
+
+void SnapshotHistory::clear() {
+    frames_.clear();
+    latest_.clear();
+    frames_since_key_ = 0;
+}
+
+size_t SnapshotHistory::get_memory_usage() const {
+    size_t usage = 0;
+
+    for (const Frame& frame : frames_) {
+        usage += frame.key.records.size() * sizeof(SceneSnapshot::Record);
+        usage += frame.key.data.size();
+        usage += frame.spans.size() * sizeof(Span);
+        usage += frame.bytes.size();
+    }
+
+    return usage;
+}
+
+void SnapshotHistory::encode(const SceneSnapshot& base,
+                             const SceneSnapshot& snapshot, Frame& frame) {
+    // Changed regions closer than this are merged into a single span
+    static const size_t SPAN_MERGE_GAP = 8;
+
+    frame.is_key = false;
+
+    const char* old_data = base.data.data();
+    const char* new_data = snapshot.data.data();
+    size_t size = snapshot.data.size();
+
+    size_t position = 0;
+    while (position < size) {
+        if (old_data[position] == new_data[position]) {
+            ++position;
+            continue;
+        }
+
+        size_t begin = position;
+        size_t end = position + 1;
+
+        for (position = end; position < size; ++position) {
+            if (position - end >= SPAN_MERGE_GAP) break;
+            if (old_data[position] != new_data[position]) end = position + 1;
+        }
+
+        frame.spans.push_back({(uint32_t)begin, (uint32_t)(end - begin)});
+        frame.bytes.insert(frame.bytes.end(), new_data + begin, new_data + end);
+    }
+}
+
+void SnapshotHistory::apply(const Frame& frame, SceneSnapshot& snapshot) {
+    if (frame.is_key) {
+        snapshot = frame.key;
+        return;
+    }
+
+    const char* bytes = frame.bytes.data();
+
+    for (const Span& span : frame.spans) {
+        memcpy(snapshot.data.data() + span.offset, bytes, span.size);
+        bytes += span.size;
+    }
+}
+
+void SnapshotHistory::reconstruct(size_t index, SceneSnapshot& snapshot) const {
+    size_t key_index = index;
+    while (!frames_[key_index].is_key) --key_index;
+
+    snapshot = frames_[key_index].key;
+
+    for (size_t id = key_index + 1; id <= index; ++id) {
+        apply(frames_[id], snapshot);
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * @file snapshot.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Scene state snapshots and their delta-compressed history
+ * @version 0.1
+ * @date 2025-02-04
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <vector>
+
+#include "hash/guid.h"
+
+/**
+ * @brief Simulation state of scene components, packed into a single buffer
+ *
+ * @see `Scene::capture_state`, `Scene::restore_state`
+ */
+struct SceneSnapshot {
+    struct Record {
+        GUID guid;
+        size_t offset;
+        size_t size;
+    };
+
+    /**
+     * @brief Check if the snapshot can be delta-encoded against another one
+     *
+     * @param[in] other
+     * @return true if both snapshots describe the same components
+     * @return false
+     */
+    bool has_same_layout(const SceneSnapshot& other) const;
+
+    void clear();
+
+    std::vector<Record> records{};
+    std::vector<char> data{};
+};
+
+/**
+ * @brief Ring of scene snapshots, storing frames as deltas against their
+ * predecessors
+ *
+ */
+struct SnapshotHistory final {
+    /**
+     * @brief Construct a new snapshot history
+     *
+     * @param[in] capacity maximum number of stored frames
+     * @param[in] keyframe_period maximum number of delta frames between full
+     * frames
+     */
+    explicit SnapshotHistory(size_t capacity, size_t keyframe_period = 64);
+
+    /**
+     * @brief Record a new frame
+     *
+     * @note Drops the oldest frame if the history is full
+     *
+     * @param[in] snapshot
+     */
+    void push(const SceneSnapshot& snapshot);
+
+    /**
+     * @brief Reconstruct a recorded frame
+     *
+     * @param[in] age number of frames recorded after the requested one
+     * @param[out] snapshot
+     * @return true if the frame was found
+     * @return false
+     */
+    bool get(size_t age, SceneSnapshot& snapshot) const;
+
+    /**
+     * @brief Drop the frames recorded after the specified one
+     *
+     * @param[in] age age of the frame to become the latest one
+     */
+    void rewind(size_t age);
+
+    void clear();
+
+    size_t size() const { return frames_.size(); }
+    size_t get_capacity() const { return capacity_; }
+
+    /**
+     * @brief Get the amount of memory occupied by recorded frame data
+     *
+     * @return size_t - size in bytes
+     */
+    size_t get_memory_usage() const;
+
+   private:
+    struct Span {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct Frame {
+        bool is_key = true;
+
+        SceneSnapshot key{};
+
+        std::vector<Span> spans{};
+        std::vector<char> bytes{};
+    };
+
+    static void encode(const SceneSnapshot& base, const SceneSnapshot& snapshot,
+                       Frame& frame);
+    static void apply(const Frame& frame, SceneSnapshot& snapshot);
+
+    void reconstruct(size_t index, SceneSnapshot& snapshot) const;
+
+    size_t capacity_;
+    size_t keyframe_period_;
+
+    size_t frames_since_key_ = 0;
+
+    std::deque<Frame> frames_{};
+
+    SceneSnapshot latest_{};
+};
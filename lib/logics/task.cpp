@@ -0,0 +1,204 @@
+#include "task.h"
+
+#include <exception>
+#include <new>
+
+#include "logger/logger.h"
+#include "scene.h"
+#include "scene_component.h"
+#include "time/profiler.h"
+
+// Frames are prefixed with the pool they were allocated from
+static const size_t FRAME_HEADER_SIZE = alignof(max_align_t);
+
+std::coroutine_handle<> Task::FinalAwaiter::
+    await_suspend(Handle handle) noexcept {
+    promise_type& promise = handle.promise();
+
+    if (promise.continuation) return promise.continuation;
+
+    // Tasks run by the scheduler are owned by it
+    if (promise.scheduler) promise.scheduler->finish(handle);
+
+    return std::noop_coroutine();
+}
+
+void Task::promise_type::unhandled_exception() const {
+    try {
+        throw;
+    } catch (const std::exception& exception) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Unhandled exception in a task: %s\n", exception.what());
+    } catch (...) {
+        log_printf(ERROR_REPORTS, "error", "Unhandled exception in a task\n");
+    }
+}
+
+void Task::promise_type::operator delete(void* frame, size_t size) {
+    char* block = (char*)frame - FRAME_HEADER_SIZE;
+    FramePool* pool = *(FramePool**)block;
+
+    if (pool) {
+        pool->deallocate(block, size + FRAME_HEADER_SIZE);
+    } else {
+        ::operator delete(block);
+    }
+}
+
+FramePool* Task::promise_type::get_pool(Scene& scene) {
+    return &scene.get_tasks().get_frame_pool();
+}
+
+FramePool* Task::promise_type::get_pool(SceneComponent& component) {
+    if (!component.has_scene()) return nullptr;
+
+    return &component.get_scene().get_tasks().get_frame_pool();
+}
+
+void* Task::promise_type::allocate(size_t size, FramePool* pool) {
+    size += FRAME_HEADER_SIZE;
+
+    char* block = (char*)(pool ? pool->allocate(size) : ::operator new(size));
+    *(FramePool**)block = pool;
+
+    return block + FRAME_HEADER_SIZE;
+}
+
+Task& Task::operator=(Task&& other) noexcept {
+    if (&other == this) return *this;
+
+    if (handle_) handle_.destroy();
+    handle_ = std::exchange(other.handle_, {});
+
+    return *this;
+}
+
+Task::~Task() {
+    if (handle_) handle_.destroy();
+}
+
+std::coroutine_handle<> Task::await_suspend(Handle parent) {
+    promise_type& promise = handle_.promise();
+
+    promise.continuation = parent;
+    promise.scheduler = parent.promise().scheduler;
+
+    return handle_;
+}
+
+void TaskScheduler::Waiter::unlink() {
+    if (list_ == nullptr) return;
+
+    if (prev_) {
+        prev_->next_ = next_;
+    } else {
+        list_->head_ = next_;
+    }
+
+    if (next_) {
+        next_->prev_ = prev_;
+    } else {
+        list_->tail_ = prev_;
+    }
+
+    prev_ = next_ = nullptr;
+    list_ = nullptr;
+}
+
+void TaskScheduler::WaitList::push(Waiter& waiter) {
+    waiter.unlink();
+
+    waiter.list_ = this;
+    waiter.prev_ = tail_;
+
+    if (tail_) {
+        tail_->next_ = &waiter;
+    } else {
+        head_ = &waiter;
+    }
+
+    tail_ = &waiter;
+}
+
+TaskScheduler::Waiter* TaskScheduler::WaitList::pop() {
+    Waiter* waiter = head_;
+    if (waiter) waiter->unlink();
+
+    return waiter;
+}
+
+void TaskScheduler::WaitList::splice(WaitList& other) {
+    while (Waiter* waiter = other.pop()) push(*waiter);
+}
+
+TaskScheduler::~TaskScheduler() { stop_all(); }
+
+void TaskScheduler::start(Task task) {
+    Task::Handle handle = task.release();
+    if (!handle) return;
+
+    Task::promise_type& promise = handle.promise();
+
+    promise.scheduler = this;
+    promise.prev = nullptr;
+    promise.next = tasks_;
+
+    if (tasks_) tasks_->prev = &promise;
+    tasks_ = &promise;
+
+    ++task_count_;
+
+    handle.resume();
+}
+
+void TaskScheduler::update(double delta_time) {
+    PROFILE_ZONE("TaskScheduler::update");
+
+    delta_time_ = delta_time;
+
+    // Only the tasks that waited for the tick before the update are resumed,
+    // others (including the ones woken up by events below) wait for the next
+    WaitList ticking;
+    ticking.splice(tick_waiters_);
+
+    // Events triggered since the last update
+    resume_all(ready_);
+
+    resume_all(ticking);
+
+    // Events triggered by the resumed tasks
+    resume_all(ready_);
+}
+
+void TaskScheduler::stop_all() {
+    while (tasks_) {
+        Task::promise_type& promise = *tasks_;
+
+        unlink(promise);
+        Task::Handle::from_promise(promise).destroy();
+    }
+}
+
+void TaskScheduler::finish(Task::Handle handle) {
+    unlink(handle.promise());
+    handle.destroy();
+}
+
+void TaskScheduler::unlink(Task::promise_type& promise) {
+    if (promise.prev) {
+        promise.prev->next = promise.next;
+    } else {
+        tasks_ = promise.next;
+    }
+
+    if (promise.next) promise.next->prev = promise.prev;
+
+    promise.prev = promise.next = nullptr;
+    promise.scheduler = nullptr;
+
+    --task_count_;
+}
+
+void TaskScheduler::resume_all(WaitList& list) {
+    while (Waiter* waiter = list.pop()) waiter->handle.resume();
+}
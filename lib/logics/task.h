@@ -0,0 +1,361 @@
+/**
+ * @file task.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Coroutine tasks for gameplay sequencing
+ * @version 0.1
+ * @date 2025-02-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <coroutine>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "memory/frame_pool.h"
+#include "pipelining/event.hpp"
+#include "time/world_timer.h"
+
+struct Scene;
+struct SceneComponent;
+struct TaskScheduler;
+
+template <class... Ts>
+struct EventAwaiter;
+
+struct TickAwaiter;
+struct DelayAwaiter;
+
+/**
+ * @brief Coroutine that can suspend itself until the next scene tick, a delay
+ * or an event
+ *
+ * Tasks start suspended and are run by the `TaskScheduler` of a scene (see
+ * `Scene::start_task`). They can also be awaited by other tasks.
+ *
+ * @note If the first parameter of the coroutine (or the object of a member
+ * coroutine) is a `Scene`, a `SceneComponent` on a scene or a `TaskScheduler`,
+ * the frame of the coroutine is allocated from the frame pool of its scheduler
+ *
+ * @warning Tasks that were not started should not outlive the scene they were
+ * created for
+ */
+struct Task final {
+    struct promise_type;
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(Handle handle) noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    struct promise_type {
+        Task get_return_object() { return Task(Handle::from_promise(*this)); }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+
+        void return_void() const {}
+        void unhandled_exception() const;
+
+        template <class T, class... Args>
+        static void* operator new(size_t size, T& first, Args&...) {
+            if constexpr (std::is_convertible_v<T*, TaskScheduler*>) {
+                return allocate(size, &first.get_frame_pool());
+            } else if constexpr (std::is_convertible_v<T*, Scene*>) {
+                return allocate(size, get_pool(static_cast<Scene&>(first)));
+            } else if constexpr (std::is_convertible_v<T*, SceneComponent*>) {
+                return allocate(size,
+                                get_pool(static_cast<SceneComponent&>(first)));
+            } else {
+                return allocate(size, nullptr);
+            }
+        }
+
+        static void* operator new(size_t size) {
+            return allocate(size, nullptr);
+        }
+
+        static void operator delete(void* frame, size_t size);
+
+        TaskScheduler* scheduler = nullptr;
+
+        // Task to resume once this one finishes
+        std::coroutine_handle<> continuation{};
+
+        // Links of the scheduler's list of running tasks
+        promise_type* prev = nullptr;
+        promise_type* next = nullptr;
+
+       private:
+        static FramePool* get_pool(Scene& scene);
+        static FramePool* get_pool(SceneComponent& component);
+
+        static void* allocate(size_t size, FramePool* pool);
+    };
+
+    Task() = default;
+    explicit Task(Handle handle) : handle_(handle) {}
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept;
+
+    ~Task();
+
+    bool is_valid() const { return (bool)handle_; }
+    bool is_done() const { return handle_ && handle_.done(); }
+
+    /**
+     * @brief Give up the ownership of the coroutine
+     *
+     * @return Handle
+     */
+    Handle release() { return std::exchange(handle_, {}); }
+
+    bool await_ready() const { return !handle_ || handle_.done(); }
+    std::coroutine_handle<> await_suspend(Handle parent);
+    void await_resume() const {}
+
+    /**
+     * @brief Suspend the task until the next tick of its scheduler
+     *
+     * @return awaitable that yields the tick delta time
+     */
+    static TickAwaiter next_tick();
+
+    /**
+     * @brief Suspend the task for the given amount of world time
+     *
+     * @note Resumed by `WorldTimer::run_scheduled_calls()`
+     *
+     * @param[in] seconds
+     * @return awaitable
+     */
+    static DelayAwaiter delay(double seconds);
+
+    /**
+     * @brief Suspend the task until the event gets triggered
+     *
+     * @note The task is resumed by its scheduler after the event is triggered
+     * (during the same tick, if the event is triggered by the scene)
+     *
+     * @param[in] event
+     * @return awaitable that yields the event payload (a single value or a
+     * tuple)
+     */
+    template <class... Ts>
+    static EventAwaiter<Ts...> wait_for(Event<Ts...>& event);
+
+   private:
+    Handle handle_{};
+};
+
+/**
+ * @brief Runner of scene tasks
+ *
+ */
+struct TaskScheduler final {
+    struct WaitList;
+
+    /**
+     * @brief Suspended task waiting to be resumed by the scheduler
+     *
+     */
+    struct Waiter {
+        Waiter() = default;
+        ~Waiter() { unlink(); }
+
+        Waiter(const Waiter&) = delete;
+        Waiter& operator=(const Waiter&) = delete;
+
+        void unlink();
+
+        std::coroutine_handle<> handle{};
+
+       private:
+        friend WaitList;
+
+        Waiter* prev_ = nullptr;
+        Waiter* next_ = nullptr;
+        WaitList* list_ = nullptr;
+    };
+
+    struct WaitList {
+        void push(Waiter& waiter);
+        Waiter* pop();
+
+        /**
+         * @brief Move all the waiters of the other list to the end of this one
+         *
+         * @param[in] other
+         */
+        void splice(WaitList& other);
+
+       private:
+        friend Waiter;
+
+        Waiter* head_ = nullptr;
+        Waiter* tail_ = nullptr;
+    };
+
+    TaskScheduler() = default;
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * @brief Run the task until its first suspension
+     *
+     * @param[in] task
+     */
+    void start(Task task);
+
+    /**
+     * @brief Resume the tasks waiting for the tick or for triggered events
+     *
+     * @param[in] delta_time
+     */
+    void update(double delta_time);
+
+    /**
+     * @brief Destroy all the running tasks
+     *
+     */
+    void stop_all();
+
+    size_t get_task_count() const { return task_count_; }
+
+    double get_delta_time() const { return delta_time_; }
+
+    FramePool& get_frame_pool() { return frame_pool_; }
+
+    void wait_tick(Waiter& waiter) { tick_waiters_.push(waiter); }
+    void make_ready(Waiter& waiter) { ready_.push(waiter); }
+
+    /**
+     * @brief Destroy the finished task
+     *
+     * @param[in] handle
+     */
+    void finish(Task::Handle handle);
+
+   private:
+    void unlink(Task::promise_type& promise);
+
+    static void resume_all(WaitList& list);
+
+    // Declared first, as it has to outlive the frames of the tasks
+    FramePool frame_pool_{};
+
+    Task::promise_type* tasks_ = nullptr;
+    size_t task_count_ = 0;
+
+    WaitList tick_waiters_{};
+    WaitList ready_{};
+
+    double delta_time_ = 0.0;
+};
+
+struct TickAwaiter final : TaskScheduler::Waiter {
+    bool await_ready() const { return false; }
+
+    void await_suspend(Task::Handle task) {
+        handle = task;
+        scheduler_ = task.promise().scheduler;
+        scheduler_->wait_tick(*this);
+    }
+
+    double await_resume() const { return scheduler_->get_delta_time(); }
+
+   private:
+    TaskScheduler* scheduler_ = nullptr;
+};
+
+struct DelayAwaiter final {
+    explicit DelayAwaiter(double delay) : delay_(delay) {}
+    ~DelayAwaiter() { WorldTimer::cancel(call_); }
+
+    DelayAwaiter(const DelayAwaiter&) = delete;
+    DelayAwaiter& operator=(const DelayAwaiter&) = delete;
+
+    bool await_ready() const { return delay_ <= 0.0; }
+
+    void await_suspend(std::coroutine_handle<> task) {
+        call_ = WorldTimer::schedule(delay_, [task]() { task.resume(); });
+    }
+
+    void await_resume() const {}
+
+   private:
+    double delay_;
+    WorldTimer::CallHandle call_{};
+};
+
+template <class... Ts>
+struct EventAwaiter final : TaskScheduler::Waiter {
+    explicit EventAwaiter(Event<Ts...>& event)
+        : event_(event),
+          listener_([this](Ts... args) { on_trigger(args...); }) {}
+
+    // The listener is bound to the awaiter
+    EventAwaiter(const EventAwaiter&) = delete;
+    EventAwaiter& operator=(const EventAwaiter&) = delete;
+
+    bool await_ready() const { return false; }
+
+    void await_suspend(Task::Handle task) {
+        handle = task;
+        scheduler_ = task.promise().scheduler;
+        listener_.subscribe_to(event_);
+    }
+
+    auto await_resume() {
+        listener_.unsubscribe();
+
+        if constexpr (sizeof...(Ts) == 1) {
+            return std::get<0>(std::move(*payload_));
+        } else if constexpr (sizeof...(Ts) > 1) {
+            return std::move(*payload_);
+        }
+    }
+
+   private:
+    void on_trigger(Ts... args) {
+        // Only the first trigger before the resumption is delivered
+        if (payload_) return;
+
+        payload_.emplace(args...);
+        scheduler_->make_ready(*this);
+    }
+
+    Event<Ts...>& event_;
+    typename Event<Ts...>::Listener listener_;
+
+    TaskScheduler* scheduler_ = nullptr;
+
+    std::optional<std::tuple<std::decay_t<Ts>...>> payload_{};
+};
+
+inline TickAwaiter Task::next_tick() { return TickAwaiter(); }
+
+inline DelayAwaiter Task::delay(double seconds) {
+    return DelayAwaiter(seconds);
+}
+
+template <class... Ts>
+inline EventAwaiter<Ts...> Task::wait_for(Event<Ts...>& event) {
+    return EventAwaiter<Ts...>(event);
+}
@@ -1,86 +1,175 @@
 #include <string.h>
 
+#include "logger/metrics.h"
+#include "pipelining/main_thread.h"
+#include "time/profiler.h"
+#include "time/world_timer.h"
+
 template <typename T>
 const T* AssetManager::request(const std::string& path,
                                std::optional<std::string_view> sign_suggestion,
                                RequestFlags flags) {
-    std::string signature = extract_signature(path);
+    PROFILE_ZONE("AssetManager::request");
 
-    std::string id_path = path;
-    if (sign_suggestion && signature != *sign_suggestion) {
-        id_path = path + "\t//." + std::string(*sign_suggestion) + ".//";
-    }
+    Lock guard = lock();
 
-    AssetManager::AssetRequest identifier(id_path, typeid(T).hash_code());
+    ++active_requests_;
+    Asset<T>* asset = import<T>(guard, path, sign_suggestion, flags);
+    --active_requests_;
 
-    if ((flags & RequestFlag::Reimport) == 0) {
-        auto asset = assets_.find(identifier);
-        if (asset != assets_.end()) {
-            return &((Asset<T>*)asset->second)->content;
-        }
+    if (asset == nullptr) return nullptr;
+
+    if (asset->rogue_ && !asset->pinned_) {
+        log_printf(WARNINGS, "warning",
+                   "Rogue asset \"%s\" is requested by pointer and will "
+                   "never be freed, acquire it instead.\n",
+                   path.c_str());
     }
 
+    // The lifetime of raw pointers is unknown
+    asset->pinned_ = true;
+
+    enforce_budget();
+
+    return &asset->content;
+}
+
+template <typename T>
+AssetRef<T> AssetManager::
+    acquire(const std::string& path,
+            std::optional<std::string_view> sign_suggestion,
+            RequestFlags flags) {
+    PROFILE_ZONE("AssetManager::acquire");
+
+    Lock guard = lock();
+
+    // The asset is referenced before the budget is enforced, so that it is
+    // not evicted right away
+    ++active_requests_;
+    AssetRef<T> reference(import<T>(guard, path, sign_suggestion, flags));
+    --active_requests_;
+
+    enforce_budget();
+
+    return reference;
+}
+
+template <typename T>
+Asset<T>* AssetManager::import(Lock& guard, const std::string& path,
+                               std::optional<std::string_view> sign_suggestion,
+                               RequestFlags flags) {
+    static Counter& cache_misses = Metrics::get_counter("asset_cache_misses");
+
+    record_request(path, sign_suggestion, typeid(T).hash_code(), flags);
+
+    AssetRequest identifier =
+        get_identifier(path, sign_suggestion, typeid(T).hash_code());
+
+    // Assets that are being imported by other requests (e.g. prefetched) are
+    // waited for. The callers defer the budget enforcement, so that the
+    // uploads performed while waiting do not evict the asset before it is
+    // handed out.
+    AbstractAsset* cached = find_cached(guard, identifier, flags);
+    if (cached != nullptr) return (Asset<T>*)cached;
+
+    cache_misses.add();
+
     log_printf(STATUS_REPORTS, "status", "Loading asset \"%s\" (type %0lX)\n",
                identifier.path.c_str(), identifier.type_id);
 
-    ImporterId importer_id(typeid(T).hash_code(), signature);
+    AbstractImporter* importer =
+        find_importer(path, sign_suggestion, identifier.type_id, flags);
 
-    AbstractImporter* importer = find_importer(importer_id);
+    if (importer == nullptr) return nullptr;
 
-    if (importer == nullptr && sign_suggestion) {
-        signature = *sign_suggestion;
-        importer_id = ImporterId(typeid(T).hash_code(), signature);
-        importer = find_importer(importer_id);
-    }
+    PendingResult result = start_import(identifier, flags);
 
-    if (importer == nullptr) {
-        if ((flags & RequestFlag::Silent) == 0) {
-            log_printf(
-                ERROR_REPORTS, "error",
-                "Failed to find an importer matching the signature \"%s\" "
-                "(type %0lX)\n",
-                signature.c_str(), importer_id.type_id);
-            printf(
-                "ERROR: Failed to find an importer for the asset at \"%s\", "
-                "see logs for more information.\n",
-                path.c_str());
-        }
+    static Histogram& import_time =
+        Metrics::get_histogram("asset_import_seconds");
 
-        return nullptr;
-    }
+    double import_start = WorldTimer::get_time_sec();
 
-    Asset<T>* imported = (Asset<T>*)importer->local_import(path, flags);
+    // Other assets can be requested (by the importer as well) in the meantime
+    guard.unlock();
+    AbstractAsset* imported = importer->local_import(path, flags);
+    guard.lock();
+
+    import_time.record(WorldTimer::get_time_sec() - import_start);
 
     if (imported == nullptr) {
-        if ((flags & RequestFlag::Silent) == 0) {
-            log_printf(ERROR_REPORTS, "error",
-                       "Failed to import asset \"%s\" (type %0lX)\n",
-                       path.c_str(), identifier.type_id);
-            printf(
-                "ERROR: Failed to import \"%s\", see logs for more "
-                "information.\n",
-                path.c_str());
-        }
-        return nullptr;
+        report_failure(path, identifier.type_id, flags);
     }
 
-    if (flags & RequestFlag::Rogue) {
-        register_rogue(imported);
-    } else {
-        if (assets_.count(identifier) > 0) {
-            delete assets_[identifier];
-        }
+    return (Asset<T>*)complete_import(identifier, imported, flags, false,
+                                      result);
+}
 
-        assets_[identifier] = imported;
-    }
+template <typename T>
+AssetHandle<T> AssetManager::
+    request_async(const std::string& path,
+                  std::optional<std::string_view> sign_suggestion,
+                  RequestFlags flags) {
+    Lock guard = lock();
+
+    record_request(path, sign_suggestion, typeid(T).hash_code(), flags);
 
-    return &imported->content;
+    return AssetHandle<T>(
+        start_request(path, sign_suggestion, typeid(T).hash_code(), flags,
+                      true));
 }
 
 template <typename T>
 const T* AssetManager::
     request(const tinyxml2::XMLElement& element,
             std::optional<std::string_view> handle, RequestFlags flags) {
+    PROFILE_ZONE("AssetManager::request");
+
+    Lock guard = lock();
+
+    ++active_requests_;
+    Asset<T>* asset = import<T>(guard, element, handle, flags);
+    --active_requests_;
+
+    if (asset == nullptr) return nullptr;
+
+    if (asset->rogue_ && !asset->pinned_) {
+        log_printf(WARNINGS, "warning",
+                   "Rogue XML asset (tag \"%s\") is requested by pointer and "
+                   "will never be freed, acquire it instead.\n",
+                   element.Name());
+    }
+
+    // The lifetime of raw pointers is unknown
+    asset->pinned_ = true;
+
+    enforce_budget();
+
+    return &asset->content;
+}
+
+template <typename T>
+AssetRef<T> AssetManager::
+    acquire(const tinyxml2::XMLElement& element,
+            std::optional<std::string_view> handle, RequestFlags flags) {
+    PROFILE_ZONE("AssetManager::acquire");
+
+    Lock guard = lock();
+
+    ++active_requests_;
+    AssetRef<T> reference(import<T>(guard, element, handle, flags));
+    --active_requests_;
+
+    enforce_budget();
+
+    return reference;
+}
+
+template <typename T>
+Asset<T>* AssetManager::import(Lock& guard, const tinyxml2::XMLElement& element,
+                               std::optional<std::string_view> handle,
+                               RequestFlags flags) {
+    static Counter& cache_misses = Metrics::get_counter("asset_cache_misses");
+
     const char* tag = element.Name();
 
     std::optional<AssetManager::AssetRequest> identifier{};
@@ -88,15 +177,13 @@ const T* AssetManager::
     if (handle) {
         identifier = AssetManager::
             AssetRequest(std::string(*handle), typeid(T).hash_code());
-    }
 
-    if (identifier && (flags & RequestFlag::Reimport) == 0) {
-        auto asset = assets_.find(*identifier);
-        if (asset != assets_.end()) {
-            return &((Asset<T>*)asset->second)->content;
-        }
+        AbstractAsset* cached = find_cached(guard, *identifier, flags);
+        if (cached != nullptr) return (Asset<T>*)cached;
     }
 
+    cache_misses.add();
+
     ImporterId importer_id(typeid(T).hash_code(), tag);
     AbstractXMLImporter* importer = find_xml_importer(importer_id);
 
@@ -116,30 +203,39 @@ const T* AssetManager::
         return nullptr;
     }
 
-    Asset<T>* imported = (Asset<T>*)importer->local_import(element, flags);
+    PendingResult result{};
+    if (identifier) result = start_import(*identifier, flags);
 
-    if (imported == nullptr) {
-        if ((flags & RequestFlag::Silent) == 0) {
-            log_printf(ERROR_REPORTS, "error",
-                       "Failed to import XML asset (tag: \"%s\", type %0lX)\n",
-                       tag, identifier->type_id);
-            printf(
-                "ERROR: Failed to import XML asset with tag \"%s\", see logs "
-                "for more information.\n",
-                tag);
-        }
-        return nullptr;
-    }
+    static Histogram& import_time =
+        Metrics::get_histogram("asset_import_seconds");
 
-    if (!identifier || (flags & RequestFlag::Rogue)) {
-        register_rogue(imported);
-    } else {
-        if (assets_.count(*identifier) > 0) {
-            delete assets_[*identifier];
-        }
+    double import_start = WorldTimer::get_time_sec();
+
+    guard.unlock();
+    AbstractAsset* imported = importer->local_import(element, flags);
+    guard.lock();
 
-        assets_[*identifier] = imported;
+    import_time.record(WorldTimer::get_time_sec() - import_start);
+
+    if (imported == nullptr && (flags & RequestFlag::Silent) == 0) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Failed to import XML asset (tag: \"%s\", type %0lX)\n",
+                   tag, importer_id.type_id);
+        printf(
+            "ERROR: Failed to import XML asset with tag \"%s\", see logs "
+            "for more information.\n",
+            tag);
+    }
+
+    if (identifier) {
+        return (Asset<T>*)complete_import(*identifier, imported, flags, false,
+                                          result);
     }
 
-    return &imported->content;
+    if (imported == nullptr) return nullptr;
+
+    imported->type_id_ = importer_id.type_id;
+    register_rogue(imported);
+
+    return (Asset<T>*)imported;
 }
@@ -1,11 +1,16 @@
 #include "asset_manager.h"
 
+#include <assert.h>
 #include <string.h>
 
+#include <algorithm>
+#include <fstream>
 #include <functional>
+#include <thread>
 
 #include "ctype.h"
 #include "logger/logger.h"
+#include "pipelining/thread_pool.hpp"
 
 size_t std::hash<ImporterId>::operator()(const ImporterId& id) const noexcept {
     size_t left = id.type_id;
@@ -26,6 +31,36 @@ std::unordered_map<ImporterId, AbstractXMLImporter*>
 std::unordered_map<AssetManager::AssetRequest, AbstractAsset*>
     AssetManager::assets_ = {};
 std::vector<AbstractAsset*> AssetManager::rogues_ = {};
+std::recursive_mutex AssetManager::mutex_{};
+std::unordered_map<AssetManager::AssetRequest, AssetManager::PendingAsset>
+    AssetManager::pending_ = {};
+
+std::mutex AssetManager::upload_mutex_{};
+std::condition_variable AssetManager::upload_condition_{};
+std::deque<AssetManager::PendingUpload> AssetManager::uploads_{};
+
+bool AssetManager::recording_ = false;
+std::vector<AssetManager::ManifestEntry> AssetManager::manifest_ = {};
+std::unordered_set<AssetManager::AssetRequest> AssetManager::recorded_ = {};
+std::unordered_set<AssetManager::AssetRequest> AssetManager::pinned_requests_ =
+    {};
+
+unsigned AssetManager::active_requests_ = 0;
+bool AssetManager::evicting_ = false;
+bool AssetManager::unloading_ = false;
+
+size_t AssetManager::memory_budget_ = 0;
+AssetMemory AssetManager::memory_usage_{};
+std::unordered_map<size_t, AssetMemory> AssetManager::type_memory_ = {};
+uint64_t AssetManager::use_clock_ = 0;
+
+static ThreadPool& get_worker_pool() {
+    // The main thread is kept free for the uploads and the simulation
+    static ThreadPool pool(
+        std::max(std::thread::hardware_concurrency(), 2u) - 1);
+
+    return pool;
+}
 
 void AssetManager::register_importer(AbstractImporter& importer) {
     const ImporterId& id = importer.get_id();
@@ -67,37 +102,594 @@ void AssetManager::register_importer(AbstractXMLImporter& importer) {
     xml_importers_.insert({id, &importer});
 }
 
+AssetManager::Lock AssetManager::lock() { return Lock(mutex_); }
+
 void AssetManager::unload_all() {
+    // Assets destroyed by other threads may still be queued
+    if (MainThread::is_current()) MainThread::process_queue();
+
+    Lock guard = lock();
+
+    // References held by the assets are dropped along with their targets
+    unloading_ = true;
+
     for (auto cell : assets_) {
-        delete cell.second;
+        destroy(cell.second);
     }
 
     for (AbstractAsset* asset : rogues_) {
-        delete asset;
+        destroy(asset);
     }
 
+    unloading_ = false;
+
     assets_.clear();
+    rogues_.clear();
+    type_memory_.clear();
+}
+
+void AssetManager::set_memory_budget(size_t budget) {
+    Lock guard = lock();
+
+    memory_budget_ = budget;
+    enforce_budget();
+}
+
+AssetMemory AssetManager::get_memory_usage() {
+    Lock guard = lock();
+
+    return memory_usage_;
+}
+
+AssetMemory AssetManager::get_memory_usage(size_t type_id) {
+    Lock guard = lock();
+
+    auto memory = type_memory_.find(type_id);
+    if (memory == type_memory_.end()) return AssetMemory{};
+    return memory->second;
+}
+
+size_t AssetManager::evict(size_t target) {
+    Lock guard = lock();
+
+    static Counter& evictions = Metrics::get_counter("asset_evictions");
+
+    if (memory_usage_.get_total() <= target) return 0;
+
+    std::vector<decltype(assets_)::iterator> candidates{};
+
+    for (auto cell = assets_.begin(); cell != assets_.end(); ++cell) {
+        const AbstractAsset& asset = *cell->second;
+        if (asset.references_ == 0 && !asset.pinned_) {
+            candidates.push_back(cell);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& left, const auto& right) {
+                  return left->second->last_use_ < right->second->last_use_;
+              });
+
+    size_t count = 0;
+
+    evicting_ = true;
+
+    for (auto cell : candidates) {
+        if (memory_usage_.get_total() <= target) break;
+
+        log_printf(STATUS_REPORTS, "status",
+                   "Evicting asset \"%s\" (type %0lX, %lu bytes)\n",
+                   cell->first.path.c_str(), cell->first.type_id,
+                   cell->second->memory_.get_total());
+
+        destroy(cell->second);
+        assets_.erase(cell);
+        ++count;
+    }
+
+    evicting_ = false;
+
+    evictions.add(count);
+
+    return count;
+}
+
+void AssetManager::account(AbstractAsset& asset, size_t type_id) {
+    static Gauge& cpu_memory = Metrics::get_gauge("asset_cpu_bytes");
+    static Gauge& gpu_memory = Metrics::get_gauge("asset_gpu_bytes");
+
+    asset.type_id_ = type_id;
+    asset.memory_ = asset.get_memory();
+
+    memory_usage_ += asset.memory_;
+    type_memory_[type_id] += asset.memory_;
+
+    cpu_memory.set((double)memory_usage_.cpu);
+    gpu_memory.set((double)memory_usage_.gpu);
+
+    touch(asset);
+}
+
+void AssetManager::destroy(AbstractAsset* asset) {
+    memory_usage_ -= asset->memory_;
+
+    auto memory = type_memory_.find(asset->type_id_);
+    if (memory != type_memory_.end()) memory->second -= asset->memory_;
+
+    // Assets may own graphics resources. Their destructors may release other
+    // assets, so other threads do not wait for them while holding the lock.
+    MainThread::post([asset]() { delete asset; });
+}
+
+void AssetManager::enforce_budget() {
+    if (active_requests_ > 0 || evicting_) return;
+
+    if (memory_budget_ == 0 || memory_usage_.get_total() <= memory_budget_)
+        return;
+
+    evict(memory_budget_);
+}
+
+void AssetManager::retain(AbstractAsset& asset) {
+    Lock guard = lock();
+
+    ++asset.references_;
+}
+
+void AssetManager::release(AbstractAsset& asset) {
+    Lock guard = lock();
+
+    if (unloading_) return;
+
+    assert(asset.references_ > 0);
+
+    if (--asset.references_ > 0) return;
+
+    // Rogue assets are not shared, so nothing can request them again
+    if (asset.rogue_ && !asset.pinned_) {
+        rogues_.erase(std::find(rogues_.begin(), rogues_.end(), &asset));
+        destroy(&asset);
+        return;
+    }
+
+    enforce_budget();
+}
+
+size_t AssetManager::process_uploads(double deadline) {
+    assert(MainThread::is_current());
+
+    PROFILE_ZONE("AssetManager::process_uploads");
+
+    size_t count = 0;
+
+    do {
+        std::optional<PendingUpload> upload{};
+
+        {
+            std::lock_guard<std::mutex> lock(upload_mutex_);
+
+            if (uploads_.empty()) break;
+
+            upload.emplace(std::move(uploads_.front()));
+            uploads_.pop_front();
+        }
+
+        finish_upload(*upload);
+        ++count;
+    } while (WorldTimer::get_time_sec() < deadline);
+
+    return count;
+}
+
+void AssetManager::wait(const std::shared_future<AbstractAsset*>& future) {
+    static constexpr std::chrono::milliseconds POLL_PERIOD(1);
+
+    if (!MainThread::is_current()) {
+        // The main thread may be waiting for this one, so the decoded uploads
+        // are handed over to it
+        while (future.wait_for(POLL_PERIOD) != std::future_status::ready) {
+            bool decoded = false;
+
+            {
+                std::lock_guard<std::mutex> lock(upload_mutex_);
+                decoded = !uploads_.empty();
+            }
+
+            if (decoded) MainThread::call([]() { return process_uploads(); });
+        }
+
+        return;
+    }
+
+    for (;;) {
+        // Decoders may be waiting for the main thread as well
+        MainThread::process_queue();
+        process_uploads();
+
+        if (future.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready)
+            return;
+
+        std::unique_lock<std::mutex> lock(upload_mutex_);
+        upload_condition_.wait_for(lock, POLL_PERIOD,
+                                   []() { return !uploads_.empty(); });
+    }
+}
+
+size_t AssetManager::get_pending_count() {
+    Lock guard = lock();
+
+    return pending_.size();
+}
+
+AssetManager::PendingAsset AssetManager::
+    start_request(const std::string& path,
+                  std::optional<std::string_view> suggestion, size_t type_id,
+                  RequestFlags flags, bool pinned) {
+    PROFILE_ZONE("AssetManager::request_async");
+
+    static Counter& cache_hits = Metrics::get_counter("asset_cache_hits");
+    static Counter& cache_misses = Metrics::get_counter("asset_cache_misses");
+    static Counter& shared_requests =
+        Metrics::get_counter("asset_shared_requests");
+
+    Lock guard = lock();
+
+    AssetRequest identifier = get_identifier(path, suggestion, type_id);
+
+    auto result = std::make_shared<std::promise<AbstractAsset*>>();
+    PendingAsset future = result->get_future().share();
+
+    // Reimports and rogue imports produce assets of their own
+    bool shared = (flags & (RequestFlag::Reimport | RequestFlag::Rogue)) == 0;
+
+    if (shared) {
+        auto asset = assets_.find(identifier);
+        if (asset != assets_.end()) {
+            cache_hits.add();
+            touch(*asset->second);
+            if (pinned) asset->second->pinned_ = true;
+            result->set_value(asset->second);
+            return future;
+        }
+
+        auto pending = pending_.find(identifier);
+        if (pending != pending_.end()) {
+            shared_requests.add();
+            if (pinned) pinned_requests_.insert(identifier);
+            return pending->second;
+        }
+    }
+
+    cache_misses.add();
+
+    log_printf(STATUS_REPORTS, "status",
+               "Loading asset \"%s\" (type %0lX) asynchronously\n",
+               identifier.path.c_str(), identifier.type_id);
+
+    AbstractImporter* importer =
+        find_importer(path, suggestion, type_id, flags);
+
+    if (importer == nullptr) {
+        result->set_value(nullptr);
+        return future;
+    }
+
+    if (shared) pending_.insert({identifier, future});
+
+    get_worker_pool().submit([importer, identifier, path, flags, pinned,
+                              result]() {
+        Upload upload = importer->decode(path, flags);
+
+        {
+            std::lock_guard<std::mutex> lock(upload_mutex_);
+            uploads_.push_back(
+                {identifier, path, flags, pinned, std::move(upload), result});
+        }
+
+        upload_condition_.notify_all();
+    });
+
+    return future;
+}
+
+void AssetManager::finish_upload(PendingUpload& upload) {
+    static Histogram& upload_time =
+        Metrics::get_histogram("asset_upload_seconds");
+
+    double upload_start = WorldTimer::get_time_sec();
+
+    AbstractAsset* imported = upload.upload ? upload.upload() : nullptr;
+
+    upload_time.record(WorldTimer::get_time_sec() - upload_start);
+
+    Lock guard = lock();
+
+    if (imported == nullptr) {
+        report_failure(upload.path, upload.identifier.type_id, upload.flags);
+    }
+
+    complete_import(upload.identifier, imported, upload.flags, upload.pinned,
+                    upload.result);
+
+    enforce_budget();
+}
+
+AbstractAsset* AssetManager::
+    find_cached(Lock& guard, const AssetRequest& identifier,
+                RequestFlags flags) {
+    static Counter& cache_hits = Metrics::get_counter("asset_cache_hits");
+
+    if (flags & RequestFlag::Reimport) return nullptr;
+
+    for (;;) {
+        auto asset = assets_.find(identifier);
+        if (asset != assets_.end()) {
+            cache_hits.add();
+            touch(*asset->second);
+            return asset->second;
+        }
+
+        // Rogue imports produce assets of their own
+        if (flags & RequestFlag::Rogue) return nullptr;
+
+        auto pending = pending_.find(identifier);
+        if (pending == pending_.end()) return nullptr;
+
+        // The asset is looked up again, as it may have been evicted before
+        // the lock is regained. Failed imports are retried to report the
+        // errors.
+        PendingAsset future = pending->second;
+
+        guard.unlock();
+        wait(future);
+        guard.lock();
+    }
+}
+
+AssetManager::PendingResult AssetManager::
+    start_import(const AssetRequest& identifier, RequestFlags flags) {
+    // Reimports and rogue imports produce assets of their own
+    if (flags & (RequestFlag::Reimport | RequestFlag::Rogue)) return nullptr;
+
+    auto result = std::make_shared<std::promise<AbstractAsset*>>();
+    pending_.insert({identifier, result->get_future().share()});
+
+    return result;
+}
+
+AbstractAsset* AssetManager::
+    complete_import(const AssetRequest& identifier, AbstractAsset* imported,
+                    RequestFlags flags, bool pinned,
+                    const PendingResult& result) {
+    bool shared = (flags & (RequestFlag::Reimport | RequestFlag::Rogue)) == 0;
+
+    if (shared) {
+        pending_.erase(identifier);
+        pinned = pinned_requests_.erase(identifier) > 0 || pinned;
+    }
+
+    if (imported != nullptr) {
+        auto cached = assets_.find(identifier);
+
+        if (shared && cached != assets_.end()) {
+            // A reimport has replaced the asset in the meantime, and its
+            // pointer may already be in use
+            MainThread::post([imported]() { delete imported; });
+            imported = cached->second;
+        } else {
+            store(identifier, imported, flags);
+        }
+
+        touch(*imported);
+        if (pinned) imported->pinned_ = true;
+    }
+
+    if (result) result->set_value(imported);
+
+    return imported;
+}
+
+void AssetManager::record_request(const std::string& path,
+                                  std::optional<std::string_view> suggestion,
+                                  size_t type_id, RequestFlags flags) {
+    // Rogue assets are not shared, so there is no point in prefetching them
+    if (!recording_ || (flags & RequestFlag::Rogue)) return;
+
+    if (!recorded_.insert(get_identifier(path, suggestion, type_id)).second)
+        return;
+
+    std::optional<std::string> signature{};
+    if (suggestion) signature = std::string(*suggestion);
+
+    manifest_.push_back({path, type_id, signature});
+}
+
+bool AssetManager::save_manifest(const std::string& path) {
+    Lock guard = lock();
+
+    FILE* file = fopen(path.c_str(), "w");
+
+    if (file == nullptr) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Failed to create the asset manifest \"%s\".\n",
+                   path.c_str());
+        return false;
+    }
+
+    for (const ManifestEntry& entry : manifest_) {
+        fprintf(file, "%0lX\t%s\t%s\n", entry.type_id,
+                entry.signature ? entry.signature->c_str() : "",
+                entry.path.c_str());
+    }
+
+    bool saved = ferror(file) == 0;
+    saved = fclose(file) == 0 && saved;
+
+    log_printf(STATUS_REPORTS, "status",
+               "Saved %lu asset requests to the manifest \"%s\".\n",
+               manifest_.size(), path.c_str());
+
+    return saved;
+}
+
+size_t AssetManager::prefetch(const std::string& path) {
+    std::ifstream stream(path);
+    if (!stream.good()) return 0;
+
+    PROFILE_ZONE("AssetManager::prefetch");
+
+    size_t count = 0;
+
+    for (std::string line; std::getline(stream, line);) {
+        size_t signature_start = line.find('\t');
+        if (signature_start == std::string::npos) continue;
+
+        size_t path_start = line.find('\t', signature_start + 1);
+        if (path_start == std::string::npos) continue;
+
+        size_t type_id = strtoul(line.c_str(), nullptr, 16);
+
+        std::string_view signature(line.c_str() + signature_start + 1,
+                                   path_start - signature_start - 1);
+
+        std::optional<std::string_view> suggestion{};
+        if (!signature.empty()) suggestion = signature;
+
+        // Stale entries are skipped silently, the requests will report them
+        start_request(line.substr(path_start + 1), suggestion, type_id,
+                      RequestFlag::Silent, false);
+
+        ++count;
+    }
+
+    log_printf(STATUS_REPORTS, "status",
+               "Prefetching %lu assets listed in \"%s\".\n", count,
+               path.c_str());
+
+    return count;
+}
+
+AssetManager::AssetRequest AssetManager::
+    get_identifier(const std::string& path,
+                   std::optional<std::string_view> suggestion,
+                   size_t type_id) {
+    std::string id_path = path;
+
+    if (suggestion && extract_signature(path) != *suggestion) {
+        id_path = path + "\t//." + std::string(*suggestion) + ".//";
+    }
+
+    return AssetRequest(id_path, type_id);
+}
+
+AbstractImporter* AssetManager::
+    find_importer(const std::string& path,
+                  std::optional<std::string_view> suggestion, size_t type_id,
+                  RequestFlags flags) {
+    std::string signature = extract_signature(path);
+
+    AbstractImporter* importer = find_importer(ImporterId(type_id, signature));
+
+    if (importer == nullptr && suggestion) {
+        signature = *suggestion;
+        importer = find_importer(ImporterId(type_id, signature));
+    }
+
+    if (importer == nullptr && (flags & RequestFlag::Silent) == 0) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Failed to find an importer matching the signature \"%s\" "
+                   "(type %0lX)\n",
+                   signature.c_str(), type_id);
+        printf(
+            "ERROR: Failed to find an importer for the asset at \"%s\", "
+            "see logs for more information.\n",
+            path.c_str());
+    }
+
+    return importer;
+}
+
+void AssetManager::report_failure(const std::string& path, size_t type_id,
+                                  RequestFlags flags) {
+    if (flags & RequestFlag::Silent) return;
+
+    log_printf(ERROR_REPORTS, "error",
+               "Failed to import asset \"%s\" (type %0lX)\n", path.c_str(),
+               type_id);
+    printf(
+        "ERROR: Failed to import \"%s\", see logs for more "
+        "information.\n",
+        path.c_str());
+}
+
+void AssetManager::store(const AssetRequest& identifier, AbstractAsset* asset,
+                         RequestFlags flags) {
+    asset->type_id_ = identifier.type_id;
+
+    if (flags & RequestFlag::Rogue) {
+        register_rogue(asset);
+        return;
+    }
+
+    auto cached = assets_.find(identifier);
+
+    if (cached != assets_.end()) {
+        // Referenced assets are replaced, but kept until they are released
+        if (cached->second->references_ > 0) {
+            cached->second->rogue_ = true;
+            rogues_.push_back(cached->second);
+        } else {
+            destroy(cached->second);
+        }
+
+        cached->second = asset;
+    } else {
+        assets_.insert({identifier, asset});
+    }
+
+    account(*asset, identifier.type_id);
 }
 
 void AssetManager::register_rogue(AbstractAsset* asset) {
+    Lock guard = lock();
+
+    asset->rogue_ = true;
     rogues_.push_back(asset);
+
+    account(*asset, asset->type_id_);
 }
 
 void AssetManager::dump(unsigned importance) {
+    Lock guard = lock();
+
     log_printf(importance, "dump",
-               "Currently loaded assets (%lu unique, %lu rogues):\n",
-               assets_.size(), rogues_.size());
+               "Currently loaded assets (%lu unique, %lu rogues, %lu CPU "
+               "bytes, %lu GPU bytes):\n",
+               assets_.size(), rogues_.size(), memory_usage_.cpu,
+               memory_usage_.gpu);
 
     size_t index = 0;
     for (auto& [key, value] : assets_) {
-        _log_printf(importance, "dump", "\t%6lu (%lu)\t%s\n", index,
-                    key.type_id, key.path.c_str());
+        _log_printf(importance, "dump", "\t%6lu (%lu)\t%s\t%lu/%lu%s\n",
+                    index, key.type_id, key.path.c_str(), value->memory_.cpu,
+                    value->memory_.gpu, value->pinned_ ? "" : " (evictable)");
         ++index;
     }
 
     _log_printf(importance, "dump", "\t+%lu rogues\n", rogues_.size());
 }
 
+AssetMemory AbstractAsset::get_memory() const {
+    AssetMemory memory{};
+
+    for (const std::unique_ptr<AbstractAsset>& asset : owned_) {
+        memory += asset->get_memory();
+    }
+
+    return memory;
+}
+
 std::string AssetManager::extract_signature(std::string_view name) {
     std::string answer;
 
@@ -131,6 +723,11 @@ AbstractImporter::AbstractImporter(size_t type_id, const std::string& signature)
     AssetManager::register_importer(*this);
 }
 
+AssetManager::Upload AbstractImporter::decode(
+    const std::string& path, AssetManager::RequestFlags flags) const {
+    return [this, path, flags]() { return local_import(path, flags); };
+}
+
 AbstractXMLImporter::AbstractXMLImporter(size_t type_id,
                                          const std::string& signature)
     : id_(type_id, signature) {
@@ -15,11 +15,20 @@
 #include <tinyxml2.h>
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "hash/murmur.h"
@@ -31,9 +40,46 @@ struct AbstractAsset;
 struct AbstractImporter;
 struct AbstractXMLImporter;
 
+template <class T>
+struct AssetHandle;
+
+template <class T>
+struct AssetRef;
+
+template <class T>
+struct Asset;
+
+/**
+ * @brief Memory used by assets (in bytes)
+ *
+ */
+struct AssetMemory final {
+    size_t cpu = 0;
+    size_t gpu = 0;
+
+    size_t get_total() const { return cpu + gpu; }
+
+    AssetMemory& operator+=(const AssetMemory& memory) {
+        cpu += memory.cpu;
+        gpu += memory.gpu;
+        return *this;
+    }
+
+    AssetMemory& operator-=(const AssetMemory& memory) {
+        cpu -= memory.cpu;
+        gpu -= memory.gpu;
+        return *this;
+    }
+};
+
 /**
  * @brief Asset/importer registry and dispatcher
  *
+ * Assets can be requested from any thread. Requests are imported on the
+ * calling threads concurrently (requests of an asset that is already being
+ * imported wait for it), while importers perform their graphics context calls
+ * on the main thread (see `MainThread::call`).
+ *
  */
 struct AssetManager final {
     /**
@@ -51,12 +97,22 @@ struct AssetManager final {
 
     using RequestFlags = unsigned;
 
+    /**
+     * @brief Main thread stage of an asset import (the one that may use the
+     * graphics context), returns the imported asset or `nullptr`
+     *
+     */
+    using Upload = std::function<AbstractAsset*()>;
+
     static void register_importer(AbstractImporter& importer);
     static void register_importer(AbstractXMLImporter& importer);
 
     /**
      * @brief Request asset from a file
      *
+     * @note Assets requested this way are never evicted or freed, including
+     * rogue ones (see `acquire`)
+     *
      * @tparam T asset type
      * @param[in] path path to the asset file
      * @param[in] signature optional signature suggestion
@@ -68,9 +124,31 @@ struct AssetManager final {
                             std::optional<std::string_view> signature = {},
                             RequestFlags flags = 0);
 
+    /**
+     * @brief Request asset from a file, keeping it loaded while the returned
+     * reference (or its copies) exist
+     *
+     * Unreferenced assets that have only been acquired can be evicted when
+     * the memory budget is exceeded, in which case the next request imports
+     * them again.
+     *
+     * @tparam T asset type
+     * @param[in] path path to the asset file
+     * @param[in] signature optional signature suggestion
+     * @param[in] flags
+     * @return AssetRef<T> reference to the asset, empty if could not import
+     */
+    template <typename T>
+    static AssetRef<T> acquire(const std::string& path,
+                               std::optional<std::string_view> signature = {},
+                               RequestFlags flags = 0);
+
     /**
      * @brief Request asset of type T from an XML element
      *
+     * @note Assets requested this way are never evicted or freed, including
+     * rogue ones (see `acquire`)
+     *
      * @tparam T asset type
      * @param[in] element
      * @param[in] handle optional asset identifier for persistent storage (rogue
@@ -83,6 +161,138 @@ struct AssetManager final {
                             std::optional<std::string_view> handle = {},
                             RequestFlags flags = 0);
 
+    /**
+     * @brief Request asset of type T from an XML element, keeping it loaded
+     * while the returned reference (or its copies) exist
+     *
+     * Rogue assets are freed along with their last reference.
+     *
+     * @tparam T asset type
+     * @param[in] element
+     * @param[in] handle optional asset identifier for persistent storage (rogue
+     * import if not specified)
+     * @param[in] flags
+     * @return AssetRef<T> reference to the asset, empty if could not import
+     */
+    template <typename T>
+    static AssetRef<T> acquire(const tinyxml2::XMLElement& element,
+                               std::optional<std::string_view> handle = {},
+                               RequestFlags flags = 0);
+
+    /**
+     * @brief Request asset from a file without blocking the caller
+     *
+     * The file is decoded on the asset worker threads, after which the asset
+     * is uploaded on the main thread by `process_uploads`. Requests of an
+     * asset that is already being imported share its handle.
+     *
+     * @tparam T asset type
+     * @param[in] path path to the asset file
+     * @param[in] signature optional signature suggestion
+     * @param[in] flags
+     * @return AssetHandle<T> handle of the asset being imported
+     */
+    template <typename T>
+    static AssetHandle<T> request_async(
+        const std::string& path,
+        std::optional<std::string_view> signature = {},
+        RequestFlags flags = 0);
+
+    /**
+     * @brief Perform the main thread stage of the decoded asynchronous
+     * requests (see `request_async`)
+     *
+     * @warning Should only be called on the main thread
+     *
+     * @param[in] deadline world time (in seconds) after which no more uploads
+     * are started (at least one is performed if available)
+     * @return size_t - number of performed uploads
+     */
+    static size_t process_uploads(
+        double deadline = std::numeric_limits<double>::infinity());
+
+    /**
+     * @brief Wait for an asynchronous request to finish, performing uploads
+     * and main thread calls in the meantime if called on the main thread
+     *
+     * @param[in] future
+     */
+    static void wait(const std::shared_future<AbstractAsset*>& future);
+
+    /**
+     * @brief Get the number of shared requests in progress
+     *
+     * @return size_t
+     */
+    static size_t get_pending_count();
+
+    /**
+     * @brief Start recording the file requests (see `save_manifest`)
+     *
+     */
+    static void start_recording() { recording_ = true; }
+
+    /**
+     * @brief Save the recorded file requests in the order of their first
+     * occurrence, one `<type id> <signature> <path>` line (separated by tabs)
+     * per request
+     *
+     * @param[in] path path to the manifest file
+     * @return true if the manifest was saved
+     */
+    static bool save_manifest(const std::string& path);
+
+    /**
+     * @brief Start asynchronous requests of the assets listed in the
+     * manifest, so that their files are decoded in parallel before they are
+     * requested
+     *
+     * @note Types are identified by their `typeid` hashes, so entries recorded
+     * by other builds may be skipped
+     *
+     * @note Only the decode stages of the importers run in parallel (see
+     * `AbstractImporter::decode`). XML based importers parse the files on the
+     * worker threads, importers without a decode stage are run on the main
+     * thread as a whole.
+     *
+     * @param[in] path path to the manifest file
+     * @return size_t - number of listed requests (0 if there is no manifest)
+     */
+    static size_t prefetch(const std::string& path);
+
+    /**
+     * @brief Set how much memory (CPU and GPU combined) the cached assets can
+     * use before the least recently used evictable assets are unloaded
+     *
+     * @param[in] budget memory budget (in bytes, 0 if unlimited)
+     */
+    static void set_memory_budget(size_t budget);
+    static size_t get_memory_budget() { return memory_budget_; }
+
+    static AssetMemory get_memory_usage();
+
+    /**
+     * @brief Get the memory used by the assets of the type
+     *
+     * @tparam T asset type
+     * @return AssetMemory
+     */
+    template <typename T>
+    static AssetMemory get_memory_usage() {
+        return get_memory_usage(typeid(T).hash_code());
+    }
+
+    static AssetMemory get_memory_usage(size_t type_id);
+
+    /**
+     * @brief Unload the least recently used evictable assets until the memory
+     * usage fits the target
+     *
+     * @param[in] target memory usage to reach (in bytes)
+     * @return size_t - number of unloaded assets
+     */
+    static size_t evict(size_t target = 0);
+
     /**
      * @brief Clear all cached and rogue assets
      *
@@ -110,6 +320,16 @@ struct AssetManager final {
 
     static std::string extract_signature(std::string_view name);
 
+    using Lock = std::unique_lock<std::recursive_mutex>;
+
+    /**
+     * @brief Lock the registries of the manager
+     *
+     * @note The lock is released while the importers run and while requests
+     * wait for each other, so its holders never wait for the main thread
+     */
+    static Lock lock();
+
     static AbstractImporter* find_importer(const ImporterId& id);
     static AbstractXMLImporter* find_xml_importer(const ImporterId& id);
 
@@ -125,26 +345,318 @@ struct AssetManager final {
 
     friend struct std::hash<AssetManager::AssetRequest>;
 
+    static AssetRequest get_identifier(
+        const std::string& path, std::optional<std::string_view> suggestion,
+        size_t type_id);
+
+    /**
+     * @brief Find the importer of the file, reporting an error if there is
+     * none
+     *
+     */
+    static AbstractImporter* find_importer(
+        const std::string& path, std::optional<std::string_view> suggestion,
+        size_t type_id, RequestFlags flags);
+
+    static void report_failure(const std::string& path, size_t type_id,
+                               RequestFlags flags);
+
+    /**
+     * @brief Cache the imported asset or register it as a rogue
+     *
+     */
+    static void store(const AssetRequest& identifier, AbstractAsset* asset,
+                      RequestFlags flags);
+
+    /**
+     * @brief Import the asset or find it in the cache, releasing the lock
+     * while the importer runs
+     *
+     */
+    template <typename T>
+    static Asset<T>* import(Lock& guard, const std::string& path,
+                            std::optional<std::string_view> suggestion,
+                            RequestFlags flags);
+
+    template <typename T>
+    static Asset<T>* import(Lock& guard, const tinyxml2::XMLElement& element,
+                            std::optional<std::string_view> handle,
+                            RequestFlags flags);
+
+    using PendingAsset = std::shared_future<AbstractAsset*>;
+    using PendingResult = std::shared_ptr<std::promise<AbstractAsset*>>;
+
+    /**
+     * @brief Find the cached asset, waiting for the shared request of the
+     * asset if it is in progress
+     *
+     * @return AbstractAsset* - cached asset, `nullptr` if it has to be
+     * imported (no shared request of it is in progress then)
+     */
+    static AbstractAsset* find_cached(Lock& guard,
+                                      const AssetRequest& identifier,
+                                      RequestFlags flags);
+
+    /**
+     * @brief Register the import as a shared request, so that other requests
+     * of the asset wait for it
+     *
+     * @return PendingResult - result to be set by `complete_import`, `nullptr`
+     * if the import is not shared
+     */
+    static PendingResult start_import(const AssetRequest& identifier,
+                                      RequestFlags flags);
+
+    /**
+     * @brief Cache the imported asset and hand it out to the requests that
+     * have been waiting for it
+     *
+     * @return AbstractAsset* - the asset to be used by the request
+     */
+    static AbstractAsset* complete_import(const AssetRequest& identifier,
+                                          AbstractAsset* imported,
+                                          RequestFlags flags, bool pinned,
+                                          const PendingResult& result);
+
+    // Mark the asset as used by the current request
+    static void touch(AbstractAsset& asset);
+
+    static void account(AbstractAsset& asset, size_t type_id);
+    static void destroy(AbstractAsset* asset);
+
+    static void enforce_budget();
+
+    template <class T>
+    friend struct AssetRef;
+
+    static void retain(AbstractAsset& asset);
+    static void release(AbstractAsset& asset);
+
+    struct PendingUpload final {
+        AssetRequest identifier;
+        std::string path;
+        RequestFlags flags;
+        bool pinned;
+
+        Upload upload;
+        PendingResult result;
+    };
+
+    // Pinned requests hand the asset out through handles, prefetches do not
+    static PendingAsset start_request(
+        const std::string& path, std::optional<std::string_view> suggestion,
+        size_t type_id, RequestFlags flags, bool pinned);
+
+    static void finish_upload(PendingUpload& upload);
+
+    struct ManifestEntry final {
+        std::string path;
+        size_t type_id;
+        std::optional<std::string> signature;
+    };
+
+    static void record_request(const std::string& path,
+                               std::optional<std::string_view> suggestion,
+                               size_t type_id, RequestFlags flags);
+
     static std::unordered_map<ImporterId, AbstractImporter*> importers_;
     static std::unordered_map<ImporterId, AbstractXMLImporter*> xml_importers_;
     static std::unordered_map<AssetRequest, AbstractAsset*> assets_;
     static std::vector<AbstractAsset*> rogues_;
+
+    // Guards the registries. It is recursive, as the assets destroyed while
+    // holding it may release the assets they reference.
+    static std::recursive_mutex mutex_;
+
+    // Requests in progress that can be shared
+    static std::unordered_map<AssetRequest, PendingAsset> pending_;
+
+    // Decoded requests waiting for the main thread stage
+    static std::mutex upload_mutex_;
+    static std::condition_variable upload_condition_;
+    static std::deque<PendingUpload> uploads_;
+
+    static bool recording_;
+    static std::vector<ManifestEntry> manifest_;
+    static std::unordered_set<AssetRequest> recorded_;
+
+    // Shared pending requests that have been joined by pinned requests
+    static std::unordered_set<AssetRequest> pinned_requests_;
+
+    // Requests in progress defer the budget enforcement until their callers
+    // have pinned or referenced the imported assets
+    static unsigned active_requests_;
+
+    // Assets destroyed by evictions and unloads may release the assets they
+    // reference, which should not start another pass over the registries
+    static bool evicting_;
+    static bool unloading_;
+
+    static size_t memory_budget_;
+    static AssetMemory memory_usage_;
+    static std::unordered_map<size_t, AssetMemory> type_memory_;
+
+    static uint64_t use_clock_;
 };
 
 struct AbstractAsset {
     virtual ~AbstractAsset() = default;
 
+    /**
+     * @brief Measure the memory used by the asset and the assets it owns
+     *
+     * @return AssetMemory
+     */
+    virtual AssetMemory get_memory() const;
+
+    /**
+     * @brief Take ownership of an asset the content of this one refers to
+     * (e.g. meshes of a model), which is unloaded along with it
+     *
+     * @param[in] asset
+     */
+    void adopt(AbstractAsset* asset) { owned_.emplace_back(asset); }
+
     hash_t hash = 0;
+
+   private:
+    friend struct AssetManager;
+
+    std::vector<std::unique_ptr<AbstractAsset>> owned_{};
+
+    size_t type_id_ = 0;
+    AssetMemory memory_{};
+
+    size_t references_ = 0;
+    uint64_t last_use_ = 0;
+
+    // Pinned assets have been handed out as raw pointers and are never
+    // evicted
+    bool pinned_ = false;
+    bool rogue_ = false;
 };
 
+inline void AssetManager::touch(AbstractAsset& asset) {
+    asset.last_use_ = ++use_clock_;
+}
+
+/**
+ * @brief Asset content
+ *
+ * Content types can report their memory usage by defining
+ * `size_t get_cpu_memory() const` (heap memory) and
+ * `size_t get_gpu_memory() const` methods.
+ *
+ * @tparam T content type
+ */
 template <class T>
 struct Asset : public AbstractAsset {
     template <class... Ts>
     Asset(Ts&&... args) : content(std::forward<Ts>(args)...) {}
 
+    AssetMemory get_memory() const override {
+        AssetMemory memory = AbstractAsset::get_memory();
+        memory.cpu += sizeof(*this);
+
+        if constexpr (requires(const T& value) { value.get_cpu_memory(); }) {
+            memory.cpu += content.get_cpu_memory();
+        }
+
+        if constexpr (requires(const T& value) { value.get_gpu_memory(); }) {
+            memory.gpu += content.get_gpu_memory();
+        }
+
+        return memory;
+    }
+
     T content;
 };
 
+/**
+ * @brief Counted reference to an acquired asset (see `AssetManager::acquire`)
+ *
+ * @warning References held outside of assets should be destroyed before
+ * the assets are unloaded by `AssetManager::unload_all`
+ *
+ * @tparam T asset type
+ */
+template <class T>
+struct AssetRef final {
+    AssetRef() = default;
+
+    AssetRef(const AssetRef& reference) : asset_(reference.asset_) {
+        if (asset_) AssetManager::retain(*asset_);
+    }
+
+    AssetRef(AssetRef&& reference) noexcept : asset_(reference.asset_) {
+        reference.asset_ = nullptr;
+    }
+
+    AssetRef& operator=(AssetRef reference) {
+        std::swap(asset_, reference.asset_);
+        return *this;
+    }
+
+    ~AssetRef() {
+        if (asset_) AssetManager::release(*asset_);
+    }
+
+    const T* get() const { return asset_ ? &asset_->content : nullptr; }
+
+    const T& operator*() const { return asset_->content; }
+    const T* operator->() const { return &asset_->content; }
+
+    explicit operator bool() const { return asset_ != nullptr; }
+
+   private:
+    friend struct AssetManager;
+
+    explicit AssetRef(Asset<T>* asset) : asset_(asset) {
+        if (asset_) AssetManager::retain(*asset_);
+    }
+
+    Asset<T>* asset_ = nullptr;
+};
+
+/**
+ * @brief Shared handle of an asynchronously requested asset
+ *
+ * @tparam T asset type
+ */
+template <class T>
+struct AssetHandle final {
+    AssetHandle() = default;
+    explicit AssetHandle(std::shared_future<AbstractAsset*> future)
+        : future_(std::move(future)) {}
+
+    bool is_valid() const { return future_.valid(); }
+
+    bool is_ready() const {
+        return future_.valid() &&
+               future_.wait_for(std::chrono::seconds(0)) ==
+                   std::future_status::ready;
+    }
+
+    /**
+     * @brief Get the asset, waiting for it to be imported
+     *
+     * @see AssetManager::wait
+     *
+     * @return const T* pointer to the asset, `nullptr` if could not import
+     */
+    const T* get() const {
+        if (!future_.valid()) return nullptr;
+
+        AssetManager::wait(future_);
+
+        AbstractAsset* asset = future_.get();
+        return asset ? &((Asset<T>*)asset)->content : nullptr;
+    }
+
+   private:
+    std::shared_future<AbstractAsset*> future_{};
+};
+
 struct ImporterId final {
     ImporterId(size_t type, const std::string& sign)
         : type_id(type), signature(sign) {}
@@ -167,6 +679,20 @@ struct AbstractImporter {
     virtual AbstractAsset* local_import(
         const std::string& path, AssetManager::RequestFlags flags) const = 0;
 
+    /**
+     * @brief Perform the part of the import that does not need the main
+     * thread (called on the asset worker threads by asynchronous requests)
+     *
+     * @note Performs the whole import in the main thread stage by default,
+     * which keeps the requests made by the importer off the worker threads
+     *
+     * @param[in] path
+     * @param[in] flags
+     * @return AssetManager::Upload - main thread stage of the import
+     */
+    virtual AssetManager::Upload decode(
+        const std::string& path, AssetManager::RequestFlags flags) const;
+
     const ImporterId& get_id() const { return id_; }
 
    private:
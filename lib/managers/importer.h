@@ -13,6 +13,7 @@
 #pragma once
 
 #include "asset_manager.h"
+#include "pipelining/main_thread.h"
 
 /**
  * @brief Importer declarations
@@ -60,6 +61,45 @@
     IMPORTER_HEAD(type, signature) \
     IMPORTER_TAIL(type, signature)
 
+/**
+ * @brief Create and register an asset importer that decodes files on the asset
+ * worker threads (see `AssetManager::request_async`)
+ *
+ * The body defines the `decode` method, which should not use the graphics
+ * context and returns the main thread stage of the import (or an empty
+ * function on failure).
+ *
+ */
+#define ASYNC_IMPORTER(type, signature)                                       \
+    template <>                                                               \
+    struct AssetImporter<type, signature> : AbstractImporter {                \
+        AssetImporter()                                                       \
+            : AbstractImporter(typeid(type).hash_code(), signature) {}        \
+                                                                              \
+        AbstractAsset* local_import(                                          \
+            const std::string& path,                                          \
+            AssetManager::RequestFlags flags) const override {                \
+            AssetManager::Upload upload = decode(path, flags);                \
+            return upload ? MainThread::call(upload) : nullptr;               \
+        }                                                                     \
+                                                                              \
+        AssetManager::Upload decode(                                          \
+            const std::string& path,                                          \
+            AssetManager::RequestFlags flags) const override;                 \
+                                                                              \
+        static AbstractAsset* import(const std::string& path,                 \
+                                     AssetManager::RequestFlags flags = 0) {  \
+            return instance_.local_import(path, flags);                       \
+        }                                                                     \
+                                                                              \
+        static AssetImporter<type, signature> instance_;                      \
+    };                                                                        \
+                                                                              \
+    AssetImporter<type, signature> AssetImporter<type, signature>::instance_; \
+                                                                              \
+    AssetManager::Upload AssetImporter<type, signature>::decode(              \
+        const std::string& path, AssetManager::RequestFlags flags) const
+
 /**
  * @brief XML importer declarations
  *
@@ -125,23 +165,55 @@
 /**
  * @brief Create and register an XML importer with regular importer mirror
  *
+ * The mirror reads and parses the file on the asset worker threads (see
+ * `AssetManager::request_async`), while the XML importer runs in the main
+ * thread stage, as it may request other assets.
+ *
  */
-#define XML_BASED_IMPORTER(type, signature)                                  \
-    XML_IMPORTER_HEAD(type, signature)                                       \
-                                                                             \
-    IMPORTER(type, signature) {                                              \
-        tinyxml2::XMLDocument doc;                                           \
-        doc.LoadFile(path.c_str());                                          \
-                                                                             \
-        const tinyxml2::XMLElement* data = doc.FirstChildElement(signature); \
-                                                                             \
-        if (data == nullptr) {                                               \
-            ERROR("Could not find the \"" signature "\" tag in \"%s\"\n",    \
-                  path.c_str());                                             \
-            return nullptr;                                                  \
-        }                                                                    \
-                                                                             \
-        return XMLAssetImporter<type, signature>::import(*data, flags);      \
-    }                                                                        \
-                                                                             \
+#define XML_BASED_IMPORTER(type, signature)                                   \
+    XML_IMPORTER_HEAD(type, signature)                                        \
+                                                                              \
+    template <>                                                               \
+    struct AssetImporter<type, signature> : AbstractImporter {                \
+        AssetImporter()                                                       \
+            : AbstractImporter(typeid(type).hash_code(), signature) {}        \
+                                                                              \
+        AbstractAsset* local_import(                                          \
+            const std::string& path,                                          \
+            AssetManager::RequestFlags flags) const override {                \
+            AssetManager::Upload upload = decode(path, flags);                \
+            return upload ? upload() : nullptr;                               \
+        }                                                                     \
+                                                                              \
+        AssetManager::Upload decode(                                          \
+            const std::string& path,                                          \
+            AssetManager::RequestFlags flags) const override {                \
+            auto doc = std::make_shared<tinyxml2::XMLDocument>();             \
+            doc->LoadFile(path.c_str());                                      \
+                                                                              \
+            const tinyxml2::XMLElement* data =                                \
+                doc->FirstChildElement(signature);                            \
+                                                                              \
+            if (data == nullptr) {                                            \
+                ERROR("Could not find the \"" signature "\" tag in \"%s\"\n", \
+                      path.c_str());                                          \
+                return {};                                                    \
+            }                                                                 \
+                                                                              \
+            return [doc, data, flags]() {                                     \
+                return XMLAssetImporter<type, signature>::import(*data,       \
+                                                                 flags);      \
+            };                                                                \
+        }                                                                     \
+                                                                              \
+        static AbstractAsset* import(const std::string& path,                 \
+                                     AssetManager::RequestFlags flags = 0) {  \
+            return instance_.local_import(path, flags);                       \
+        }                                                                     \
+                                                                              \
+        static AssetImporter<type, signature> instance_;                      \
+    };                                                                        \
+                                                                              \
+    AssetImporter<type, signature> AssetImporter<type, signature>::instance_; \
+                                                                              \
     XML_IMPORTER_TAIL(type, signature)
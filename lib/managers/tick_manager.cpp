@@ -1,14 +1,20 @@
 #include "tick_manager.h"
 
+#include "asset_manager.h"
 #include "logger/logger.h"
+#include "logger/metrics.h"
+#include "pipelining/main_thread.h"
+#include "time/profiler.h"
 #include "time/world_timer.h"
 
 //! WARNING: Linux-only implementation of usleep()
 #include <unistd.h>
 
-TickManager::
-    TickManager(const std::function<void()>& input, const SimpleUpdate& physics,
-                const ExterpUpdate& graphics)
+// Physics rate of fast-forwarded simulations with no TPS requirement
+static const unsigned FAST_FORWARD_TPS = 60;
+
+TickManager::TickManager(const InputUpdate& input, const SimpleUpdate& physics,
+                         const ExterpUpdate& graphics)
     : update_input_(input), update_phys_(physics), update_graph_(graphics) {
     reset_timers();
 }
@@ -18,6 +24,13 @@ void TickManager::reset_timers() {
 }
 
 void TickManager::tick() {
+    if (fast_forward_) {
+        fast_forward_tick();
+        return;
+    }
+
+    PROFILE_ZONE("TickManager::tick");
+
     double time = WorldTimer::get_time_sec();
     delta_time_ = time - time_;
     time_ = time;
@@ -27,15 +40,32 @@ void TickManager::tick() {
         delta_time_ = 1.0 / fps_cap_;
     }
 
-    if (tps_ > 0) {
-        slice_phys_tick();
-    } else {
-        update_input_();
-        update_phys_(delta_time_);
-        phys_time_ = time_;
+    {
+        PROFILE_ZONE("TickManager::physics");
+
+        if (tps_ > 0) {
+            slice_phys_tick();
+        } else {
+            update_input_();
+            update_phys_(delta_time_);
+            phys_time_ = time_;
+        }
     }
 
-    update_graph_(delta_time_, time_ - phys_time_);
+    {
+        PROFILE_ZONE("TickManager::tasks");
+
+        MainThread::process_queue();
+        AssetManager::process_uploads(WorldTimer::get_time_sec() +
+                                      upload_budget_);
+        run_sliced_tasks();
+    }
+
+    {
+        PROFILE_ZONE("TickManager::graphics");
+
+        update_graph_(delta_time_, time_ - phys_time_);
+    }
 
     if (fps_threshold_ * delta_time_ > 1.0) {
         log_printf(WARNINGS, "warning",
@@ -44,6 +74,14 @@ void TickManager::tick() {
                    fps_threshold_, delta_time_, 1.0 / delta_time_);
     }
 
+    static Histogram& frame_time = Metrics::get_histogram("frame_seconds");
+    static Gauge& fps = Metrics::get_gauge("fps");
+    static Gauge& tps = Metrics::get_gauge("tps");
+
+    frame_time.record(delta_time_);
+    fps.set(get_fps());
+    tps.set(get_real_tps());
+
     ++tick_id_;
     age_ += delta_time_;
 }
@@ -73,6 +111,51 @@ void TickManager::slice_phys_tick() {
     }
 }
 
+void TickManager::set_fast_forward(bool enabled, VirtualClock* clock) {
+    fast_forward_ = enabled;
+    virtual_clock_ = clock;
+
+    // Real time has not been following the simulation
+    if (!enabled) reset_timers();
+}
+
+void TickManager::fast_forward_tick() {
+    PROFILE_ZONE("TickManager::fast_forward");
+
+    double phys_dt = 1.0 / (tps_ > 0 ? tps_ : FAST_FORWARD_TPS);
+
+    if (virtual_clock_ != nullptr) virtual_clock_->advance_sec(phys_dt);
+
+    update_input_();
+    update_phys_(phys_dt);
+
+    MainThread::process_queue();
+    AssetManager::process_uploads(WorldTimer::get_time_sec() + upload_budget_);
+    run_sliced_tasks();
+
+    time_ = phys_time_ = WorldTimer::get_time_sec();
+    delta_time_ = phys_dt;
+
+    ++tick_id_;
+    age_ += phys_dt;
+}
+
+void TickManager::run_sliced_tasks() {
+    if (sliced_tasks_.empty()) return;
+
+    double deadline = WorldTimer::get_time_sec() + slice_budget_;
+
+    // Tasks are allowed to schedule new tasks, so the list is detached first
+    std::vector<SlicedTask> tasks = std::move(sliced_tasks_);
+    sliced_tasks_.clear();
+
+    for (SlicedTask& task : tasks) {
+        if (WorldTimer::get_time_sec() < deadline && task(deadline)) continue;
+
+        sliced_tasks_.push_back(std::move(task));
+    }
+}
+
 TickManager* GameLoop::manager_ = nullptr;
 GameLoop GameLoop::instance_;
 
@@ -13,18 +13,35 @@
 
 #include <functional>
 #include <optional>
+#include <vector>
+
+#include "memory/inplace_function.hpp"
+#include "time/clock.h"
 
 /**
  * @brief Simulation update scheduler
  *
  */
 struct TickManager final {
-    using SimpleUpdate = std::function<void(double)>;
-    using ExterpUpdate = std::function<void(double, double)>;
+    using InputUpdate = InplaceFunction<void()>;
+    using SimpleUpdate = InplaceFunction<void(double)>;
+    using ExterpUpdate = InplaceFunction<void(double, double)>;
 
-    TickManager(const std::function<void()>& input, const SimpleUpdate& physics,
+    /**
+     * @brief Task that is performed in slices across multiple frames
+     *
+     * @param[in] deadline world time (in seconds) by which the current slice
+     * should yield control
+     * @return true if the task has been completed and should be dropped
+     */
+    using SlicedTask = InplaceFunction<bool(double)>;
+
+    TickManager(const InputUpdate& input, const SimpleUpdate& physics,
                 const ExterpUpdate& graphics);
 
+    TickManager(const TickManager&) = delete;
+    TickManager& operator=(const TickManager&) = delete;
+
     void reset_timers();
     void tick();
 
@@ -63,6 +80,47 @@ struct TickManager final {
         fps_threshold_ = threshold;
     }
 
+    /**
+     * @brief Register a task to be performed in slices between the physics and
+     * the graphics updates
+     *
+     * @param[in] task
+     */
+    void add_sliced_task(const SlicedTask& task) {
+        sliced_tasks_.push_back(task);
+    }
+
+    /**
+     * @brief Set how much time per frame can be spent on sliced tasks
+     *
+     * @param[in] budget time budget (in seconds)
+     */
+    void set_slice_budget(double budget) { slice_budget_ = budget; }
+    double get_slice_budget() const { return slice_budget_; }
+
+    size_t get_sliced_task_count() const { return sliced_tasks_.size(); }
+
+    /**
+     * @brief Set how much time per frame can be spent on uploading the assets
+     * requested asynchronously (see `AssetManager::process_uploads`)
+     *
+     * @param[in] budget time budget (in seconds)
+     */
+    void set_upload_budget(double budget) { upload_budget_ = budget; }
+    double get_upload_budget() const { return upload_budget_; }
+
+    /**
+     * @brief Toggle fast-forward mode, in which every tick performs a single
+     * physics update of `1 / tps` seconds without graphics updates and frame
+     * capping, letting the simulation run faster than real time
+     *
+     * @param[in] enabled
+     * @param[in] clock virtual clock to advance by the physics time step
+     * (should be the world clock, see `WorldTimer::set_clock`)
+     */
+    void set_fast_forward(bool enabled, VirtualClock* clock = nullptr);
+    bool is_fast_forward() const { return fast_forward_; }
+
     double get_real_tps() const { return tps_ > 0 ? tps_ : get_fps(); }
     double get_fps() const { return 1.0 / delta_time_; }
 
@@ -71,11 +129,17 @@ struct TickManager final {
 
    private:
     void slice_phys_tick();
+    void fast_forward_tick();
+    void run_sliced_tasks();
 
-    std::function<void()> update_input_;
+    InputUpdate update_input_;
     SimpleUpdate update_phys_;
     ExterpUpdate update_graph_;
 
+    std::vector<SlicedTask> sliced_tasks_{};
+    double slice_budget_ = 0.004;
+    double upload_budget_ = 0.004;
+
     double time_ = 0.0;
     double phys_time_ = 0.0;
 
@@ -87,6 +151,9 @@ struct TickManager final {
     unsigned wormhole_threshold_ = 100;
     double fps_threshold_ = 20.0;
 
+    bool fast_forward_ = false;
+    VirtualClock* virtual_clock_ = nullptr;
+
     unsigned long long tick_id_ = 0;
     double age_ = 0.0;
 };
@@ -0,0 +1,49 @@
+#include "frame_pool.h"
+
+void* FramePool::allocate(size_t size) {
+    ++used_count_;
+
+    if (size == 0) size = 1;
+
+    size_t size_class = get_class(size);
+    if (size_class >= CLASS_COUNT) return ::operator new(size);
+
+    if (free_lists_[size_class] == nullptr) {
+        size_t block_size = (size_class + 1) * SIZE_STEP;
+
+        // Chunks are allocated by `new[]`, so blocks are aligned for any
+        // fundamental type as long as their size is a multiple of the step
+        chunks_.push_back(
+            std::make_unique<char[]>(block_size * CHUNK_BLOCK_COUNT));
+        char* chunk = chunks_.back().get();
+
+        for (size_t id = 0; id < CHUNK_BLOCK_COUNT; ++id) {
+            FreeBlock* block = (FreeBlock*)(chunk + id * block_size);
+            block->next = free_lists_[size_class];
+            free_lists_[size_class] = block;
+        }
+    }
+
+    FreeBlock* block = free_lists_[size_class];
+    free_lists_[size_class] = block->next;
+
+    return block;
+}
+
+void FramePool::deallocate(void* block, size_t size) {
+    if (block == nullptr) return;
+
+    --used_count_;
+
+    if (size == 0) size = 1;
+
+    size_t size_class = get_class(size);
+    if (size_class >= CLASS_COUNT) {
+        ::operator delete(block);
+        return;
+    }
+
+    FreeBlock* free_block = (FreeBlock*)block;
+    free_block->next = free_lists_[size_class];
+    free_lists_[size_class] = free_block;
+}
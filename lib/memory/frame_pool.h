@@ -0,0 +1,80 @@
+/**
+ * @file frame_pool.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Pool of small memory blocks sorted by size classes
+ * @version 0.1
+ * @date 2025-02-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Allocator of short-lived blocks (e.g. coroutine frames), which reuses
+ * freed blocks of the same size class instead of returning them to the heap
+ *
+ * @warning Not thread-safe
+ */
+struct FramePool final {
+    /**
+     * @brief Granularity of block sizes
+     *
+     */
+    static const size_t SIZE_STEP = 64;
+
+    /**
+     * @brief Number of size classes (larger blocks are allocated on the heap)
+     *
+     */
+    static const size_t CLASS_COUNT = 32;
+
+    /**
+     * @brief Number of blocks allocated at once when a size class runs out
+     *
+     */
+    static const size_t CHUNK_BLOCK_COUNT = 16;
+
+    FramePool() = default;
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    void* allocate(size_t size);
+
+    /**
+     * @brief Return the block to the pool
+     *
+     * @param[in] block
+     * @param[in] size size the block was allocated with
+     */
+    void deallocate(void* block, size_t size);
+
+    /**
+     * @brief Get the number of blocks currently in use
+     *
+     * @return size_t
+     */
+    size_t get_used_count() const { return used_count_; }
+
+   private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static size_t get_class(size_t size) {
+        return (size + SIZE_STEP - 1) / SIZE_STEP - 1;
+    }
+
+    FreeBlock* free_lists_[CLASS_COUNT] = {};
+
+    std::vector<std::unique_ptr<char[]>> chunks_{};
+
+    size_t used_count_ = 0;
+};
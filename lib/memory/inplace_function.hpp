@@ -0,0 +1,154 @@
+/**
+ * @file inplace_function.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Function wrapper with inline storage
+ * @version 0.1
+ * @date 2025-02-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Default inline capacity of `InplaceFunction` (fits a `std::function`
+ * or a lambda capturing up to six pointers)
+ *
+ */
+static const size_t INPLACE_FUNCTION_CAPACITY = 6 * sizeof(void*);
+
+template <class Signature, size_t Capacity = INPLACE_FUNCTION_CAPACITY>
+struct InplaceFunction;
+
+/**
+ * @brief Replacement of `std::function` that never allocates: the target is
+ * always stored in the inline buffer of the wrapper
+ *
+ * @note Targets that do not fit into the buffer are rejected at compile time
+ *
+ * @tparam R return type
+ * @tparam Args argument types
+ * @tparam Capacity size of the inline buffer (in bytes)
+ */
+template <class R, class... Args, size_t Capacity>
+struct InplaceFunction<R(Args...), Capacity> final {
+    InplaceFunction() = default;
+    InplaceFunction(std::nullptr_t) {}
+
+    template <class F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, InplaceFunction> &&
+                 std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    InplaceFunction(F&& function) {
+        using Target = std::decay_t<F>;
+
+        static_assert(sizeof(Target) <= Capacity,
+                      "Callable does not fit into the inline storage, "
+                      "increase the capacity of the function");
+        static_assert(alignof(Target) <= alignof(max_align_t),
+                      "Callable is overaligned for the inline storage");
+        static_assert(std::is_copy_constructible_v<Target>,
+                      "Callable should be copy-constructible");
+
+        new (storage_) Target(std::forward<F>(function));
+        operations_ = &OPERATIONS<Target>;
+    }
+
+    InplaceFunction(const InplaceFunction& other)
+        : operations_(other.operations_) {
+        if (operations_) operations_->copy(storage_, other.storage_);
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept
+        : operations_(other.operations_) {
+        if (operations_) operations_->move(storage_, other.storage_);
+    }
+
+    InplaceFunction& operator=(const InplaceFunction& other) {
+        if (&other == this) return *this;
+
+        reset();
+
+        if (other.operations_) {
+            other.operations_->copy(storage_, other.storage_);
+        }
+        operations_ = other.operations_;
+
+        return *this;
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (&other == this) return *this;
+
+        reset();
+
+        if (other.operations_) {
+            other.operations_->move(storage_, other.storage_);
+        }
+        operations_ = other.operations_;
+
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    ~InplaceFunction() { reset(); }
+
+    /**
+     * @brief Call the target
+     *
+     * @throws `std::bad_function_call` if the function is empty
+     *
+     * @param[in] args
+     * @return R
+     */
+    R operator()(Args... args) const {
+        if (operations_ == nullptr) throw std::bad_function_call();
+
+        return operations_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return operations_ != nullptr; }
+
+   private:
+    struct Operations {
+        R (*invoke)(void* target, Args&&... args);
+        void (*copy)(void* destination, const void* source);
+        void (*move)(void* destination, void* source);
+        void (*destroy)(void* target);
+    };
+
+    template <class Target>
+    static constexpr Operations OPERATIONS = {
+        [](void* target, Args&&... args) -> R {
+            return std::invoke(*static_cast<Target*>(target),
+                               std::forward<Args>(args)...);
+        },
+        [](void* destination, const void* source) {
+            new (destination) Target(*static_cast<const Target*>(source));
+        },
+        [](void* destination, void* source) {
+            new (destination) Target(std::move(*static_cast<Target*>(source)));
+        },
+        [](void* target) { static_cast<Target*>(target)->~Target(); },
+    };
+
+    void reset() {
+        if (operations_) operations_->destroy(storage_);
+        operations_ = nullptr;
+    }
+
+    alignas(max_align_t) mutable unsigned char storage_[Capacity];
+
+    const Operations* operations_ = nullptr;
+};
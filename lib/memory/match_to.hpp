@@ -55,7 +55,16 @@ struct Match {
             template <class CurrentClass, class Source>
             static bool check_and_iterate(const Source* initiator,
                                           std::size_t& iterator) {
-                if (!dynamic_cast<const CurrentClass*>(initiator)) {
+                bool matches = false;
+
+                // Tag types are matched by kind, classes by dynamic type
+                if constexpr (requires { CurrentClass::KIND; }) {
+                    matches = initiator->kind == CurrentClass::KIND;
+                } else {
+                    matches = dynamic_cast<const CurrentClass*>(initiator);
+                }
+
+                if (!matches) {
                     ++iterator;
                     return false;
                 }
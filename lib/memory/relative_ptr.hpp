@@ -24,6 +24,11 @@ struct RelativePtr final {
         return *(reinterpret_cast<T*>(ptr_origin + shift_));
     }
 
+    const T& of(const void* origin) const {
+        const char* ptr_origin = reinterpret_cast<const char*>(origin);
+        return *(reinterpret_cast<const T*>(ptr_origin + shift_));
+    }
+
    private:
     long long int shift_;
 };
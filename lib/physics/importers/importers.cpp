@@ -115,7 +115,8 @@ static std::optional<BoxCollider> parse_box(
 }
 
 IMPORTER(CollisionGroup, "obj") {
-    static Assimp::Importer import;
+    // Importers are reused, but can not be shared between threads
+    static thread_local Assimp::Importer import;
 
     CollisionGroup group = {};
 
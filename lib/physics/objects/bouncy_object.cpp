@@ -6,31 +6,38 @@
 #include "physics/constants.h"
 
 BouncyObject::BouncyObject(const glm::vec3& position, double radius)
-    : collider_(radius, position) {}
+    : radius_(radius) {
+    state_.position = position;
+}
 
 void BouncyObject::tick(const LevelGeometry& level, double delta_time) {
-    glm::vec3 old_velocity = velocity_;
+    SphereCollider collider(radius_, state_.position);
+    glm::vec3& velocity = state_.velocity;
+
+    glm::vec3 old_velocity = velocity;
 
-    velocity_ += glm::vec3(0.0, -GRAVITY * (float)delta_time, 0.0);
+    velocity += glm::vec3(0.0, -GRAVITY * (float)delta_time, 0.0);
 
-    glm::vec3 old_pos = collider_.get_position();
+    glm::vec3 old_pos = collider.get_position();
 
-    collider_.set_position(collider_.get_position() +
-                           velocity_ * (float)delta_time);
+    collider.set_position(collider.get_position() +
+                          velocity * (float)delta_time);
 
-    glm::vec3 intersection = level.get_intersection(collider_);
+    glm::vec3 intersection = level.get_intersection(collider);
     if (glm::length(intersection) > 1e-4f) {
-        collider_.set_position(collider_.get_position() + intersection);
+        collider.set_position(collider.get_position() + intersection);
 
-        float delta_height = old_pos.y - collider_.get_position().y;
+        float delta_height = old_pos.y - collider.get_position().y;
         if (delta_height < 0.0) delta_height = 0.0;
 
         // v^2 / 2 = gh
         float gravity_shift = glm::sqrt(2.0f * delta_height * GRAVITY);
 
-        velocity_ = old_velocity + glm::vec3(0.0, gravity_shift, 0.0);
+        velocity = old_velocity + glm::vec3(0.0, gravity_shift, 0.0);
 
-        velocity_ =
-            reflect_plane(velocity_, intersection) * DIRECTIONAL_BOUNCINESS;
+        velocity =
+            reflect_plane(velocity, intersection) * DIRECTIONAL_BOUNCINESS;
     }
+
+    state_.position = collider.get_position();
 }
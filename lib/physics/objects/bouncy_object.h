@@ -15,24 +15,38 @@
 #include "physics/phys_object.h"
 
 struct BouncyObject : public PhysObject {
+    /**
+     * @brief Simulation state of the object, kept trivially copyable for
+     * snapshots
+     *
+     */
+    struct State {
+        glm::vec3 position = glm::vec3(0.0, 0.0, 0.0);
+        glm::vec3 velocity = glm::vec3(0.0, 0.0, 0.0);
+    };
+
     BouncyObject(const glm::vec3& position, double radius);
 
     void tick(const LevelGeometry& level, double delta_time) override;
 
-    glm::vec3 get_position() const override { return collider_.get_position(); }
+    glm::vec3 get_position() const override { return state_.position; }
     glm::vec3 get_rotation() const override { return rotation_; }
-    glm::vec3 get_velocity() const { return velocity_; }
+    glm::vec3 get_velocity() const { return state_.velocity; }
 
-    void set_position(const glm::vec3& pos) { collider_.set_position(pos); }
-    void set_velocity(const glm::vec3& velocity) { velocity_ = velocity; }
+    void set_position(const glm::vec3& pos) { state_.position = pos; }
+    void set_velocity(const glm::vec3& velocity) { state_.velocity = velocity; }
 
     glm::vec3 get_interp_pos(double time) const override {
-        return collider_.get_position() + velocity_ * (float)time * 0.0f;
+        return state_.position + state_.velocity * (float)time * 0.0f;
     }
 
+    State& get_state() { return state_; }
+    const State& get_state() const { return state_; }
+
    private:
-    SphereCollider collider_;
+    double radius_;
+
+    State state_{};
 
     glm::vec3 rotation_ = glm::vec3(0.0, 0.0, 0.0);
-    glm::vec3 velocity_ = glm::vec3(0.0, 0.0, 0.0);
 };
@@ -0,0 +1,99 @@
+#include "deferred_event_queue.h"
+
+#include "logger/metrics.h"
+
+static size_t round_up_to_power_of_two(size_t value) {
+    size_t result = 1;
+    while (result < value) result <<= 1;
+
+    return result;
+}
+
+DeferredEventQueue::DeferredEventQueue(size_t capacity)
+    : cells_(), mask_(round_up_to_power_of_two(capacity) - 1) {
+    cells_ = std::make_unique<Cell[]>(mask_ + 1);
+
+    // A cell is free for the position equal to its sequence number, and ready
+    // for reading once the sequence number becomes one greater
+    for (size_t id = 0; id <= mask_; ++id) {
+        cells_[id].sequence.store(id, std::memory_order_relaxed);
+    }
+}
+
+DeferredEventQueue::~DeferredEventQueue() {
+    size_t tail = tail_.load(std::memory_order_acquire);
+
+    for (; head_ != tail; ++head_) {
+        Cell& cell = cells_[head_ & mask_];
+
+        if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) break;
+
+        cell.process(cell.target, cell.payload, false);
+    }
+}
+
+DeferredEventQueue& DeferredEventQueue::get_default() {
+    static DeferredEventQueue queue;
+    return queue;
+}
+
+size_t DeferredEventQueue::dispatch() {
+    // Payloads posted by the listeners are left for the next dispatch
+    size_t tail = tail_.load(std::memory_order_acquire);
+    size_t delivered = 0;
+
+    for (; head_ != tail; ++head_) {
+        Cell& cell = cells_[head_ & mask_];
+
+        // The producer has not finished writing the cell yet
+        if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) break;
+
+        if (cell.target) ++delivered;
+
+        cell.process(cell.target, cell.payload, true);
+        cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    }
+
+    return delivered;
+}
+
+void DeferredEventQueue::retarget(const void* target, void* replacement) {
+    size_t tail = tail_.load(std::memory_order_acquire);
+
+    for (size_t position = head_; position != tail; ++position) {
+        Cell& cell = cells_[position & mask_];
+
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+            continue;
+        }
+
+        if (cell.target == target) cell.target = replacement;
+    }
+}
+
+DeferredEventQueue::Cell* DeferredEventQueue::reserve(size_t& position) {
+    position = tail_.load(std::memory_order_relaxed);
+
+    while (true) {
+        Cell& cell = cells_[position & mask_];
+
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+        if (difference == 0) {
+            if (tail_.compare_exchange_weak(position, position + 1,
+                                            std::memory_order_relaxed)) {
+                return &cell;
+            }
+        } else if (difference < 0) {
+            return nullptr;
+        } else {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void DeferredEventQueue::report_overflow() {
+    static Counter& dropped = Metrics::get_counter("deferred_events_dropped");
+    dropped.add();
+}
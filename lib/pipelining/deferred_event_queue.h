@@ -0,0 +1,175 @@
+/**
+ * @file deferred_event_queue.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Lock-free queue of deferred event deliveries
+ * @version 0.1
+ * @date 2025-02-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Bounded multi-producer single-consumer queue of event payloads
+ *
+ * Payloads can be pushed from any thread without locking, and are delivered
+ * to their events by `dispatch()` on the consumer thread (the main thread).
+ */
+struct DeferredEventQueue final {
+    /**
+     * @brief Maximum size of a payload stored in the queue
+     *
+     */
+    static const size_t PAYLOAD_CAPACITY = 64;
+
+    static const size_t DEFAULT_CAPACITY = 1024;
+
+    /**
+     * @brief Construct a new queue
+     *
+     * @param[in] capacity maximum number of pending deliveries (rounded up to
+     * a power of two)
+     */
+    explicit DeferredEventQueue(size_t capacity = DEFAULT_CAPACITY);
+    ~DeferredEventQueue();
+
+    DeferredEventQueue(const DeferredEventQueue&) = delete;
+    DeferredEventQueue& operator=(const DeferredEventQueue&) = delete;
+
+    /**
+     * @brief Get the queue events post to by default, which is dispatched by
+     * `Scene::phys_tick()`
+     *
+     * @return DeferredEventQueue&
+     */
+    static DeferredEventQueue& get_default();
+
+    /**
+     * @brief Queue a payload for the target (an object with `trigger` method)
+     *
+     * @note Thread-safe, lock-free
+     *
+     * @param[in] target
+     * @param[in] payload tuple of `trigger` arguments
+     * @return true on success
+     * @return false if the queue is full (the payload is dropped)
+     */
+    template <class Target, class... Ts>
+    bool push(Target& target, std::tuple<Ts...> payload);
+
+    /**
+     * @brief Deliver all the payloads pushed before the call
+     *
+     * @warning Should only be called by the consumer thread
+     *
+     * @return size_t number of delivered payloads
+     */
+    size_t dispatch();
+
+    /**
+     * @brief Drop the payloads pushed for the target that were not delivered
+     * yet
+     *
+     * @warning Should only be called by the consumer thread
+     *
+     * @param[in] target
+     */
+    void forget(const void* target) { retarget(target, nullptr); }
+
+    /**
+     * @brief Deliver the payloads pushed for the target that were not
+     * delivered yet to another target of the same type instead
+     *
+     * @warning Should only be called by the consumer thread
+     *
+     * @param[in] target
+     * @param[in] replacement new target, or `nullptr` to drop the payloads
+     */
+    void retarget(const void* target, void* replacement);
+
+    size_t get_capacity() const { return mask_ + 1; }
+
+   private:
+    using Process = void (*)(void* target, void* payload, bool deliver);
+
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence = 0;
+
+        Process process = nullptr;
+        void* target = nullptr;
+
+        alignas(max_align_t) unsigned char payload[PAYLOAD_CAPACITY];
+    };
+
+    /**
+     * @brief Reserve a cell for writing
+     *
+     * @param[out] position
+     * @return Cell* - reserved cell, or `nullptr` if the queue is full
+     */
+    Cell* reserve(size_t& position);
+
+    static void report_overflow();
+
+    template <class Target, class Payload>
+    static void process(void* target, void* payload, bool deliver);
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+
+    alignas(64) std::atomic<size_t> tail_ = 0;
+    alignas(64) size_t head_ = 0;
+};
+
+template <class Target, class... Ts>
+bool DeferredEventQueue::push(Target& target, std::tuple<Ts...> payload) {
+    using Payload = std::tuple<Ts...>;
+
+    static_assert(sizeof(Payload) <= PAYLOAD_CAPACITY,
+                  "Payload is too large for a deferred event");
+    static_assert(alignof(Payload) <= alignof(max_align_t),
+                  "Payload is overaligned for a deferred event");
+
+    size_t position = 0;
+    Cell* cell = reserve(position);
+
+    if (cell == nullptr) {
+        report_overflow();
+        return false;
+    }
+
+    new (cell->payload) Payload(std::move(payload));
+    cell->process = &process<Target, Payload>;
+    cell->target = &target;
+
+    cell->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <class Target, class Payload>
+void DeferredEventQueue::process(void* target, void* payload, bool deliver) {
+    Payload& arguments = *std::launder(reinterpret_cast<Payload*>(payload));
+
+    if (deliver && target) {
+        std::apply(
+            [target](auto&... args) {
+                static_cast<Target*>(target)->trigger(args...);
+            },
+            arguments);
+    }
+
+    arguments.~Payload();
+}
@@ -11,12 +11,14 @@
 
 #pragma once
 
-#include <functional>
-#include <memory>
+#include <atomic>
 #include <set>
 #include <stdexcept>
 #include <vector>
 
+#include "deferred_event_queue.h"
+#include "memory/inplace_function.hpp"
+
 /**
  * @brief Event class. Can be triggered to notify its subscribers and deliver a
  * payload to them.
@@ -32,38 +34,31 @@ struct Event final {
      *
      */
     struct Listener {
-        explicit Listener(const std::function<void(Ts...)>& action)
-            : action_(action) {};
-
-        Listener() : Listener([](Ts...) {}) {}
-
-        Listener(const Listener& other) : action_(other.action_) {
-            if (other.event_) other.event_->subscribe(*this);
-        }
-
-        Listener& operator=(const Listener& other) {
-            if (&other == this) return *this;
+        using Action = InplaceFunction<void(Ts...)>;
 
-            unsubscribe();
+        explicit Listener(const Action& action) : action_(action) {};
 
-            action_ = other.action_;
-
-            if (other.event_) other.event_->subscribe(*this);
+        Listener() : Listener([](Ts...) {}) {}
 
-            return *this;
-        }
+        // Copies would be notified twice, and actions usually capture the
+        // object that owns the listener, so listeners can only be moved
+        Listener(const Listener&) = delete;
+        Listener& operator=(const Listener&) = delete;
 
-        Listener(Listener&& other) : action_(other.action_) {
+        Listener(Listener&& other) noexcept
+            : action_(std::move(other.action_)) {
             if (other.event_) {
                 other.event_->subscribe(*this);
                 other.unsubscribe();
             }
         }
 
-        Listener& operator=(Listener&& other) {
+        Listener& operator=(Listener&& other) noexcept {
+            if (&other == this) return *this;
+
             unsubscribe();
 
-            action_ = other.action_;
+            action_ = std::move(other.action_);
 
             if (other.event_) {
                 other.event_->subscribe(*this);
@@ -75,8 +70,6 @@ struct Event final {
 
         ~Listener() { unsubscribe(); }
 
-        typename Event<Ts...>::Listener& operator=(Listener& other);
-
         void operator()(Ts... args) { action_(args...); }
 
         /**
@@ -97,28 +90,14 @@ struct Event final {
         friend Multilistener;
 
        private:
-        std::function<void(Ts...)> action_;
+        Action action_;
         Event<Ts...>* event_ = nullptr;
     };
 
     struct Multilistener {
-        using Action = std::function<void(Ts...)>;
+        using Action = typename Listener::Action;
 
-        Multilistener(const Action& action)
-            : action_(std::make_shared<Action>(action)) {}
-
-        Multilistener(const Multilistener& other)
-            : action_(std::make_shared<Action>(*other.action_)),
-              listeners_(other.listeners_) {};
-
-        Multilistener& operator=(const Multilistener& other) {
-            action_ = std::make_shared<Action>(*other.action_);
-            listeners_ = other.listeners_;
-            return *this;
-        }
-
-        Multilistener(Multilistener&& other) = default;
-        Multilistener& operator=(Multilistener&& other) = default;
+        Multilistener(const Action& action) : action_(action) {}
 
         void subscribe_to(Event& event);
 
@@ -127,7 +106,8 @@ struct Event final {
         void unsubscribe() { listeners_.clear(); }
 
        private:
-        std::shared_ptr<std::function<void(Ts...)>> action_;
+        // Every listener keeps its own copy of the action
+        Action action_;
         std::vector<Event::Listener> listeners_{};
     };
 
@@ -136,6 +116,8 @@ struct Event final {
     Event(const Event&) = delete;
     Event<Ts...>& operator=(const Event&) = delete;
 
+    // Posted payloads that were not delivered yet follow the moved event, so
+    // posted events should only be moved by the thread that dispatches them
     Event(Event&&);
     Event<Ts...>& operator=(Event&&);
 
@@ -171,34 +153,63 @@ struct Event final {
      */
     void trigger(Ts... payload);
 
+    /**
+     * @brief Queue the payload to be delivered to the subscribers by the
+     * deferred event queue of the event
+     *
+     * @note Can be called from any thread, the subscribers are notified on the
+     * thread that dispatches the queue
+     *
+     * @param[in] payload
+     * @return true on success
+     * @return false if the queue is full
+     */
+    bool post(Ts... payload);
+
+    /**
+     * @brief Set the queue posted payloads are delivered by
+     * (`DeferredEventQueue::get_default()` by default)
+     *
+     * @warning Should not be changed while payloads are being posted
+     *
+     * @param[in] queue
+     */
+    void set_deferred_queue(DeferredEventQueue& queue) { queue_ = &queue; }
+
    private:
+    /**
+     * @brief Take over the payloads posted to the other event that were not
+     * delivered yet
+     *
+     * @param[in] event
+     */
+    void take_posted(Event& event);
+
     std::set<typename Event<Ts...>::Listener*> subscribers_{};
+
+    DeferredEventQueue* queue_ = nullptr;
+    std::atomic<bool> posted_ = false;
 };
 
 using SimpleEvent = Event<>;
 
 template <class... Ts>
-inline typename Event<Ts...>::Listener& Event<Ts...>::Listener::
-operator=(Listener& other) {
-    if (event_) event_->unsubscribe(*this);
-    action_ = other.action_;
-    if (other.event_) other.event_->subscribe(*this);
-
-    return *this;
-}
-
-template <class... Ts>
-inline Event<Ts...>::Event(Event&& event) : subscribers_() {
+inline Event<Ts...>::Event(Event&& event)
+    : subscribers_(), queue_(event.queue_), posted_(false) {
     for (auto subscriber : event.subscribers_) {
         subscribers_.insert(subscriber);
         subscriber->event_ = this;
     }
 
     event.subscribers_.clear();
+
+    take_posted(event);
 }
 
 template <class... Ts>
 inline Event<Ts...>& Event<Ts...>::operator=(Event&& event) {
+    if (&event == this) return *this;
+
     for (auto subscriber : subscribers_) {
         subscriber->event_ = nullptr;
     }
@@ -212,11 +223,35 @@ inline Event<Ts...>& Event<Ts...>::operator=(Event&& event) {
 
     event.subscribers_.clear();
 
+    // Payloads posted to this event are dropped along with its subscribers
+    if (posted_.load(std::memory_order_relaxed)) {
+        (queue_ ? *queue_ : DeferredEventQueue::get_default()).forget(this);
+        posted_.store(false, std::memory_order_relaxed);
+    }
+
+    queue_ = event.queue_;
+    take_posted(event);
+
     return *this;
 }
 
+template <class... Ts>
+inline void Event<Ts...>::take_posted(Event& event) {
+    if (!event.posted_.load(std::memory_order_relaxed)) return;
+
+    (queue_ ? *queue_ : DeferredEventQueue::get_default())
+        .retarget(&event, this);
+
+    event.posted_.store(false, std::memory_order_relaxed);
+    posted_.store(true, std::memory_order_relaxed);
+}
+
 template <class... Ts>
 inline Event<Ts...>::~Event() {
+    if (posted_.load(std::memory_order_relaxed)) {
+        (queue_ ? *queue_ : DeferredEventQueue::get_default()).forget(this);
+    }
+
     for (auto subscriber : subscribers_) {
         subscriber->event_ = nullptr;
     }
@@ -254,21 +289,29 @@ inline void Event<Ts...>::trigger(Ts... payload) {
     }
 }
 
+template <class... Ts>
+inline bool Event<Ts...>::post(Ts... payload) {
+    if (!posted_.load(std::memory_order_relaxed)) {
+        posted_.store(true, std::memory_order_relaxed);
+    }
+
+    DeferredEventQueue& queue =
+        queue_ ? *queue_ : DeferredEventQueue::get_default();
+
+    return queue.push(*this, std::tuple<std::decay_t<Ts>...>(payload...));
+}
+
 template <class... Ts>
 inline void Event<Ts...>::Multilistener::subscribe_to(Event& event) {
     unsubscribe_from(event);
-    listeners_.push_back(Listener([action = action_](Ts... args) {
-        action->operator()(std::forward<Ts...>(args)...);
-    }));
+    listeners_.push_back(Listener(action_));
     listeners_.back().subscribe_to(event);
 }
 
 template <class... Ts>
 inline void Event<Ts...>::Multilistener::unsubscribe_from(Event& event) {
-    for (auto& listener : listeners_) {
-        if (listener.event_ && listener.event_ != &event) continue;
-
-        std::swap(listener, listeners_.back());
-        listeners_.pop_back();
-    }
+    // Unsubscribed listeners are dropped as well
+    std::erase_if(listeners_, [&event](const Listener& listener) {
+        return !listener.event_ || listener.event_ == &event;
+    });
 }
@@ -0,0 +1,38 @@
+#include "main_thread.h"
+
+#include <assert.h>
+
+// Static initialization is performed by the main thread
+std::thread::id MainThread::id_ = std::this_thread::get_id();
+
+std::mutex MainThread::mutex_{};
+std::condition_variable MainThread::condition_{};
+std::deque<std::function<void()>> MainThread::queue_{};
+
+void MainThread::process_queue() {
+    assert(is_current());
+
+    for (;;) {
+        std::function<void()> call;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (queue_.empty()) return;
+
+            call = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        call();
+    }
+}
+
+void MainThread::enqueue(const std::function<void()>& call) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(call);
+    }
+
+    condition_.notify_all();
+}
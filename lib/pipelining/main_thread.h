@@ -0,0 +1,142 @@
+/**
+ * @file main_thread.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Main thread call queue
+ * @version 0.1
+ * @date 2025-02-03
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @brief Queue of calls that have to be performed on the main thread (the one
+ * owning the graphics context)
+ *
+ */
+struct MainThread final {
+    /**
+     * @brief Check if the calling thread is the main thread
+     *
+     * @return true
+     * @return false
+     */
+    static bool is_current() {
+        // The identifier is unset only during static initialization, which is
+        // performed by the main thread
+        return id_ == std::thread::id() || std::this_thread::get_id() == id_;
+    }
+
+    /**
+     * @brief Perform the call on the main thread and wait for its result
+     *
+     * @note Runs the call immediately if invoked from the main thread
+     *
+     * @warning Blocks until the main thread processes its queue (see
+     * `process_queue` and `wait`)
+     *
+     * @tparam F call type
+     * @param[in] function
+     * @return result of the call
+     */
+    template <class F>
+    static std::invoke_result_t<F> call(F&& function);
+
+    /**
+     * @brief Queue the call to the main thread without waiting for it
+     *
+     * @note Runs the call immediately if invoked from the main thread
+     *
+     * @param[in] function
+     */
+    static void post(const std::function<void()>& function) {
+        if (is_current()) {
+            function();
+            return;
+        }
+
+        enqueue(function);
+    }
+
+    /**
+     * @brief Perform all the queued calls
+     *
+     * @warning Should only be called on the main thread
+     *
+     */
+    static void process_queue();
+
+    /**
+     * @brief Wait for the future to become ready, performing queued calls in
+     * the meantime
+     *
+     * @warning Should only be called on the main thread
+     *
+     * @param[in] future
+     * @param[in] deadline time point to stop waiting at
+     * @return true if the future is ready
+     */
+    template <class T>
+    static bool wait(const std::future<T>& future,
+                     std::chrono::steady_clock::time_point deadline =
+                         std::chrono::steady_clock::time_point::max());
+
+   private:
+    MainThread() = default;
+
+    static void enqueue(const std::function<void()>& call);
+
+    static std::thread::id id_;
+
+    static std::mutex mutex_;
+    static std::condition_variable condition_;
+    static std::deque<std::function<void()>> queue_;
+};
+
+template <class F>
+inline std::invoke_result_t<F> MainThread::call(F&& function) {
+    if (is_current()) return function();
+
+    using Result = std::invoke_result_t<F>;
+
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<F>(function));
+
+    std::future<Result> result = packaged->get_future();
+
+    enqueue([packaged]() { (*packaged)(); });
+
+    return result.get();
+}
+
+template <class T>
+inline bool MainThread::wait(const std::future<T>& future,
+                             std::chrono::steady_clock::time_point deadline) {
+    static constexpr std::chrono::milliseconds POLL_PERIOD(1);
+
+    for (;;) {
+        process_queue();
+
+        if (future.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready)
+            return true;
+
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait_for(lock, POLL_PERIOD,
+                            []() { return !queue_.empty(); });
+    }
+}
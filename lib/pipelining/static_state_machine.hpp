@@ -0,0 +1,209 @@
+/**
+ * @file static_state_machine.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief State machine with compile-time transition tables
+ * @version 0.1
+ * @date 2025-02-09
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief List of state types of a static state machine (the first one is the
+ * starting state)
+ *
+ */
+template <class... Ss>
+struct StateList {};
+
+/**
+ * @brief Condition that is always satisfied
+ *
+ */
+struct AlwaysTrue {
+    template <class Owner>
+    constexpr bool operator()(const Owner&) const {
+        return true;
+    }
+};
+
+/**
+ * @brief Transition rule of a static state machine
+ *
+ * @tparam From source state type
+ * @tparam To target state type
+ * @tparam Condition default-constructible callable, invoked with the owner of
+ * the machine
+ */
+template <class From, class To, class Condition = AlwaysTrue>
+struct Transition {
+    using FromState = From;
+    using ToState = To;
+    using ConditionType = Condition;
+};
+
+template <class... Rs>
+struct TransitionList {};
+
+template <class Owner, class States, class Transitions, class... Ts>
+struct StaticStateMachine;
+
+/**
+ * @brief State machine whose states and transitions are known at compile time
+ *
+ * States are stored by value and may define any of `enter(Owner&)`,
+ * `update(Owner&, Ts...)` and `leave(Owner&)`. Every update dispatches through
+ * a table indexed by the active state id to a function with the transitions of
+ * that state unrolled and their conditions inlined, so the machine neither
+ * allocates nor performs lookups.
+ *
+ * @note Transitions are checked in the order of declaration, as with
+ * `StateMachine`
+ *
+ * @tparam Owner object the states and conditions operate on
+ * @tparam Ss state types
+ * @tparam Rs transition rules (see `Transition`)
+ * @tparam Ts update arguments
+ */
+template <class Owner, class... Ss, class... Rs, class... Ts>
+struct StaticStateMachine<Owner, StateList<Ss...>, TransitionList<Rs...>,
+                          Ts...>
+    final {
+    static_assert(sizeof...(Ss) > 0, "State machine should have states");
+
+    static constexpr size_t STATE_COUNT = sizeof...(Ss);
+    static constexpr size_t TRANSITION_COUNT = sizeof...(Rs);
+
+    /**
+     * @brief Id of the state type (its index in the state list)
+     *
+     * @tparam S state type
+     */
+    template <class S>
+    static constexpr size_t state_id = [] {
+        size_t index = 0;
+        bool found = false;
+
+        ((found = found || std::is_same_v<S, Ss>, index += found ? 0 : 1),
+         ...);
+
+        return index;
+    }();
+
+    static_assert(((state_id<typename Rs::FromState> < STATE_COUNT &&
+                    state_id<typename Rs::ToState> < STATE_COUNT) &&
+                   ...),
+                  "Transitions should connect states of the machine");
+
+    /**
+     * @brief Construct the machine and enter its starting state
+     *
+     * @param[in] owner
+     */
+    explicit StaticStateMachine(Owner& owner) : owner_(owner) {
+        enter<0>();
+    }
+
+    StaticStateMachine(const StaticStateMachine&) = delete;
+    StaticStateMachine& operator=(const StaticStateMachine&) = delete;
+
+    /**
+     * @brief Update current state, switch states if necessary
+     *
+     * @param[in] args
+     */
+    void update(Ts... args) { (this->*STEPS[active_])(args...); }
+
+    size_t get_active_id() const { return active_; }
+
+    template <class S>
+    bool is_active() const {
+        return active_ == state_id<S>;
+    }
+
+    template <class S>
+    S& get_state() {
+        return std::get<state_id<S>>(states_);
+    }
+
+    template <class S>
+    const S& get_state() const {
+        return std::get<state_id<S>>(states_);
+    }
+
+   private:
+    using Step = void (StaticStateMachine::*)(Ts...);
+
+    template <size_t I>
+    using StateAt = std::tuple_element_t<I, std::tuple<Ss...>>;
+
+    template <size_t I>
+    void enter() {
+        StateAt<I>& state = std::get<I>(states_);
+        if constexpr (requires { state.enter(owner_); }) state.enter(owner_);
+    }
+
+    template <size_t I>
+    void leave() {
+        StateAt<I>& state = std::get<I>(states_);
+        if constexpr (requires { state.leave(owner_); }) state.leave(owner_);
+    }
+
+    template <size_t I>
+    void update_state(Ts... args) {
+        StateAt<I>& state = std::get<I>(states_);
+        if constexpr (requires { state.update(owner_, args...); }) {
+            state.update(owner_, args...);
+        }
+    }
+
+    template <size_t I, class R>
+    bool try_transition(Ts... args) {
+        if constexpr (state_id<typename R::FromState> != I) {
+            return false;
+        } else {
+            constexpr size_t TARGET = state_id<typename R::ToState>;
+
+            if (!typename R::ConditionType()(owner_)) return false;
+
+            leave<I>();
+            active_ = TARGET;
+            enter<TARGET>();
+
+            update_state<TARGET>(args...);
+
+            return true;
+        }
+    }
+
+    template <size_t I>
+    void step(Ts... args) {
+        if ((try_transition<I, Rs>(args...) || ...)) return;
+
+        update_state<I>(args...);
+    }
+
+    template <size_t... Is>
+    static constexpr std::array<Step, STATE_COUNT> make_steps(
+        std::index_sequence<Is...>) {
+        return {&StaticStateMachine::step<Is>...};
+    }
+
+    static constexpr std::array<Step, STATE_COUNT> STEPS =
+        make_steps(std::index_sequence_for<Ss...>());
+
+    Owner& owner_;
+
+    std::tuple<Ss...> states_{};
+    size_t active_ = 0;
+};
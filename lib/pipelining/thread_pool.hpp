@@ -0,0 +1,132 @@
+/**
+ * @file thread_pool.hpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Thread pool class
+ * @version 0.1
+ * @date 2025-02-03
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Fixed-size set of worker threads performing submitted tasks in the
+ * order of submission
+ *
+ */
+struct ThreadPool final {
+    /**
+     * @brief Construct a thread pool
+     *
+     * @param[in] thread_count number of worker threads (hardware concurrency
+     * by default)
+     */
+    explicit ThreadPool(size_t thread_count = std::thread::
+                            hardware_concurrency());
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * @brief Finish all submitted tasks and join the workers
+     *
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Submit a task to the pool
+     *
+     * @tparam F task type
+     * @param[in] task
+     * @return std::future of the task result
+     */
+    template <class F>
+    std::future<std::invoke_result_t<F>> submit(F&& task);
+
+    size_t get_thread_count() const { return workers_.size(); }
+
+   private:
+    void work();
+
+    std::vector<std::thread> workers_{};
+    std::deque<std::function<void()>> tasks_{};
+
+    std::mutex mutex_{};
+    std::condition_variable condition_{};
+
+    bool stopping_ = false;
+};
+
+inline ThreadPool::ThreadPool(size_t thread_count) {
+    if (thread_count == 0) thread_count = 1;
+
+    for (size_t id = 0; id < thread_count; ++id) {
+        workers_.emplace_back([this]() { work(); });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+
+    condition_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+template <class F>
+inline std::future<std::invoke_result_t<F>> ThreadPool::submit(F&& task) {
+    using Result = std::invoke_result_t<F>;
+
+    // `std::function` requires copyable targets, `std::packaged_task` is not
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<F>(task));
+
+    std::future<Result> result = packaged->get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back([packaged]() { (*packaged)(); });
+    }
+
+    condition_.notify_one();
+
+    return result;
+}
+
+inline void ThreadPool::work() {
+    for (;;) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock,
+                            [this]() { return stopping_ || !tasks_.empty(); });
+
+            if (tasks_.empty()) return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        task();
+    }
+}
@@ -11,6 +11,10 @@
 
 #pragma once
 
+#include <stddef.h>
+
+#include <algorithm>
+
 template <size_t N>
 struct StringLiteral final {
     constexpr StringLiteral(const char (&str)[N]) {
@@ -0,0 +1,7 @@
+#include "clock.h"
+
+#include "GLFW/glfw3.h"
+
+uint64_t WallClock::get_time() const { return glfwGetTimerValue(); }
+
+uint64_t WallClock::get_frequency() const { return glfwGetTimerFrequency(); }
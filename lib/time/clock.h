@@ -0,0 +1,73 @@
+/**
+ * @file clock.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Time sources of the simulation
+ * @version 0.1
+ * @date 2025-02-08
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+
+/**
+ * @brief Source of monotonic time
+ *
+ */
+struct Clock {
+    virtual ~Clock() = default;
+
+    /**
+     * @brief Get current time
+     *
+     * @return uint64_t - time (in clock ticks)
+     */
+    virtual uint64_t get_time() const = 0;
+
+    /**
+     * @brief Get the number of clock ticks per second
+     *
+     * @return uint64_t
+     */
+    virtual uint64_t get_frequency() const = 0;
+};
+
+/**
+ * @brief Real time clock
+ *
+ */
+struct WallClock final : public Clock {
+    uint64_t get_time() const override;
+    uint64_t get_frequency() const override;
+};
+
+/**
+ * @brief Manually advanced clock, used to run the simulation independently of
+ * real time
+ *
+ */
+struct VirtualClock final : public Clock {
+    explicit VirtualClock(uint64_t frequency = 1000000000)
+        : frequency_(frequency) {}
+
+    uint64_t get_time() const override { return time_; }
+    uint64_t get_frequency() const override { return frequency_; }
+
+    void advance(uint64_t ticks) { time_ += ticks; }
+
+    /**
+     * @brief Advance the clock
+     *
+     * @param[in] seconds time to advance the clock by (in seconds)
+     */
+    void advance_sec(double seconds) {
+        time_ += (uint64_t)(seconds * (double)frequency_);
+    }
+
+   private:
+    uint64_t time_ = 0;
+    uint64_t frequency_;
+};
@@ -0,0 +1,164 @@
+#include "profiler.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+
+#include "logger/logger.h"
+#include "world_timer.h"
+
+static const size_t DEFAULT_BUFFER_CAPACITY = 1 << 16;
+
+std::atomic<bool> Profiler::enabled_ = false;
+std::atomic<size_t> Profiler::buffer_capacity_ = DEFAULT_BUFFER_CAPACITY;
+
+std::mutex Profiler::registry_mutex_{};
+std::vector<std::shared_ptr<Profiler::ThreadBuffer>> Profiler::buffers_{};
+
+Profiler::ScopedZone::ScopedZone(const char* name)
+    : name_(name),
+      begin_(enabled_ ? WorldTimer::get_wall_clock().get_time() : 0) {}
+
+Profiler::ScopedZone::~ScopedZone() {
+    if (begin_ == 0) return;
+
+    record(name_, begin_, WorldTimer::get_wall_clock().get_time());
+}
+
+void Profiler::record(const char* name, uint64_t begin, uint64_t end) {
+    if (!enabled_) return;
+
+    ThreadBuffer& buffer = get_thread_buffer();
+
+    if (buffer.zones.empty()) return;
+
+    uint64_t written = buffer.written.load(std::memory_order_relaxed);
+
+    buffer.zones[written % buffer.zones.size()] = {name, begin, end};
+    buffer.written.store(written + 1, std::memory_order_release);
+}
+
+void Profiler::set_buffer_capacity(size_t capacity) {
+    buffer_capacity_ = capacity;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+
+    for (std::shared_ptr<ThreadBuffer>& buffer : buffers_) {
+        buffer->cleared = buffer->written.load(std::memory_order_acquire);
+    }
+}
+
+void Profiler::collect(std::vector<Zone>& zones,
+                       std::vector<unsigned>& thread_ids) {
+    std::lock_guard<std::mutex> registry_lock(registry_mutex_);
+
+    for (std::shared_ptr<ThreadBuffer>& buffer : buffers_) {
+        size_t size = buffer->zones.size();
+        if (size == 0) continue;
+
+        uint64_t end = buffer->written.load(std::memory_order_acquire);
+        uint64_t start = std::max<uint64_t>(buffer->cleared.load(),
+                                            end > size ? end - size : 0);
+
+        std::vector<Zone> copied(buffer->zones.begin(), buffer->zones.end());
+
+        // Zones the owner may have been overwriting during the copy (including
+        // the one it is writing now) are dropped
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        if (written + 1 > size) {
+            start = std::max<uint64_t>(start, written + 1 - size);
+        }
+
+        for (uint64_t id = start; id < end; ++id) {
+            zones.push_back(copied[id % size]);
+            thread_ids.push_back(buffer->thread_id);
+        }
+    }
+}
+
+// Writes the string as a JSON string literal
+static void write_json_string(FILE* file, const char* string) {
+    fputc('"', file);
+
+    for (const char* symbol = string; *symbol != '\0'; ++symbol) {
+        unsigned char code = (unsigned char)*symbol;
+
+        if (code == '"' || code == '\\') {
+            fputc('\\', file);
+            fputc(code, file);
+        } else if (code < 0x20) {
+            fprintf(file, "\\u%04x", code);
+        } else {
+            fputc(code, file);
+        }
+    }
+
+    fputc('"', file);
+}
+
+bool Profiler::dump_chrome_trace(const char* path) {
+    std::vector<Zone> zones;
+    std::vector<unsigned> thread_ids;
+
+    collect(zones, thread_ids);
+
+    FILE* file = fopen(path, "w");
+
+    if (file == nullptr) {
+        log_printf(ERROR_REPORTS, "error",
+                   "Failed to open file \"%s\" for the profiler dump\n", path);
+        return false;
+    }
+
+    uint64_t origin = UINT64_MAX;
+    for (const Zone& zone : zones) {
+        if (zone.begin < origin) origin = zone.begin;
+    }
+
+    fprintf(file, "{\"traceEvents\":[");
+
+    // Zones are timed with the wall clock, even if the world runs on a virtual
+    // one
+    double frequency = (double)WorldTimer::get_wall_clock().get_frequency();
+
+    for (size_t id = 0; id < zones.size(); ++id) {
+        const Zone& zone = zones[id];
+
+        double start = (double)(zone.begin - origin) / frequency * 1e6;
+        double duration = (double)(zone.end - zone.begin) / frequency * 1e6;
+
+        fprintf(file, "%s\n{\"name\":", id == 0 ? "" : ",");
+        write_json_string(file, zone.name);
+        fprintf(file,
+                ",\"ph\":\"X\",\"ts\":%.3lf,\"dur\":%.3lf,\"pid\":0,"
+                "\"tid\":%u}",
+                start, duration, thread_ids[id]);
+    }
+
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    fclose(file);
+
+    log_printf(STATUS_REPORTS, "status",
+               "Dumped %lu profiler zones to \"%s\"\n", zones.size(), path);
+
+    return true;
+}
+
+Profiler::ThreadBuffer& Profiler::get_thread_buffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = nullptr;
+
+    if (buffer) return *buffer;
+
+    buffer = std::make_shared<ThreadBuffer>();
+    buffer->zones.resize(buffer_capacity_);
+
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+
+    buffer->thread_id = (unsigned)buffers_.size();
+    buffers_.push_back(buffer);
+
+    return *buffer;
+}
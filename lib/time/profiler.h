@@ -0,0 +1,161 @@
+/**
+ * @file profiler.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Frame profiler with Chrome trace export
+ * @version 0.1
+ * @date 2025-02-05
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Collector of timed zones, recorded into per-thread ring buffers
+ *
+ * @note Zones can be viewed by loading the dump into `chrome://tracing` or
+ * Perfetto
+ */
+struct Profiler final {
+    struct Zone {
+        const char* name = nullptr;
+        uint64_t begin = 0;
+        uint64_t end = 0;
+    };
+
+    /**
+     * @brief RAII zone, recorded on destruction
+     *
+     */
+    struct ScopedZone final {
+        explicit ScopedZone(const char* name);
+        ~ScopedZone();
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+       private:
+        const char* name_;
+        uint64_t begin_;
+    };
+
+    /**
+     * @brief Record a zone into the calling thread's buffer
+     *
+     * @warning `name` must outlive the profiler (use string literals)
+     *
+     * @param[in] name zone name
+     * @param[in] begin start time (in wall clock ticks)
+     * @param[in] end end time (in wall clock ticks)
+     */
+    static void record(const char* name, uint64_t begin, uint64_t end);
+
+    /**
+     * @brief Enable or disable the recording of zones (disabled by default)
+     *
+     * @param[in] enabled
+     */
+    static void set_enabled(bool enabled) { enabled_ = enabled; }
+    static bool is_enabled() { return enabled_; }
+
+    /**
+     * @brief Set the number of zones kept by each thread buffer
+     *
+     * @note Only affects buffers of threads that did not record zones yet
+     *
+     * @param[in] capacity
+     */
+    static void set_buffer_capacity(size_t capacity);
+
+    /**
+     * @brief Drop all the recorded zones
+     *
+     */
+    static void clear();
+
+    /**
+     * @brief Collect the zones recorded by all the threads
+     *
+     * @param[out] zones
+     * @param[out] thread_ids identifiers of threads the zones belong to
+     */
+    static void collect(std::vector<Zone>& zones,
+                        std::vector<unsigned>& thread_ids);
+
+    /**
+     * @brief Write the recorded zones into a file in Chrome trace format
+     *
+     * @param[in] path file name
+     * @return true on success
+     * @return false
+     */
+    static bool dump_chrome_trace(const char* path);
+
+   private:
+    Profiler();
+
+    /**
+     * @brief Ring buffer written only by its thread
+     *
+     * Readers copy the zones without locking and then drop the ones the
+     * owner may have overwritten in the meantime.
+     */
+    struct ThreadBuffer {
+        unsigned thread_id = 0;
+
+        std::vector<Zone> zones{};
+
+        // Numbers of zones ever written and of zones dropped by `clear`
+        std::atomic<uint64_t> written = 0;
+        std::atomic<uint64_t> cleared = 0;
+    };
+
+    static ThreadBuffer& get_thread_buffer();
+
+    static std::atomic<bool> enabled_;
+    static std::atomic<size_t> buffer_capacity_;
+
+    static std::mutex registry_mutex_;
+    static std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+#define _PROFILE_CONCAT_IMPL(alpha, beta) alpha##beta
+#define _PROFILE_CONCAT(alpha, beta) _PROFILE_CONCAT_IMPL(alpha, beta)
+
+#ifndef NPROFILE
+
+/**
+ * @brief Profile the rest of the enclosing scope
+ *
+ * @param name zone name (string literal)
+ */
+#define PROFILE_ZONE(name) \
+    Profiler::ScopedZone _PROFILE_CONCAT(_profile_zone_, __LINE__)(name)
+
+#else
+
+/**
+ * @brief (DISABLED) Profile the rest of the enclosing scope
+ *
+ * @param name zone name (string literal)
+ */
+#define PROFILE_ZONE(name) \
+    do {                   \
+    } while (0)
+
+#endif
+
+/**
+ * @brief Profile the rest of the enclosing function
+ *
+ */
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
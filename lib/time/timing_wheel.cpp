@@ -0,0 +1,293 @@
+#include "timing_wheel.h"
+
+#include <assert.h>
+
+TimingWheel::TimingWheel(uint64_t start_tick) : current_(start_tick) {}
+
+TimingWheel::Handle TimingWheel::schedule(uint64_t tick, Callback call) {
+    uint32_t index = allocate_node();
+
+    Node& node = nodes_[index];
+    node.tick = tick;
+    node.call = std::move(call);
+
+    insert(index);
+    ++pending_count_;
+
+    return Handle{index, node.generation};
+}
+
+bool TimingWheel::cancel(Handle handle) {
+    if (!is_pending(handle)) return false;
+
+    unlink(handle.index);
+    free_node(handle.index);
+    --pending_count_;
+
+    return true;
+}
+
+bool TimingWheel::is_pending(Handle handle) const {
+    if (handle.index >= nodes_.size()) return false;
+
+    const Node& node = nodes_[handle.index];
+
+    return node.generation == handle.generation && node.slot != NONE;
+}
+
+void TimingWheel::advance(uint64_t tick) {
+    while (current_ <= tick) {
+        if (pending_count_ == 0) {
+            current_ = tick + 1;
+            break;
+        }
+
+        // Skip the ticks with nothing to do
+        uint64_t next_event = find_next_event();
+        if (next_event > current_) {
+            current_ = next_event <= tick ? next_event : tick + 1;
+            continue;
+        }
+
+        // Coarser wheels go first, so their calls can cascade all the way down
+        uint64_t range_mask = (1ull << (SLOT_BITS * LEVEL_COUNT)) - 1;
+        if ((current_ & range_mask) == 0) cascade(OVERFLOW_SLOT);
+
+        for (unsigned level = LEVEL_COUNT - 1; level > 0; --level) {
+            uint64_t level_mask = (1ull << (SLOT_BITS * level)) - 1;
+            if ((current_ & level_mask) != 0) continue;
+
+            uint64_t slot_id = (current_ >> (SLOT_BITS * level)) & SLOT_MASK;
+            cascade((uint32_t)(level * SLOT_COUNT + slot_id));
+        }
+
+        uint32_t slot_index = (uint32_t)(current_ & SLOT_MASK);
+        Slot& slot = slots_[slot_index];
+
+        for (uint32_t index = slot.head; index != NONE;) {
+            uint32_t next = nodes_[index].next;
+
+            expired_.push_back(std::move(nodes_[index].call));
+            free_node(index);
+            --pending_count_;
+
+            index = next;
+        }
+
+        slot = Slot();
+        mark_slot(slot_index, false);
+
+        ++current_;
+
+        // Expired calls are detached first, as they are allowed to schedule
+        // and cancel other calls
+        std::vector<Callback> batch;
+        batch.swap(expired_);
+
+        for (Callback& call : batch) call();
+
+        batch.clear();
+        if (expired_.empty()) expired_.swap(batch);
+    }
+}
+
+void TimingWheel::reset(uint64_t start_tick) {
+    for (uint32_t index = 0; index < nodes_.size(); ++index) {
+        if (nodes_[index].slot != NONE) free_node(index);
+    }
+
+    for (Slot& slot : slots_) slot = Slot();
+    for (uint64_t& word : occupied_) word = 0;
+
+    pending_count_ = 0;
+    current_ = start_tick;
+}
+
+void TimingWheel::rebase(uint64_t start_tick) {
+    std::vector<uint32_t> pending;
+    pending.reserve(pending_count_);
+
+    // Calls of the same tick share a slot, so their order is kept
+    for (Slot& slot : slots_) {
+        for (uint32_t index = slot.head; index != NONE;
+             index = nodes_[index].next) {
+            pending.push_back(index);
+        }
+
+        slot = Slot();
+    }
+
+    for (uint64_t& word : occupied_) word = 0;
+
+    for (uint32_t index : pending) {
+        Node& node = nodes_[index];
+
+        uint64_t delay = node.tick > current_ ? node.tick - current_ : 0;
+        node.tick = start_tick + delay;
+    }
+
+    current_ = start_tick;
+
+    for (uint32_t index : pending) insert(index);
+}
+
+uint32_t TimingWheel::allocate_node() {
+    if (free_list_ == NONE) {
+        nodes_.emplace_back();
+        return (uint32_t)(nodes_.size() - 1);
+    }
+
+    uint32_t index = free_list_;
+    free_list_ = nodes_[index].next;
+
+    nodes_[index].next = NONE;
+
+    return index;
+}
+
+void TimingWheel::free_node(uint32_t index) {
+    Node& node = nodes_[index];
+
+    ++node.generation;
+    node.slot = NONE;
+    node.prev = NONE;
+    node.call = nullptr;
+
+    node.next = free_list_;
+    free_list_ = index;
+}
+
+void TimingWheel::insert(uint32_t index) {
+    Node& node = nodes_[index];
+
+    uint64_t tick = node.tick < current_ ? current_ : node.tick;
+
+    unsigned level = 0;
+    uint64_t slot_id = 0;
+
+    // The call goes to the finest wheel whose current revolution includes it
+    for (; level < LEVEL_COUNT; ++level) {
+        unsigned shift = SLOT_BITS * (level + 1);
+
+        if (shift >= 64 || (tick >> shift) == (current_ >> shift)) {
+            slot_id = (tick >> (SLOT_BITS * level)) & SLOT_MASK;
+            break;
+        }
+    }
+
+    // Calls beyond the range of the wheels wait in the overflow slot, which
+    // gets re-inserted once the coarsest wheel completes its revolution
+    uint32_t slot_index = level == LEVEL_COUNT
+                              ? OVERFLOW_SLOT
+                              : (uint32_t)(level * SLOT_COUNT + slot_id);
+    Slot& slot = slots_[slot_index];
+
+    node.slot = slot_index;
+    node.next = NONE;
+    node.prev = slot.tail;
+
+    if (slot.tail != NONE) {
+        nodes_[slot.tail].next = index;
+    } else {
+        slot.head = index;
+        mark_slot(slot_index, true);
+    }
+
+    slot.tail = index;
+}
+
+void TimingWheel::unlink(uint32_t index) {
+    Node& node = nodes_[index];
+
+    assert(node.slot != NONE);
+
+    Slot& slot = slots_[node.slot];
+
+    if (node.prev != NONE) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        slot.head = node.next;
+    }
+
+    if (node.next != NONE) {
+        nodes_[node.next].prev = node.prev;
+    } else {
+        slot.tail = node.prev;
+    }
+
+    if (slot.head == NONE) mark_slot(node.slot, false);
+
+    node.prev = node.next = NONE;
+    node.slot = NONE;
+}
+
+void TimingWheel::cascade(uint32_t slot_index) {
+    Slot& slot = slots_[slot_index];
+
+    uint32_t index = slot.head;
+    slot = Slot();
+    mark_slot(slot_index, false);
+
+    while (index != NONE) {
+        uint32_t next = nodes_[index].next;
+
+        insert(index);
+
+        index = next;
+    }
+}
+
+uint64_t TimingWheel::find_next_event() const {
+    uint64_t next_event = UINT64_MAX;
+
+    for (unsigned level = 0; level < LEVEL_COUNT; ++level) {
+        unsigned shift = SLOT_BITS * level;
+        unsigned block_shift = shift + SLOT_BITS;
+
+        uint64_t position = (current_ >> shift) & SLOT_MASK;
+        uint64_t block = (current_ >> block_shift) << block_shift;
+
+        size_t slot_id = find_occupied_slot(level, position);
+
+        if (slot_id < SLOT_COUNT) {
+            uint64_t event = block | (slot_id << shift);
+            if (event < next_event) next_event = event;
+        }
+    }
+
+    if (slots_[OVERFLOW_SLOT].head != NONE) {
+        // The start of the next revolution (or the current tick, if it is one)
+        uint64_t range_mask = (1ull << (SLOT_BITS * LEVEL_COUNT)) - 1;
+
+        uint64_t event = (current_ + range_mask) & ~range_mask;
+        if (event < next_event) next_event = event;
+    }
+
+    return next_event;
+}
+
+void TimingWheel::mark_slot(uint32_t slot_index, bool occupied) {
+    if (slot_index == OVERFLOW_SLOT) return;
+
+    uint64_t bit = 1ull << (slot_index % 64);
+
+    if (occupied) {
+        occupied_[slot_index / 64] |= bit;
+    } else {
+        occupied_[slot_index / 64] &= ~bit;
+    }
+}
+
+size_t TimingWheel::find_occupied_slot(unsigned level, size_t from) const {
+    const uint64_t* words = occupied_ + level * SLOT_COUNT / 64;
+
+    for (size_t word = from / 64; word < SLOT_COUNT / 64; ++word) {
+        uint64_t bits = words[word];
+
+        if (word == from / 64) bits &= ~0ull << (from % 64);
+
+        if (bits != 0) return word * 64 + (size_t)__builtin_ctzll(bits);
+    }
+
+    return SLOT_COUNT;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file timing_wheel.h
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Hierarchical timing wheel
+ * @version 0.1
+ * @date 2025-02-07
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+
+#include <vector>
+
+#include "memory/inplace_function.hpp"
+
+/**
+ * @brief Timer queue with constant time scheduling and cancellation
+ *
+ * Time is measured in abstract wheel ticks. Calls scheduled within
+ * `SLOT_COUNT` ticks land in the lowest wheel, further calls are kept in
+ * coarser wheels and cascade down as time approaches them.
+ */
+struct TimingWheel final {
+    using Callback = InplaceFunction<void()>;
+
+    /**
+     * @brief Identifier of a scheduled call
+     *
+     */
+    struct Handle {
+        uint32_t index = UINT32_MAX;
+        uint32_t generation = 0;
+
+        bool is_valid() const { return index != UINT32_MAX; }
+    };
+
+    static const unsigned SLOT_BITS = 8;
+    static const uint64_t SLOT_COUNT = 1 << SLOT_BITS;
+    static const unsigned LEVEL_COUNT = 4;
+
+    explicit TimingWheel(uint64_t start_tick = 0);
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    /**
+     * @brief Schedule a call
+     *
+     * @note Calls scheduled for the same tick are performed in the order of
+     * scheduling
+     *
+     * @param[in] tick tick to perform the call at (calls scheduled for past
+     * ticks are performed on the next advance)
+     * @param[in] call
+     * @return Handle - handle that can be used to cancel the call
+     */
+    Handle schedule(uint64_t tick, Callback call);
+
+    /**
+     * @brief Cancel a scheduled call
+     *
+     * @param[in] handle
+     * @return true if the call was pending and got cancelled
+     * @return false if the call was already performed or cancelled
+     */
+    bool cancel(Handle handle);
+
+    /**
+     * @brief Check if the call is still pending
+     *
+     * @param[in] handle
+     * @return true
+     * @return false
+     */
+    bool is_pending(Handle handle) const;
+
+    /**
+     * @brief Perform all the calls scheduled up to the tick (inclusive)
+     *
+     * @note Calls of the same tick are collected before being performed, so
+     * calls scheduled by them are performed on the next advance
+     *
+     * @param[in] tick
+     */
+    void advance(uint64_t tick);
+
+    /**
+     * @brief Drop all the pending calls and restart the wheel
+     *
+     * @param[in] start_tick
+     */
+    void reset(uint64_t start_tick = 0);
+
+    /**
+     * @brief Restart the wheel at the tick, keeping the pending calls along
+     * with their handles and the number of ticks left until them
+     *
+     * @param[in] start_tick
+     */
+    void rebase(uint64_t start_tick);
+
+    /**
+     * @brief Get the first tick that has not been processed yet
+     *
+     * @return uint64_t
+     */
+    uint64_t get_current_tick() const { return current_; }
+
+    size_t get_pending_count() const { return pending_count_; }
+
+   private:
+    static const uint32_t NONE = UINT32_MAX;
+    static const uint64_t SLOT_MASK = SLOT_COUNT - 1;
+
+    // Slot for the calls beyond the range of the coarsest wheel
+    static const uint32_t OVERFLOW_SLOT = LEVEL_COUNT * SLOT_COUNT;
+
+    struct Node {
+        uint64_t tick = 0;
+
+        uint32_t prev = NONE;
+        uint32_t next = NONE;
+
+        uint32_t generation = 0;
+        uint32_t slot = NONE;
+
+        Callback call{};
+    };
+
+    struct Slot {
+        uint32_t head = NONE;
+        uint32_t tail = NONE;
+    };
+
+    uint32_t allocate_node();
+    void free_node(uint32_t index);
+
+    void insert(uint32_t index);
+    void unlink(uint32_t index);
+
+    void cascade(uint32_t slot_index);
+
+    /**
+     * @brief Find the first tick at which there is something to do (either a
+     * call to perform or a non-empty slot to cascade)
+     *
+     * @return uint64_t
+     */
+    uint64_t find_next_event() const;
+
+    void mark_slot(uint32_t slot_index, bool occupied);
+    size_t find_occupied_slot(unsigned level, size_t from) const;
+
+    uint64_t current_;
+
+    size_t pending_count_ = 0;
+
+    std::vector<Node> nodes_{};
+    uint32_t free_list_ = NONE;
+
+    Slot slots_[LEVEL_COUNT * SLOT_COUNT + 1] = {};
+
+    uint64_t occupied_[LEVEL_COUNT * SLOT_COUNT / 64] = {};
+
+    std::vector<Callback> expired_{};
+};
@@ -2,27 +2,29 @@
 
 #include <assert.h>
 
-#include "GLFW/glfw3.h"
+static const WallClock WALL_CLOCK;
 
-uint64_t WorldTimer::SIM_START_ = glfwGetTimerValue();
-std::set<WorldTimer::ScheduledCall> WorldTimer::scheduled_calls_ = {};
+const Clock* WorldTimer::clock_ = &WALL_CLOCK;
+
+uint64_t WorldTimer::SIM_START_ = WALL_CLOCK.get_time();
+TimingWheel WorldTimer::scheduled_calls_{};
 
 uint64_t WorldTimer::get_time() {
-    uint64_t current = glfwGetTimerValue();
+    uint64_t current = clock_->get_time();
     return current - SIM_START_;
 }
 
 uint64_t WorldTimer::sec2ticks(double seconds) {
-    return (uint64_t)(seconds * glfwGetTimerFrequency());
+    return (uint64_t)(seconds * (double)clock_->get_frequency());
 }
 
 double WorldTimer::ticks2sec(uint64_t ticks) {
-    return (double)ticks / (double)glfwGetTimerFrequency();
+    return (double)ticks / (double)clock_->get_frequency();
 }
 
 double WorldTimer::get_time_sec() {
     uint64_t time = get_time();
-    uint64_t frequency = glfwGetTimerFrequency();
+    uint64_t frequency = clock_->get_frequency();
 
     uint64_t whole = time / frequency;
     uint64_t remainder = time % frequency;
@@ -30,28 +32,41 @@ double WorldTimer::get_time_sec() {
     return (double)whole + (double)remainder / (double)frequency;
 }
 
-void WorldTimer::schedule(double delay, const std::function<void()>& call) {
+WorldTimer::CallHandle WorldTimer::
+    schedule(double delay, TimingWheel::Callback call) {
     assert(delay >= 0.0);
 
-    ScheduledCall scheduled{};
-    scheduled.call = call;
-    scheduled.time =
-        get_time() + (uint64_t)(delay * (double)glfwGetTimerFrequency());
+    uint64_t time =
+        get_time() + (uint64_t)(delay * (double)clock_->get_frequency());
+
+    // Rounded up, so that calls are never performed early
+    uint64_t resolution = sec2ticks(SCHEDULE_RESOLUTION);
+    uint64_t tick = (time + resolution - 1) / resolution;
 
-    scheduled_calls_.insert(scheduled);
+    return scheduled_calls_.schedule(tick, std::move(call));
+}
+
+bool WorldTimer::cancel(CallHandle handle) {
+    return scheduled_calls_.cancel(handle);
 }
 
 void WorldTimer::run_scheduled_calls() {
-    uint64_t time = get_time();
+    scheduled_calls_.advance(get_schedule_tick(get_time()));
+}
+
+uint64_t WorldTimer::get_schedule_tick(uint64_t time) {
+    return time / sec2ticks(SCHEDULE_RESOLUTION);
+}
 
-    while (!scheduled_calls_.empty() &&
-           time >= scheduled_calls_.begin()->time) {
-        auto call = scheduled_calls_.begin();
-        std::function<void()> functor = call->call;
-        scheduled_calls_.erase(call);
+void WorldTimer::set_clock(const Clock& clock) {
+    clock_ = &clock;
+    SIM_START_ = clock.get_time();
 
-        functor();
-    }
+    // The wheel counts from the start of the world time, pending calls keep
+    // the delays left until them at the last run of the scheduled calls
+    scheduled_calls_.rebase(get_schedule_tick(get_time()));
 }
 
-WorldTimer::WorldTimer() { SIM_START_ = glfwGetTimerValue(); }
+const WallClock& WorldTimer::get_wall_clock() { return WALL_CLOCK; }
+
+WorldTimer::WorldTimer() { SIM_START_ = clock_->get_time(); }
@@ -13,10 +13,18 @@
 
 #include <inttypes.h>
 
-#include <functional>
-#include <set>
+#include "clock.h"
+#include "timing_wheel.h"
 
 struct WorldTimer final {
+    using CallHandle = TimingWheel::Handle;
+
+    /**
+     * @brief Resolution of scheduled calls (in seconds)
+     *
+     */
+    static constexpr double SCHEDULE_RESOLUTION = 1e-3;
+
     static uint64_t get_time();
 
     static uint64_t sec2ticks(double seconds);
@@ -24,23 +32,55 @@ struct WorldTimer final {
 
     static double get_time_sec();
 
-    static void schedule(double delay, const std::function<void()>& call);
+    /**
+     * @brief Set the time source of the world and restart the world time
+     *
+     * @note Scheduled calls are kept with the delays they had left at the
+     * last `run_scheduled_calls`, which are then measured by the new clock
+     *
+     * @warning Timestamps taken from the previous clock (e.g. by timers) are
+     * not converted
+     *
+     * @param[in] clock clock to use (should outlive its usage)
+     */
+    static void set_clock(const Clock& clock);
+    static const Clock& get_clock() { return *clock_; }
+
+    /**
+     * @brief Get the real time clock, which is used by default
+     *
+     * @return const WallClock&
+     */
+    static const WallClock& get_wall_clock();
+
+    /**
+     * @brief Schedule a call to be performed after the delay
+     *
+     * @param[in] delay delay (in seconds)
+     * @param[in] call
+     * @return CallHandle - handle that can be used to cancel the call
+     */
+    static CallHandle schedule(double delay, TimingWheel::Callback call);
+
+    /**
+     * @brief Cancel a scheduled call
+     *
+     * @param[in] handle
+     * @return true if the call got cancelled
+     * @return false if the call was already performed or cancelled
+     */
+    static bool cancel(CallHandle handle);
 
     static void run_scheduled_calls();
 
    private:
     WorldTimer();
 
-    struct ScheduledCall {
-        uint64_t time = 0;
-        std::function<void()> call{};
+    static uint64_t get_schedule_tick(uint64_t time);
 
-        bool operator<(const ScheduledCall& other) const {
-            return time < other.time;
-        }
-    };
+    static const Clock* clock_;
 
     static uint64_t SIM_START_;
 
-    static std::set<ScheduledCall> scheduled_calls_;
+    static TimingWheel scheduled_calls_;
 };
@@ -8,9 +8,15 @@
 
 const Scene::ComponentLayerId PoolBall::BallLayer;
 
-PoolBall::PoolBall(const glm::vec3& position, const Model& model)
+const SceneComponent::ChannelTable PoolBall::CHANNELS =
+    ChannelTable().output<&PoolBall::knocked_down_>("knocked_down");
+
+PoolBall::PoolBall(const glm::vec3& position, const AssetRef<Model>& model)
     : bouncer_(position, POOL_BALL_RADIUS) {
-    register_output("knocked_down", knocked_down_);
+    use_channels(CHANNELS);
+
+    register_state(bouncer_.get_state());
+    register_state(is_overboard_);
 
     shadow_ = new_child<PointLightComponent>(position, glm::vec3(-1.0) * 0.4f);
     model_ = new_child<StaticMesh>(model);
@@ -35,7 +41,7 @@ void PoolBall::phys_tick(double delta_time) {
 
     bool new_ob = !is_on_board();
     if (!is_overboard_ && new_ob) {
-        knocked_down_.trigger("1");
+        knocked_down_.trigger(ScriptValue(true));
     }
     is_overboard_ = new_ob;
 
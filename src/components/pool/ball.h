@@ -21,7 +21,7 @@
 static const double POOL_BALL_RADIUS = 0.025;
 
 struct PoolBall : public SceneComponent {
-    PoolBall(const glm::vec3& position, const Model& model);
+    PoolBall(const glm::vec3& position, const AssetRef<Model>& model);
 
     void phys_tick(double delta_time) override;
     void draw_tick(double delta_time, double subtick_time = 0.0) override;
@@ -48,6 +48,8 @@ struct PoolBall : public SceneComponent {
     static const Scene::ComponentLayerId BallLayer;
 
    private:
+    static const ChannelTable CHANNELS;
+
     void resolve_positions(PoolBall& ball);
 
     glm::vec3 captured_pos_{0.0};
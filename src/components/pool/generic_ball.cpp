@@ -3,5 +3,5 @@
 #include "managers/asset_manager.h"
 
 GenericBall::GenericBall(const glm::vec3& position)
-    : PoolBall(position, *AssetManager::request<Model>(
+    : PoolBall(position, AssetManager::acquire<Model>(
                              "assets/models/red_ball.model.xml")) {}
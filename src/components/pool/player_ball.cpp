@@ -9,14 +9,14 @@
 const float PlayerBall::POWER_LIMIT = 2.5f;
 
 PlayerBall::PlayerBall(const glm::vec3& position)
-    : PoolBall(position, *AssetManager::request<Model>(
+    : PoolBall(position, AssetManager::acquire<Model>(
                              "assets/models/main_ball.model.xml")) {
     camera_.set_position(glm::vec3(-1.0, 4.0, 0.0));
     camera_.set_fov((float)(30.0));
     camera_.direct(glm::vec3(0.25, -1.0, 0.0), glm::vec3(1.0, 0.0, 0.0));
 
     arrow_ = new_child<StaticMesh>(
-        *AssetManager::request<Model>("assets/models/arrow.model.xml"));
+        AssetManager::acquire<Model>("assets/models/arrow.model.xml"));
 }
 
 void PlayerBall::phys_tick(double delta_time) {
@@ -36,4 +36,18 @@ static const unsigned LOG_THRESHOLD = 0;
 
 static const double CMP_EPS = 1e-5;
 
+static const char PROFILER_DUMP_PATH[] = "profile.trace.json";
+static const char SCRIPT_PROFILE_DUMP_PATH[] = "profile.scripts.txt";
+
+// Metrics are only dumped if a target is given (see the `--metrics` option)
+static const double METRICS_DUMP_PERIOD = 1.0;
+
+static const char SCRIPT_CACHE_DIRECTORY[] = "cache/scripts";
+static const char MESH_BAKE_DIRECTORY[] = "cache/meshes";
+
+static const char ASSET_MANIFEST_PATH[] = "assets.manifest";
+
+// Memory (CPU and GPU, in bytes) that unreferenced assets are unloaded to fit
+static const size_t ASSET_MEMORY_BUDGET = 512ul * 1024 * 1024;
+
 #endif
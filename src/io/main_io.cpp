@@ -2,24 +2,39 @@
 
 #include "lib/logger/logger.h"
 
-Options::Options() : output_name_(NULL), input_name_(NULL) {}
+Options::Options()
+    : output_name_(NULL),
+      input_name_(NULL),
+      metrics_target_(NULL),
+      profiling_(false) {}
 
 Options::Options(const Options& options)
-    : output_name_(options.output_name_), input_name_(options.input_name_) {}
+    : output_name_(options.output_name_),
+      input_name_(options.input_name_),
+      metrics_target_(options.metrics_target_),
+      profiling_(options.profiling_) {}
 
 Options::~Options() {}
 
 Options& Options::operator=(const Options& options) {
     input_name_ = options.input_name_;
     output_name_ = options.output_name_;
+    metrics_target_ = options.metrics_target_;
+    profiling_ = options.profiling_;
     return *this;
 }
 
 const char* Options::get_output_name() { return output_name_; }
 const char* Options::get_input_name() { return input_name_; }
+const char* Options::get_metrics_target() { return metrics_target_; }
+bool Options::is_profiling() { return profiling_; }
 
 void Options::set_output_name(const char* new_name) { output_name_ = new_name; }
 void Options::set_input_name(const char* new_name) { input_name_ = new_name; }
+void Options::set_metrics_target(const char* new_target) {
+    metrics_target_ = new_target;
+}
+void Options::set_profiling(bool profiling) { profiling_ = profiling; }
 
 static const char OWL_TEXT[] = R"""(You let the owls out!
     A_,,,_A        A_,,,_A        A_,,,_A    
@@ -39,6 +54,12 @@ error_t parse(int key, char* arg, struct argp_state* state) {
         case OPT_OWL:
             puts(OWL_TEXT);
             break;
+        case OPT_METRICS:
+            options->set_metrics_target(arg);
+            break;
+        case OPT_PROFILE:
+            options->set_profiling(true);
+            break;
         case ARGP_KEY_ARG:
             if (state->arg_num == 0) options->set_input_name(arg);
             break;
@@ -21,11 +21,19 @@ static const char ARGS_DOC[] = "";
 enum OptCodeKey {
     _OPT_CUSTOM_KEYS_SHIFT = 500,
     OPT_OWL,
+    OPT_METRICS,
+    OPT_PROFILE,
 };
 
 static const argp_option PARSER_OPTIONS[] = {
     {"owl", OPT_OWL, NULL, 0, "Lets the owls out"},
     {"output", 'o', "OUTPUT_FILE", 0, "Output file path"},
+    {"metrics", OPT_METRICS, "TARGET", 0,
+     "Periodically dump metrics to the file or to the UNIX socket "
+     "(unix:<path>)"},
+    {"profile", OPT_PROFILE, NULL, 0,
+     "Record profiler zones from the start (otherwise the profile dump key "
+     "starts the recording)"},
     {}  // <-- NULL-terminator
 };
 
@@ -38,13 +46,19 @@ struct Options {
 
     const char* get_output_name();
     const char* get_input_name();
+    const char* get_metrics_target();
+    bool is_profiling();
 
     void set_output_name(const char* new_name);
     void set_input_name(const char* new_name);
+    void set_metrics_target(const char* new_target);
+    void set_profiling(bool profiling);
 
    private:
     const char* output_name_;
     const char* input_name_;
+    const char* metrics_target_;
+    bool profiling_;
 };
 
 /**
@@ -11,15 +11,22 @@
 
 #include <unistd.h>
 
+#include <optional>
+
 #include "graphics/gl_debug.h"
+#include "graphics/primitives/baked_mesh.h"
+#include "input/binary_input.h"
 #include "input/input_controller.h"
 #include "io/main_io.h"
 #include "logger/debug.h"
 #include "logger/logger.h"
+#include "logger/metrics.h"
+#include "logics/blueprints/scripts/script_cache.h"
 #include "managers/asset_manager.h"
 #include "managers/tick_manager.h"
 #include "managers/window_manager.h"
 #include "scenes/pool_game.h"
+#include "time/profiler.h"
 #include "time/world_timer.h"
 #include "utils/main_utils.h"
 
@@ -41,15 +48,28 @@ int main(const int argc, char** argv) {
         return EXIT_FAILURE;
     }
 
+    Profiler::set_enabled(options.is_profiling());
+
+    ScriptCache::set_directory(SCRIPT_CACHE_DIRECTORY);
+    BakedMesh::set_directory(MESH_BAKE_DIRECTORY);
+
     WindowManager::init(WINDOW_WIDTH, WINDOW_HEIGHT, "Pool game", false);
 
     poll_gl_errors();
 
     InputController::init(WindowManager::get_active_window());
 
-    static PoolGame world;
+    // Assets requested by the previous run are decoded in parallel, while the
+    // scene requests them one by one
+    AssetManager::set_memory_budget(ASSET_MEMORY_BUDGET);
+    AssetManager::prefetch(ASSET_MANIFEST_PATH);
+    AssetManager::start_recording();
+
+    // The scene is destroyed before the assets it references are unloaded
+    static std::optional<PoolGame> world;
+    world.emplace();
 
-    Camera* camera = world.get_renderer().get_viewpoint();
+    Camera* camera = world->get_renderer().get_viewpoint();
 
     if (camera != nullptr) {
         camera->set_aspect_ratio((float)WINDOW_WIDTH / (float)WINDOW_HEIGHT);
@@ -72,28 +92,59 @@ int main(const int argc, char** argv) {
 
         // Physics
         [](double delta_time) {
-            world.phys_tick(delta_time);
+            world->phys_tick(delta_time);
             WorldTimer::run_scheduled_calls();
         },
 
         // Graphics
         [&](double delta_time, double subtick_time) {
-            world.draw_tick(delta_time, subtick_time);
+            world->draw_tick(delta_time, subtick_time);
 
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            world.get_renderer().render(gbuffers);
+            world->get_renderer().render(gbuffers);
 
             poll_gl_errors();
 
             WindowManager::refresh();
 
-            fps_display.set_value(int(ticker.get_fps()));
-            tps_display.set_value(int(ticker.get_real_tps()));
+            static const Gauge& fps = Metrics::get_gauge("fps");
+            static const Gauge& tps = Metrics::get_gauge("tps");
+
+            fps_display.set_value(int(fps.get()));
+            tps_display.set_value(int(tps.get()));
+
+            static BinaryInput profile_input =
+                *AssetManager::request<BinaryInput>(
+                    "assets/controls/profile.keybind.xml");
+
+            // The first push starts the recording unless it was enabled by
+            // the `--profile` option
+            if (profile_input.poll_pushed()) {
+                if (Profiler::is_enabled()) {
+                    Profiler::dump_chrome_trace(PROFILER_DUMP_PATH);
+                } else {
+                    Profiler::set_enabled(true);
+                }
+            }
+
+            // Only scripts imported with `profiled="true"` are dumped
+            static BinaryInput script_profile_input =
+                *AssetManager::request<BinaryInput>(
+                    "assets/controls/script_profile.keybind.xml");
+
+            if (script_profile_input.poll_pushed()) {
+                world->dump_script_profiles(SCRIPT_PROFILE_DUMP_PATH);
+            }
         });
 
     // Synch physics and graphics ticks, disable TPS requirements
     ticker.set_tps_req(0);
 
+    if (options.get_metrics_target() != nullptr) {
+        Metrics::schedule_dumps(options.get_metrics_target(),
+                                METRICS_DUMP_PERIOD);
+    }
+
     log_printf(STATUS_REPORTS, "status", "Entering the loop.\n");
     GameLoop::run(ticker, []() {
         return glfwWindowShouldClose(WindowManager::get_active_window());
@@ -101,6 +152,10 @@ int main(const int argc, char** argv) {
 
     poll_gl_errors();
 
+    AssetManager::save_manifest(ASSET_MANIFEST_PATH);
+
+    world.reset();
+
     // NOTE: Should be called before closing the OpenGL context, since visual
     // content destructors may want to free GPU buffers
     AssetManager::unload_all();
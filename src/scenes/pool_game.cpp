@@ -21,6 +21,12 @@ PoolGame::PoolGame()
 }
 
 void PoolGame::phys_tick(double delta_time) {
+    static BinaryInput rewind_input =
+        *AssetManager::
+            request<BinaryInput>("assets/controls/rewind.keybind.xml");
+
+    if (rewind_input.get_pushed() && rewind()) return;
+
     Scene::phys_tick(delta_time);
 
     // process_int_collisions();
@@ -40,6 +46,9 @@ void PoolGame::phys_tick(double delta_time) {
     if (reset_input.poll_pushed()) {
         reset();
     }
+
+    capture_state(frame_);
+    history_.push(frame_);
 }
 
 void PoolGame::reset() {
@@ -49,11 +58,24 @@ void PoolGame::reset() {
     }
 }
 
+bool PoolGame::rewind() {
+    if (history_.size() < 2) return false;
+
+    history_.rewind(1);
+    history_.get(0, frame_);
+
+    restore_state(frame_);
+
+    return true;
+}
+
 void PoolGame::load() {
-    const ExternalLevel* level = AssetManager::
-        request<ExternalLevel>("assets/levels/pool_table.level.xml");
+    // The components keep the assets they use, so the level can be evicted
+    // once it is built
+    AssetRef<ExternalLevel> level = AssetManager::
+        acquire<ExternalLevel>("assets/levels/pool_table.level.xml");
 
-    if (level == nullptr) return;
+    if (!level) return;
 
     SubcomponentNameMap map = level->build(*this, glm::mat4(1.0));
 
@@ -27,6 +27,14 @@ struct PoolGame : public Scene {
 
     void reset();
 
+    /**
+     * @brief Step the simulation one physics tick back in time
+     *
+     * @return true if the step was performed
+     * @return false if there is no recorded history left
+     */
+    bool rewind();
+
    protected:
     bool has_moving_parts() const;
 
@@ -44,4 +52,9 @@ struct PoolGame : public Scene {
 
     std::vector<WeakSubcomponent<GenericBall>> balls_{};
     WeakSubcomponent<PlayerBall> player_{};
+
+    static const size_t REWIND_FRAME_COUNT = 1024;
+
+    SnapshotHistory history_{REWIND_FRAME_COUNT};
+    SceneSnapshot frame_{};
 };
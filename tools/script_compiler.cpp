@@ -0,0 +1,120 @@
+/**
+ * @file script_compiler.cpp
+ * @author Kudryashov Ilya (kudriashov.it@phystech.edu)
+ * @brief Compiler of level scripts to C++
+ * @version 0.1
+ * @date 2025-02-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Usage: script_compiler <output.cpp> <level.xml>...
+ *
+ * Collects the compiled `script` elements of the levels and writes a
+ * translation unit with the native versions of the scripts (see
+ * `NativeScript`), which only compiled scripts use. Linked files are read
+ * relative to the working directory, the same way the engine reads them
+ * relative to its build directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "logger/logger.h"
+#include "logics/blueprints/scripts/native.h"
+#include "tinyxml2.h"
+
+using ScriptList = std::vector<std::pair<std::string, std::string>>;
+
+static bool read_file(const char* path, std::string& content) {
+    std::ifstream stream(path);
+    if (!stream.good()) return false;
+
+    content = std::string(std::istreambuf_iterator<char>{stream}, {});
+    return true;
+}
+
+static void collect_scripts(const tinyxml2::XMLElement& element,
+                            const std::string& level, ScriptList& scripts) {
+    bool compiled = false;
+    element.QueryBoolAttribute("compiled", &compiled);
+
+    if (strcmp(element.Name(), "script") == 0 && compiled) {
+        const char* path = nullptr;
+        element.QueryStringAttribute("path", &path);
+        element.QueryStringAttribute("file", &path);
+
+        const char* content = nullptr;
+        element.QueryStringAttribute("content", &content);
+        element.QueryStringAttribute("script", &content);
+        element.QueryStringAttribute("code", &content);
+
+        std::string origin = level + ":" + std::to_string(element.GetLineNum());
+
+        // Linked files take precedence, as in the script importer
+        if (path) {
+            std::string source{};
+
+            if (read_file(path, source)) {
+                scripts.push_back({path, source});
+            } else {
+                log_printf(ERROR_REPORTS, "error",
+                           "Failed to read the script \"%s\" (%s).\n", path,
+                           origin.c_str());
+            }
+        } else if (content) {
+            scripts.push_back({origin, content});
+        }
+    }
+
+    for (const tinyxml2::XMLElement* child = element.FirstChildElement();
+         child; child = child->NextSiblingElement()) {
+        collect_scripts(*child, level, scripts);
+    }
+}
+
+int main(const int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <output.cpp> <level.xml>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ScriptList scripts{};
+
+    for (int id = 2; id < argc; ++id) {
+        tinyxml2::XMLDocument document;
+
+        if (document.LoadFile(argv[id]) != tinyxml2::XML_SUCCESS) {
+            log_printf(ERROR_REPORTS, "error", "Failed to load level \"%s\".\n",
+                       argv[id]);
+            return EXIT_FAILURE;
+        }
+
+        for (const tinyxml2::XMLElement* element =
+                 document.FirstChildElement();
+             element; element = element->NextSiblingElement()) {
+            collect_scripts(*element, argv[id], scripts);
+        }
+    }
+
+    std::string source = generate_native_scripts(scripts);
+
+    FILE* output = fopen(argv[1], "w");
+
+    if (!output) {
+        log_printf(ERROR_REPORTS, "error", "Failed to create \"%s\".\n",
+                   argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    bool written = fwrite(source.data(), 1, source.size(), output) ==
+                   source.size();
+    written = fclose(output) == 0 && written;
+
+    return written ? EXIT_SUCCESS : EXIT_FAILURE;
+}